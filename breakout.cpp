@@ -25,8 +25,16 @@
  * - `Level`: Gère la grille de briques et s'occupe du chargement/sauvegarde des niveaux.
  * - `InputManager`: Gère les entrées clavier et souris.
  * - `TextRenderer`: Effectue le rendu du texte en utilisant FreeType.
+ * - `RenderQueue`: Tampon de commandes de rendu enregistré par la logique de jeu, trié par état puis exécuté par un backend.
+ * - `RenderBackend`: Exécute un `RenderQueue` (`GLRenderBackend` pour OpenGL, `NullRenderBackend` pour les mesures).
  * - `Game`: La classe principale du jeu qui gère la boucle de jeu et les transitions d'état.
  * 
+ * La simulation (entrées, physique, logique des menus) tourne sur son propre thread à fréquence fixe et publie
+ * des états immuables (`FrameSnapshot`) dans un triple tampon sans verrou, que le thread principal affiche.
+ * Les callbacks GLFW transmettent des événements horodatés à la simulation par la file sans verrou (`SpscQueue`) de `InputManager`.
+ * Dans le Menu et l'Éditeur, rien ne bouge sans action de l'utilisateur : les deux threads attendent les événements
+ * et une trame n'est dessinée que si l'affichage a changé (ou si le système demande un rafraîchissement).
+ * 
  * Le jeu comprend les états suivants :
  * - `MENU`: Le menu principal où le joueur peut commencer le jeu ou entrer dans l'éditeur.
  * - `GAME`: L'état principal du jeu.
@@ -59,12 +67,37 @@
  * @code
  * ./break_out
  * @endcode
+ *
+ * Options de la ligne de commande :
+ * - `--null-render` : Enregistre les commandes de rendu sans les exécuter (mesure du coût CPU du jeu).
+ * - `--pacing=vsync|sleep-spin|uncapped` : Stratégie de cadencement des trames (par défaut `sleep-spin`).
+ * - F3 en cours d'exécution affiche l'overlay de performances (temps de trame, appels de dessin, allocations).
+ * - `--late-latch` : Relit la position du curseur juste avant de dessiner la raquette (réduit la latence d'entrée).
+ * - `--trace` : Exporte à la sortie les zones de profilage dans `breakout_trace.json` (format Chrome trace, F9 pour un export immédiat).
+ * - `--convert-level ENTRÉE SORTIE` : Convertit un niveau entre le format texte (`.txt`) et le format binaire (`level.bkl`), puis quitte.
+ * - `--parse-level NIVEAU...` : Analyse des niveaux texte et affiche leurs anomalies (`fichier:ligne:colonne`) et le débit, puis quitte.
+ * - `--pack=FICHIER` : Ouvre une archive de niveaux ; Flèche gauche / Flèche droite dans le menu choisissent le niveau joué ou édité.
+ * - `--pack-add ARCHIVE NIVEAU...` : Ajoute des niveaux à une archive (créée si besoin), puis quitte. `--pack-list ARCHIVE` affiche son index.
+ * - `--lint CHEMIN... [--jobs=N]` : Vérifie en parallèle des niveaux, archives ou répertoires (erreurs de format, niveau sans
+ *   brique destructible, briques inaccessibles, pièges pour la balle) et écrit un objet JSON par niveau, puis quitte.
+ * - `--generate NOMBRE SORTIE [--rows=N] [--cols=N] [--symmetry=none|mirror|quad] [--bricks=N] [--indestructible=PART]
+ *   [--difficulty=MIN:MAX] [--playthroughs=N] [--seed=N] [--jobs=N]` : Génère des niveaux sous contraintes (difficulté mesurée
+ *   par des parties simulées) dans un répertoire ou une archive `.bkp`, affiche le débit par cœur, puis quitte.
+ * - `--target-hz=N` : Fréquence cible des trames (par défaut celle du moniteur). Les percentiles de durée des trames sont affichés à la sortie.
  * 
  * @section Features Fonctionnalités
  * - Mécaniques de la raquette et de la balle avec détection de collision.
  * - Grille de briques avec des briques destructibles et indestructibles.
- * - Chargement et sauvegarde de niveaux dans un fichier level.txt.
- * - Éditeur de niveaux avec contrôles à la souris et au clavier.
+ * - Éclats projetés par les briques détruites, gérés par un magasin d'entités (composants contigus, indices en ensembles
+ *   clairsemés) parcouru par lots par des systèmes (déplacement, expiration, rendu).
+ * - Chargement et sauvegarde de niveaux au format binaire dans level.bkl (projeté en mémoire), avec import et export texte
+ *   (`--convert-level` ; level.txt est importé si level.bkl n'existe pas) et archives de plusieurs niveaux (`.bkp`).
+ * - Rechargement à chaud de level.bkl et level.txt modifiés par un autre programme (dans l'éditeur, ou en partie avant le lancement de la balle).
+ * - Éditeur de niveaux avec contrôles à la souris et au clavier, outils de zone (rectangle, ligne, remplissage, copier-coller)
+ *   et historique d'annulation/rétablissement compact. Zoom et déplacement de la vue : seules les cellules visibles sont
+ *   dessinées, regroupées en blocs lorsqu'elles sont plus petites qu'un pixel ou deux (grilles jusqu'à 4096x4096 et plus).
+ *   Test immédiat de la grille en cours d'édition, sans passer par le disque. Carte de chaleur des touches par brique
+ *   (touches, délai avant la première touche, briques jamais touchées), affinée par des parties simulées en arrière-plan.
  * - Rendu de texte pour l'HUD et les menus.
  * - Système de menu avec options pour jouer, éditer les niveaux ou quitter.
  * 
@@ -72,28 +105,31 @@
  * - **Mode Jeu**:
  *   - Mouvement de la souris : Déplacer la raquette.
  *   - Clic gauche : Lancer la balle.
- *   - `M` (ou `Virgule` sur QWERTY): Retourner au menu.
+ *   - `M` (ou `Virgule` sur QWERTY): Retourner au menu (à l'éditeur pendant un test de niveau).
  * - **Mode Éditeur**:
- *   - Clic gauche : Sélectionner une brique.
- *   - Clic droit : Placer une brique (Maj + Clic droit pour une brique indestructible).
- *   - `Suppr` : Effacer la brique sélectionnée.
+ *   - Clic gauche : Sélectionner une brique (la sélection précédente devient l'ancre des outils de zone).
+ *   - Clic droit : Appliquer l'outil avec le pinceau (Maj + Clic droit pour des briques indestructibles).
+ *   - `1` à `4` : Outil Placer, Rectangle, Ligne (entre l'ancre et la sélection) ou Remplir (zone de même valeur).
+ *   - `Tab` : Changer de pinceau (couleur de la rangée, type de brique choisi ou vide).
+ *   - `Suppr` : Effacer avec l'outil courant (la brique sélectionnée pour l'outil Placer).
+ *   - `Ctrl+C` / `Ctrl+V` : Copier le rectangle entre l'ancre et la sélection / le coller sur la cellule sélectionnée.
+ *   - Molette : Zoomer sous le curseur ; bouton du milieu maintenu ou flèches : se déplacer ; `Origine` : vue d'ensemble.
+ *   - `Ctrl+Z` (ou `Ctrl+W` sur QWERTY) : Annuler la dernière modification ; `Ctrl+Y` ou `Ctrl+Maj+Z` : la rétablir.
+ *   - `P` : Tester le niveau en mémoire (sans sauvegarde) ; `M` en jeu ramène à l'éditeur, sélection et historique intacts.
+ *   - `H` : Carte de chaleur des touches, puis du délai avant la première touche, puis masquer la carte.
  *   - `M` (ou `Virgule` sur QWERTY): Retourner au menu.
  * - **Menu**:
  *   - Clic souris : Sélectionner les options du menu.
  * 
  * @section KnownIssues Problèmes connus
  * - Le jeu pourrait ne pas bien gérer les rapports d'aspect extrêmes.
- * - L'éditeur ne supporte pas la fonctionnalité d'annulation/rétablissement (undo/redo).
  * - Les collisions peuvent être un peu imprécises dans certaines situations.
  * 
  * @section FutureWork Travaux futurs
  * - Ajouter des power-ups et des mécaniques de jeu supplémentaires.
  * - Améliorer la détection de collision pour une physique plus réaliste.
- * - Ajouter le support pour la sauvegarde de plusieurs niveaux.
- * - Créer un menu pour visualiser les différents niveaux crées.
  * - Créer un leaderboard pour les scores de chaque niveaux.
  * - Ajouter des effets sonores et de la musique.
- * - Implémenter la fonctionnalité d'annulation/rétablissement dans l'éditeur.
  */
 
 /**
@@ -104,15 +140,37 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <bitset>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <cmath>
 #include <cstdlib>
 #include <map>
+#include <deque>
 #include <memory>
 #include <algorithm>
 #include <thread>
 #include <chrono>
+#include <random>
 #include <ctime>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <cerrno>
+#include <charconv>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #define STB_IMAGE_IMPLEMENTATION
@@ -125,6 +183,13 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+/**
+* @brief Active les zones de profilage (`PROFILE_ZONE`). Compiler avec `-DBREAKOUT_PROFILING=0` pour les retirer.
+*/
+#ifndef BREAKOUT_PROFILING
+#define BREAKOUT_PROFILING 1
+#endif
+
 /**
  * @brief Déclarations des classes.
 */
@@ -146,6 +211,8 @@ namespace Config {
     *       Cette section contien une taille de fenetre par défaut si on arrive pas à detecter la taille du moniteur de l'ordinateur qui éxécute ce programme.
     *       Elle contient aussi les deux variables WINDOW_WIDTH et WINDOW_HEIGHT qui sont initialisées à 0 et qui seront modifiées par la fonction initWindow() de la classe Game et quand on change les dimensions de notre fenetre.
     *       Pour finir on a un taux de rafraîchissement par défaut de 60 FPS.
+    *       WINDOW_WIDTH et WINDOW_HEIGHT ne sont pas synchronisées : la physique (`Ball`, `Level`, `Playthrough`) et les threads
+    *       de fond ne doivent pas les lire, la taille de la zone de jeu leur est passée en paramètre.
     */
     constexpr int DEFAULT_WINDOW_WIDTH = 1024;
     constexpr int DEFAULT_WINDOW_HEIGHT = 768;
@@ -153,6 +220,52 @@ namespace Config {
     int WINDOW_HEIGHT = 0;
     constexpr float TARGET_FPS = 60.0f;
 
+    /**
+    * @note Cadencement des trames (voir `FramePacer`).
+    *       PACING_SPIN_MARGIN : durée avant l'échéance à partir de laquelle on attend activement au lieu de dormir,
+    *       pour absorber le retard de réveil de `sleep_until`.
+    *       FRAME_TIME_SAMPLES : nombre de durées de trames conservées pour le calcul des percentiles.
+    */
+    constexpr double PACING_SPIN_MARGIN = 0.002;
+    constexpr size_t FRAME_TIME_SAMPLES = 8192;
+
+    /**
+    * @note Fréquence fixe du thread de simulation (entrées, physique, logique des menus).
+    *       Le thread de rendu affiche toujours le dernier état publié par la simulation.
+    */
+    constexpr double SIMULATION_HZ = 120.0;
+    constexpr size_t INPUT_QUEUE_CAPACITY = 1024;
+
+    /**
+    * @note Mode inactif (Menu et Éditeur) : les threads attendent les événements au lieu de tourner à pleine fréquence.
+    *       Délai maximal d'attente en secondes avant un réveil de contrôle.
+    */
+    constexpr double IDLE_WAIT_TIMEOUT = 0.5;
+
+    /**
+    * @note Rechargement à chaud des niveaux : délai en secondes sans nouvelle écriture avant de relire un fichier modifié.
+    */
+    constexpr double LEVEL_RELOAD_DEBOUNCE = 0.2;
+
+    /**
+    * @note Parties simulées du générateur de niveaux : vitesse maximale de la raquette du joueur automatique
+    *       (en largeurs de fenêtre par seconde), durée de jeu simulée au-delà de laquelle une partie est abandonnée et
+    *       part de la difficulté due à la progression (le reste dépend des vies restantes, voir `Playthrough::difficulty`).
+    */
+    constexpr float PLAYTHROUGH_BOT_SPEED = 0.45f;
+    constexpr float PLAYTHROUGH_MAX_SECONDS = 300.0f;
+    constexpr float PLAYTHROUGH_PROGRESS_WEIGHT = 0.75f;
+
+    /**
+    * @note Éclats projetés par une brique détruite (entités de `EntityWorld`, purement visuelles) : nombre par brique,
+    *       durée de vie en secondes, vitesse initiale maximale et gravité en pixels par seconde (par seconde), taille en pixels.
+    */
+    constexpr int DEBRIS_PER_BRICK = 6;
+    constexpr float DEBRIS_LIFETIME = 0.6f;
+    constexpr float DEBRIS_SPEED = 260.0f;
+    constexpr float DEBRIS_GRAVITY = 900.0f;
+    constexpr float DEBRIS_SIZE = 6.0f;
+
     /**
     * @note Tailles des éléments de jeu.
     */
@@ -163,6 +276,12 @@ namespace Config {
     constexpr float BRICK_SPACING = 3.0f;
     constexpr int GRID_COLS = 14;
     constexpr int GRID_ROWS = 8;
+
+    /**
+    * @note Dimension maximale (rangées ou colonnes) acceptée à la lecture d'un niveau.
+    *       Les grilles plus grandes que GRID_ROWS x GRID_COLS sont réduites à l'écran pour occuper la même surface.
+    */
+    constexpr int LEVEL_MAX_DIMENSION = 8192;
     constexpr float BALL_RADIUS = 10.0f;
 
     /**
@@ -198,9 +317,10 @@ namespace Config {
     constexpr int PLAYER_STARTING_LIVES = 3;
 
     /**
-    * @note Fichier de niveau du jeu, police, logo et nom du copyright.
+    * @note Fichier de niveau du jeu (format binaire, importé depuis le format texte s'il n'existe pas encore), police, logo et nom du copyright.
     */
-    constexpr const char* LEVEL_FILENAME = "level.txt";
+    constexpr const char* LEVEL_FILENAME = "level.bkl";
+    constexpr const char* LEVEL_TEXT_FILENAME = "level.txt";
     constexpr const char* FONT_PATH = "font/montserrat.bold.ttf";
     constexpr int FONT_PIXEL_SIZE = 48;
     constexpr const char* LOGO_PATH = "images/copyright_logo.png";
@@ -231,6 +351,10 @@ namespace Config {
     constexpr Color COLOR_BRICK_EMPTY = {0.2f, 0.2f, 0.2f};
     constexpr Color COLOR_HIGHLIGHT = {1.0f, 1.0f, 0.0f};
     constexpr Color COLOR_EDITOR_SELECT = {0.0f, 1.0f, 1.0f};
+    constexpr Color COLOR_EDITOR_ANCHOR = {0.0f, 0.5f, 0.5f};
+    constexpr Color COLOR_HEATMAP_COLD = {0.1f, 0.3f, 1.0f};
+    constexpr Color COLOR_HEATMAP_HOT = {1.0f, 0.1f, 0.0f};
+    constexpr Color COLOR_HEATMAP_NEVER = {1.0f, 0.0f, 1.0f};
 
     /**
     * @note Couleurs des briques.
@@ -257,6 +381,12 @@ namespace Config {
         }
     }
 
+    /** @brief Vérifie qu'une valeur de score correspond à une cellule valide (vide, normale ou indestructible). */
+    constexpr bool isValidScore(int score) {
+        return score == 0 || score == SCORE_INDESTRUCTIBLE || score == SCORE_YELLOW ||
+               score == SCORE_GREEN || score == SCORE_ORANGE || score == SCORE_RED;
+    }
+
     /**
     * @note Raccourcis clavier pour clavier AZERTY : 
     * 
@@ -270,6 +400,83 @@ namespace Config {
     constexpr int KEY_EDITOR_SET_EMPTY = GLFW_KEY_DELETE;     
     constexpr int KEY_MENU_TOGGLE = GLFW_KEY_SEMICOLON;    
     constexpr int KEY_QUIT = GLFW_KEY_ESCAPE;              
+
+    /**
+    * @note Navigateur de niveaux du menu (option `--pack=`) : Flèche gauche / Flèche droite pour choisir le niveau joué et édité.
+    */
+    constexpr int KEY_LEVEL_PREV = GLFW_KEY_LEFT;
+    constexpr int KEY_LEVEL_NEXT = GLFW_KEY_RIGHT;
+
+    /**
+    * @note Annuler / rétablir dans l'éditeur : Ctrl+Z (touche W d'un clavier QWERTY) annule, Ctrl+Y ou Ctrl+Maj+Z rétablit.
+    *       EDITOR_HISTORY_MAX_BYTES / EDITOR_HISTORY_MAX_GROUPS : limites de l'historique (les opérations les plus anciennes sont oubliées).
+    */
+    constexpr int KEY_EDITOR_UNDO = GLFW_KEY_W;
+    constexpr int KEY_EDITOR_REDO = GLFW_KEY_Y;
+    constexpr size_t EDITOR_HISTORY_MAX_BYTES = 64u << 20;
+    constexpr size_t EDITOR_HISTORY_MAX_GROUPS = 1000;
+
+    /**
+    * @note Outils de l'éditeur : touches 1 à 4 de la rangée supérieure (sans Maj sur AZERTY) pour Placer, Rectangle, Ligne et
+    *       Remplir ; Tab change de pinceau ; Ctrl+C copie le rectangle entre l'ancre et la sélection, Ctrl+V le colle.
+    */
+    constexpr int KEY_EDITOR_TOOL_PLACE = GLFW_KEY_1;
+    constexpr int KEY_EDITOR_TOOL_RECTANGLE = GLFW_KEY_2;
+    constexpr int KEY_EDITOR_TOOL_LINE = GLFW_KEY_3;
+    constexpr int KEY_EDITOR_TOOL_FILL = GLFW_KEY_4;
+    constexpr int KEY_EDITOR_BRUSH_NEXT = GLFW_KEY_TAB;
+    constexpr int KEY_EDITOR_COPY = GLFW_KEY_C;
+    constexpr int KEY_EDITOR_PASTE = GLFW_KEY_V;
+
+    /**
+    * @note Test du niveau depuis l'éditeur : P (même touche sur AZERTY et QWERTY) lance une partie sur la grille en mémoire,
+    *       M y ramène l'éditeur.
+    */
+    constexpr int KEY_EDITOR_PLAYTEST = GLFW_KEY_P;
+
+    /**
+    * @note Carte de chaleur de l'éditeur : H (même touche sur AZERTY et QWERTY) affiche les touches par brique, puis le délai
+    *       avant la première touche, puis masque la carte. HEATMAP_GAMES parties simulées par grille, d'au plus HEATMAP_MAX_SECONDS,
+    *       sur des threads de fond ; les grilles de plus de HEATMAP_MAX_CELLS cellules ne sont pas simulées.
+    *       HEATMAP_REFRESH_SECONDS : intervalle minimal entre deux publications des résultats partiels.
+    */
+    constexpr int KEY_EDITOR_HEATMAP = GLFW_KEY_H;
+    constexpr int HEATMAP_GAMES = 64;
+    constexpr float HEATMAP_MAX_SECONDS = 120.0f;
+    constexpr size_t HEATMAP_MAX_CELLS = 128 * 128;
+    constexpr double HEATMAP_REFRESH_SECONDS = 0.25;
+    constexpr float HEATMAP_ALPHA = 0.55f;
+
+    /**
+    * @note Vue de l'éditeur : molette pour zoomer sous le curseur, bouton du milieu maintenu ou flèches pour se déplacer,
+    *       Origine pour revenir à la vue d'ensemble. EDITOR_MAX_CELL_PIXELS : largeur maximale d'une cellule zoomée ;
+    *       EDITOR_AGGREGATE_PIXELS : en dessous de cette taille à l'écran, les cellules sont regroupées en blocs d'une couleur.
+    */
+    constexpr int KEY_EDITOR_PAN_LEFT = GLFW_KEY_LEFT;
+    constexpr int KEY_EDITOR_PAN_RIGHT = GLFW_KEY_RIGHT;
+    constexpr int KEY_EDITOR_PAN_UP = GLFW_KEY_UP;
+    constexpr int KEY_EDITOR_PAN_DOWN = GLFW_KEY_DOWN;
+    constexpr int KEY_EDITOR_VIEW_RESET = GLFW_KEY_HOME;
+    constexpr float EDITOR_ZOOM_STEP = 1.25f;
+    constexpr float EDITOR_MAX_CELL_PIXELS = 160.0f;
+    constexpr float EDITOR_AGGREGATE_PIXELS = 2.0f;
+
+    /**
+    * @note Profilage : F9 exporte à la demande les zones enregistrées au format Chrome trace (chrome://tracing, Perfetto).
+    *       PROFILER_ZONES_PER_THREAD : capacité du tampon circulaire de chaque thread (les zones les plus anciennes sont écrasées).
+    */
+    constexpr int KEY_PROFILER_EXPORT = GLFW_KEY_F9;
+
+    /**
+    * @note Overlay de performances (F3) : temps de trame, répartition simulation/rendu, appels de dessin, tests de collision
+    *       et allocations. PERF_GRAPH_SAMPLES : nombre de trames du graphe glissant ; PERF_GRAPH_MAX_MS : durée en haut du graphe.
+    */
+    constexpr int KEY_PERF_OVERLAY = GLFW_KEY_F3;
+    constexpr size_t PERF_GRAPH_SAMPLES = 240;
+    constexpr float PERF_GRAPH_MAX_MS = 40.0f;
+    constexpr float PERF_TEXT_SCALE = 0.3f;
+    constexpr size_t PROFILER_ZONES_PER_THREAD = 1 << 16;
+    constexpr const char* TRACE_FILENAME = "breakout_trace.json";
 }
 
 /**
@@ -283,6 +490,27 @@ enum class GameState {
     EXITING
 };
 
+/**
+    * @enum HeatmapMode
+    * @brief Affichage de la carte de chaleur de l'éditeur (touche H).
+*/
+enum class HeatmapMode : uint8_t {
+    OFF,
+    HITS,       // Touches par partie (échelle logarithmique)
+    FIRST_HIT   // Délai moyen avant la première touche (les briques touchées tôt sont chaudes)
+};
+
+/**
+    * @enum EditorTool
+    * @brief Outils de l'éditeur de niveaux, appliqués par clic droit à la sélection.
+*/
+enum class EditorTool {
+    PLACE,      // Cellule sélectionnée
+    RECTANGLE,  // Rectangle entre l'ancre et la sélection
+    LINE,       // Segment entre l'ancre et la sélection
+    FILL        // Zone connexe de même valeur que la cellule sélectionnée
+};
+
 /**
  * @brief Structures utilitaires pour les vecteurs 2D et les rectangles.
  * 
@@ -304,34 +532,9 @@ struct Rect { float x = 0.0f, y = 0.0f; float width = 0.0f, height = 0.0f; };
 /**
  * @namespace Utils
  * @brief Fonctions utilitaires pour dessiner des formes géométrique de base et gérer les textures.
+ * @note Les fonctions de dessin sont appelées uniquement par `GLRenderBackend`, la logique de jeu passe par `RenderQueue`.
  */
 namespace Utils {
-    /**
-    * @brief Dessine un rectangle.
-    * @param x Position X du coin supérieur gauche.
-    * @param y Position Y du coin supérieur gauche.
-    * @param width Largeur du rectangle.
-    * @param height Hauteur du rectangle.
-    * @param color Couleur du rectangle.
-    */
-    inline void drawRect(float x, float y, float width, float height, Config::Color color) {
-        glColor3f(color.r, color.g, color.b);
-        glBegin(GL_QUADS);
-        glVertex2f(x, y);
-        glVertex2f(x + width, y);
-        glVertex2f(x + width, y + height);
-        glVertex2f(x, y + height);
-        glEnd();
-    }
-
-    /**
-    * @brief Dessine un rectangle en utilisant la structure Rect.
-    * @param rect Structure Rect contenant la position et la taille.
-    * @param color Couleur du rectangle.
-    * @note Cette fonction est un wrapper autour de la fonction drawRect(float, float, float, float, Config::Color).
-    */
-    inline void drawRect(const Rect& rect, Config::Color color) { drawRect(rect.x, rect.y, rect.width, rect.height, color); }
-
     /**
     * @brief Dessine un cercle.
     * @param cx Position X du centre.
@@ -390,1205 +593,5805 @@ namespace Utils {
     }
 
     /**
-    * @brief Dessine un rectangle texturé.
-    * @param x Position X du coin supérieur gauche.
-    * @param y Position Y du coin supérieur gauche.
-    * @param width Largeur du rectangle.
-    * @param height Hauteur du rectangle.
-    * @param textureID ID de la texture OpenGL.
+    * @brief Dessine le contour d'un rectangle.
+    * @param rect Structure Rect contenant la position et la taille.
+    * @param lineWidth Épaisseur du trait en pixels.
+    * @param color Couleur du contour.
     */
-    inline void drawTexturedRect(float x, float y, float width, float height, GLuint textureID) {
-        if (textureID == 0) return;
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glColor3f(1.0f, 1.0f, 1.0f);
-        glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(x, y);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(x + width, y);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(x + width, y + height);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(x, y + height);
-        glEnd();
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glDisable(GL_TEXTURE_2D);
+    inline void drawLineLoop(const Rect& rect, float lineWidth, Config::Color color) {
+        glColor3f(color.r, color.g, color.b);
+        glLineWidth(lineWidth); glBegin(GL_LINE_LOOP);
+        glVertex2f(rect.x, rect.y);
+        glVertex2f(rect.x + rect.width, rect.y);
+        glVertex2f(rect.x + rect.width, rect.y + rect.height);
+        glVertex2f(rect.x, rect.y + rect.height);
+        glEnd(); glLineWidth(1.0f);
     }
 }
 
+#if BREAKOUT_PROFILING
 /**
- * @class InputManager
- * @brief Gère les événements d'entrée du clavier, de la souris et les interactions du curseur.
- *
- * @param m_keyIsDown Une map stockant l'état actuel des touches (vrai si une touche est maintenue).
- * @param m_keyWasPressed Une map stockant les touches qui ont été pressées dans la trame actuelle.
- * @param m_keyWasReleased Une map stockant les touches qui ont été relâchées dans la trame actuelle.
- * @param m_mousePos Un objet Vec2 représentant la position actuelle de la souris.
- * @param m_mouseLeftDown Un booléen indiquant si le bouton gauche de la souris est actuellement maintenu.
- * @param m_mouseLeftClicked Un booléen indiquant si le bouton gauche de la souris a été cliqué dans la trame actuelle.
- * @param m_mouseRightDown Un booléen indiquant si le bouton droit de la souris est actuellement maintenu.
- * @param m_mouseRightClicked Un booléen indiquant si le bouton droit de la souris a été cliqué dans la trame actuelle.
- * @param m_windowHeight Un entier représentant la hauteur de la fenêtre, utilisé pour les calculs de position du curseur (Y inversé).
- */
-class InputManager {
-private:
-    std::map<int, bool> m_keyIsDown;
-    std::map<int, bool> m_keyWasPressed;
-    std::map<int, bool> m_keyWasReleased;
-    Vec2 m_mousePos = {0.0f, 0.0f};
-    bool m_mouseLeftDown = false;
-    bool m_mouseLeftClicked = false;
-    bool m_mouseRightDown = false;
-    bool m_mouseRightClicked = false;
-    int m_windowHeight = Config::WINDOW_HEIGHT;
-
-public:
-    InputManager() = default;
-
-    /** @brief Définit la hauteur de la fenêtre pour le calcul correct de la position Y de la souris. */
-    void setWindowHeight(int height) { m_windowHeight = height > 0 ? height : 1; }
-    
-    /** @brief Réinitialise l'état des clics/pressions de touches pour la nouvelle trame. */
-    void nextFrame() { m_keyWasPressed.clear(); m_keyWasReleased.clear(); m_mouseLeftClicked = false; m_mouseRightClicked = false; }
-    
-    /** @brief Fonction de Callback pour les événements clavier. */
-    void keyCallback(int key, int action) {
-        if (action == GLFW_PRESS) { m_keyIsDown[key] = true; m_keyWasPressed[key] = true; }
-        else if (action == GLFW_RELEASE) { m_keyIsDown[key] = false; m_keyWasReleased[key] = true; }
-    }
-
-    /** @brief Fonction de Callback pour les événements des boutons de la souris. */
-    void mouseButtonCallback(int button, int action) {
-        if (button == GLFW_MOUSE_BUTTON_LEFT) {
-            m_mouseLeftDown = (action == GLFW_PRESS);
-            if (action == GLFW_PRESS) m_mouseLeftClicked = true;
-        }
-        else if (button == GLFW_MOUSE_BUTTON_RIGHT) {
-            m_mouseRightDown = (action == GLFW_PRESS);
-            if (action == GLFW_PRESS) m_mouseRightClicked = true;
-        }
-    }
-    
-    /** @brief Fonction de Callback pour la position du curseur. Inverse Y pour correspondre aux coordonnées OpenGL. */
-    void cursorPosCallback(double xpos, double ypos) {
-        m_mousePos.x = static_cast<float>(xpos);
-        m_mousePos.y = static_cast<float>(m_windowHeight) - static_cast<float>(ypos);
-    }
-    
-    /** @brief Vérifie si une touche est actuellement maintenue enfoncée. */
-    bool isKeyDown(int key) const { auto it = m_keyIsDown.find(key); return (it != m_keyIsDown.end() && it->second); }
-    
-    /** @brief Vérifie si une touche a été pressée dans la trame actuelle. */
-    bool wasKeyPressed(int key) const { return m_keyWasPressed.count(key); }
-    
-    /** @brief Vérifie si une touche a été relâchée dans la trame actuelle. */
-    bool wasKeyReleased(int key) const { return m_keyWasReleased.count(key); }
-    
-    /** @brief Obtient la position actuelle de la souris. */
-    const Vec2& getMousePos() const { return m_mousePos; }
-    
-    /** @brief Obtient la coordonnée X actuelle de la souris. */
-    float getMouseX() const { return m_mousePos.x; }
-    
-    /** @brief Obtient la coordonnée Y actuelle de la souris (origine en bas à gauche). */
-    float getMouseY() const { return m_mousePos.y; }
-    
-    /** @brief Vérifie si le bouton gauche de la souris est actuellement maintenu enfoncé. */
-    bool isMouseLeftDown() const { return m_mouseLeftDown; }
-    
-    /** @brief Vérifie si le bouton gauche de la souris a été cliqué dans la trame actuelle. */
-    bool wasMouseLeftClicked() const { return m_mouseLeftClicked; }
-    
-    /** @brief Vérifie si le bouton droit de la souris est actuellement maintenu enfoncé. */
-    bool isMouseRightDown() const { return m_mouseRightDown; }
-    
-    /** @brief Vérifie si le bouton droit de la souris a été cliqué dans la trame actuelle. */
-    bool wasMouseRightClicked() const { return m_mouseRightClicked; }
-    
-    /** @brief Vérifie si l'une des touches Maj (Shift) est maintenue enfoncée. */
-    bool isShiftDown() const { return isKeyDown(GLFW_KEY_LEFT_SHIFT) || isKeyDown(GLFW_KEY_RIGHT_SHIFT); }
-};
-
-/**
-* @class TextRenderer
-* @brief Gère le rendu du texte à l'écran en utilisant FreeType.
-*
-* @param m_ft Instance de la bibliothèque FreeType.
-* @param m_face Instance de la police FreeType (FT_Face).
-* @param m_characters Map des caractères pré-rendus (ASCII vers la structure Character).
-* @param m_initialized Indicateur booléen de l'état d'initialisation du moteur de rendu.
+* @class Profiler
+* @brief Enregistre des zones de temps (nom, début, durée en nanosecondes) dans un tampon circulaire par thread
+*        et les exporte au format Chrome trace-event JSON.
+* @note L'enregistrement d'une zone ne prend aucun verrou : chaque thread écrit seul dans son tampon. Seule
+*       l'inscription d'un thread (à sa première zone) et l'export prennent `m_mutex`.
+* @param m_mutex Protège la liste des tampons.
+* @param m_buffers Tampons des threads inscrits (jamais libérés avant la fin du programme).
 */
-class TextRenderer {
-private:
+class Profiler {
+public:
     /**
-    * @struct Character
-    * @brief Structure pour stocker les propriétés d'un caractère de police.
-    * @param textureID ID de la texture OpenGL pour le glyphe du caractère.
-    * @param sizeX Largeur de la texture du caractère.
-    * @param sizeY Hauteur de la texture du caractère.
-    * @param bearingX Décalage X de la ligne de base au point le plus à gauche du caractère.
-    * @param bearingY Décalage Y de la ligne de base au point le plus haut du caractère.
-    * @param advance Décalage horizontal vers le caractère suivant.
-    */
-    struct Character {
-        unsigned int textureID = 0; 
-        int sizeX = 0; 
-        int sizeY = 0;
-        int bearingX = 0; 
-        int bearingY = 0; 
-        unsigned int advance = 0;
+     * @struct Zone
+     * @brief Zone terminée : `name` doit pointer sur une chaîne statique.
+     */
+    struct Zone {
+        const char* name;
+        uint64_t startNs;
+        uint64_t durationNs;
     };
-    FT_Library m_ft = nullptr; 
-    FT_Face m_face = nullptr;
-    std::map<char, Character> m_characters; 
-    bool m_initialized = false;
-public:
-    TextRenderer() = default; 
-    ~TextRenderer() { cleanup(); }
-    TextRenderer(const TextRenderer&) = delete; 
-    TextRenderer& operator=(const TextRenderer&) = delete;
 
     /**
-     * @brief Initialise le moteur de rendu de texte.
-     * @param fontPath Chemin vers le fichier de police (.ttf).
-     * @param pixelSize Taille de la police en pixels.
-     * @return `true` si l'initialisation réussit, `false` sinon.
+     * @struct ThreadBuffer
+     * @brief Tampon circulaire des zones d'un thread. `written` compte toutes les zones écrites depuis le début.
      */
-    bool init(const char* fontPath, int pixelSize) {
-        if (m_initialized) return true;
-        if (FT_Init_FreeType(&m_ft)) {  return false; }
-        if (FT_New_Face(m_ft, fontPath, 0, &m_face)) { FT_Done_FreeType(m_ft); m_ft = nullptr; return false; }
-        FT_Set_Pixel_Sizes(m_face, 0, pixelSize); // Définit la largeur à 0 pour un calcul automatique
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Désactive la restriction d'alignement des octets
-        for (unsigned char c = 32; c < 127; c++) { // Charge les caractères ASCII imprimables
-            if (FT_Load_Char(m_face, c, FT_LOAD_RENDER)) {  continue; }
-            unsigned int texture; glGenTextures(1, &texture); glBindTexture(GL_TEXTURE_2D, texture);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_face->glyph->bitmap.width, m_face->glyph->bitmap.rows, 0, GL_ALPHA, GL_UNSIGNED_BYTE, m_face->glyph->bitmap.buffer);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            Character character = { texture, static_cast<int>(m_face->glyph->bitmap.width), static_cast<int>(m_face->glyph->bitmap.rows),
-                                    m_face->glyph->bitmap_left, m_face->glyph->bitmap_top, static_cast<unsigned int>(m_face->glyph->advance.x) };
-            m_characters.insert({c, character});
+    struct ThreadBuffer {
+        std::string threadName;
+        uint32_t threadId = 0;
+        std::array<Zone, Config::PROFILER_ZONES_PER_THREAD> zones;
+        std::atomic<uint64_t> written{0};
+    };
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+    Profiler() = default;
+
+    ThreadBuffer& threadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = m_buffers.back().get();
+            buffer->threadId = static_cast<uint32_t>(m_buffers.size());
+            buffer->threadName = "Thread " + std::to_string(buffer->threadId);
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
-        std::cout << "Text rendering initialized with font: " << fontPath << std::endl;
-        m_initialized = true; 
-        return true;
+        return *buffer;
     }
+public:
+    static Profiler& instance() { static Profiler profiler; return profiler; }
 
-    /**
-     * @brief Nettoie les ressources utilisées par le moteur de rendu de texte.
-     */
-    void cleanup() {
-        if (m_initialized) {
-            std::cout << "Cleaning up TextRenderer..." << std::endl;
-            for (auto const& [key, val] : m_characters) { if (val.textureID != 0) glDeleteTextures(1, &val.textureID); }
-            m_characters.clear();
-            if (m_face) { FT_Done_Face(m_face); m_face = nullptr; }
-            if (m_ft) { FT_Done_FreeType(m_ft); m_ft = nullptr; }
-            m_initialized = false;
-        }
+    /** @brief Horloge des zones, en nanosecondes. */
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
     }
 
-    /**
-     * @brief Calcule la largeur d'une chaîne de texte rendue.
-     * @param text Le texte à mesurer.
-     * @param scale L'échelle à appliquer au texte.
-     * @return La largeur du texte en pixels à l'échelle donnée.
-     */
-    float getTextWidth(const std::string& text, float scale) const {
-        if (!m_initialized) return 0.0f; 
-        float width = 0.0f;
-        for (char c : text) { auto it = m_characters.find(c); if (it != m_characters.end()) width += (it->second.advance >> 6) * scale; }
-        return width;
+    /** @brief Nomme le thread appelant dans la trace exportée. */
+    void setThreadName(const char* name) {
+        ThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffer.threadName = name;
     }
 
-    /**
-     * @brief Calcule la hauteur d'une ligne de texte rendue (basée sur les métriques de la police).
-     * @param scale L'échelle à appliquer au texte.
-     * @return La hauteur du texte en pixels à l'échelle donnée.
-     */
-    float getTextHeight(float scale) const {
-        if (!m_initialized || !m_face || !m_face->size) return 0.0f; 
-        return (static_cast<float>(m_face->size->metrics.height >> 6) * scale);
+    /** @brief Enregistre une zone terminée du thread appelant. */
+    void record(const char* name, uint64_t startNs, uint64_t endNs) {
+        ThreadBuffer& buffer = threadBuffer();
+        uint64_t index = buffer.written.load(std::memory_order_relaxed);
+        buffer.zones[index % buffer.zones.size()] = { name, startNs, endNs - startNs };
+        buffer.written.store(index + 1, std::memory_order_release);
     }
 
     /**
-     * @brief Effectue le rendu d'une chaîne de texte à l'écran.
-     * @param text Le texte à afficher. Gère les sauts de ligne '\n'.
-     * @param x_center Coordonnée X du centre horizontal du bloc de texte.
-     * @param y_baseline_start Coordonnée Y de la ligne de base de la première ligne de texte (le texte s'étend vers le bas).
-     * @param scale L'échelle à appliquer au texte.
-     * @param color La couleur du texte.
+     * @brief Exporte les zones enregistrées au format Chrome trace-event JSON.
+     * @param filename Fichier de destination.
+     * @return `true` si le fichier a été écrit.
+     * @note Peut être appelé pendant que les autres threads enregistrent : les zones écrasées pendant la copie
+     *       d'un tampon sont écartées en relisant son compteur après la copie. `record` remplit la case de la zone
+     *       `written` avant de publier `written + 1` : la case en cours d'écriture est aussi écartée.
      */
-    void render(const std::string& text, float x_center, float y_baseline_start, float scale, Config::Color color) const {
-        if (!m_initialized) return;
-        glEnable(GL_TEXTURE_2D); 
-        glEnable(GL_BLEND); 
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glColor3f(color.r, color.g, color.b); 
-        glActiveTexture(GL_TEXTURE0);
-        
-        float currentY = y_baseline_start;
-        
-        // Calcul de la hauteur de ligne
-        float lineHeight = 0.0f;
-        if (m_face && m_face->size && m_face->size->metrics.height) {
-            lineHeight = (static_cast<float>(m_face->size->metrics.height >> 6) * scale);
-        } else { // Solution de repli si les métriques de la police ne sont pas disponibles
-            if (!m_characters.empty()) {
-                auto it_char = m_characters.begin();
-                if (m_characters.count('M')) it_char = m_characters.find('M');
-                else if (m_characters.count('A')) it_char = m_characters.find('A'); // Utilise 'M' ou 'A' comme référence
-                if (it_char != m_characters.end()) {
-                    lineHeight = static_cast<float>(it_char->second.sizeY) * scale * 1.2f; // 1.2f pour un espacement
+    bool exportChromeTrace(const std::string& filename) {
+        std::vector<std::pair<const ThreadBuffer*, std::vector<Zone>>> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& buffer : m_buffers) {
+                const size_t capacity = buffer->zones.size();
+                uint64_t end = buffer->written.load(std::memory_order_acquire);
+                uint64_t begin = (end > capacity) ? end - capacity : 0;
+                std::vector<Zone> zones;
+                zones.reserve(static_cast<size_t>(end - begin));
+                for (uint64_t i = begin; i < end; ++i) zones.push_back(buffer->zones[i % capacity]);
+                // Les lectures des cases précèdent la relecture du compteur
+                std::atomic_thread_fence(std::memory_order_acquire);
+                uint64_t endAfterCopy = buffer->written.load(std::memory_order_relaxed);
+                // Zones écrasées depuis le début de la copie, plus celle que `record` est peut-être en train d'écrire
+                if (endAfterCopy + 1 > begin + capacity) {
+                    size_t overwritten = static_cast<size_t>(std::min<uint64_t>(endAfterCopy + 1 - capacity - begin, zones.size()));
+                    zones.erase(zones.begin(), zones.begin() + overwritten);
                 }
+                snapshot.emplace_back(buffer.get(), std::move(zones));
             }
-            if (lineHeight <= 0.001f) lineHeight = 20.0f * scale; // Valeur de secours absolue positive
         }
-        if (lineHeight <= 0.001f) lineHeight = 20.0f * scale; // Assure une hauteur de ligne positive
 
-        // Gestion des sauts de ligne
-        std::vector<std::string> lines;
-        std::string currentLineStr;
-        for (char c : text) {
-            if (c == '\n') {
-                lines.push_back(currentLineStr);
-                currentLineStr.clear();
+        uint64_t originNs = UINT64_MAX;
+        size_t zoneCount = 0;
+        for (const auto& entry : snapshot) {
+            for (const Zone& zone : entry.second) originNs = std::min(originNs, zone.startNs);
+            zoneCount += entry.second.size();
+        }
+        if (originNs == UINT64_MAX) originNs = 0;
+
+        std::ofstream out(filename);
+        if (!out.is_open()) { std::cerr << "ERROR: Could not write trace file: " << filename << std::endl; return false; }
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        char line[256];
+        for (const auto& entry : snapshot) {
+            std::snprintf(line, sizeof(line), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                          first ? "" : ",", entry.first->threadId, entry.first->threadName.c_str());
+            out << line; first = false;
+            for (const Zone& zone : entry.second) {
+                // Horodatages en microsecondes avec trois décimales : la précision à la nanoseconde est conservée
+                std::snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                              zone.name, entry.first->threadId, (zone.startNs - originNs) / 1000.0, zone.durationNs / 1000.0);
+                out << line;
+            }
+        }
+        out << "\n]}\n";
+        if (!out.good()) { std::cerr << "ERROR: Failed while writing trace file: " << filename << std::endl; return false; }
+        std::cout << "Profiler: exported " << zoneCount << " zones to " << filename << std::endl;
+        return true;
+    }
+};
+
+/**
+* @class ProfileZone
+* @brief Zone de profilage limitée à une portée : mesure le temps entre sa construction et sa destruction.
+*/
+class ProfileZone {
+private:
+    const char* m_name;
+    uint64_t m_startNs;
+public:
+    explicit ProfileZone(const char* name) : m_name(name), m_startNs(Profiler::nowNs()) {}
+    ~ProfileZone() { Profiler::instance().record(m_name, m_startNs, Profiler::nowNs()); }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::instance().setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+/**
+* @brief Nombre total d'allocations dynamiques (tous threads), affiché par l'overlay de performances.
+* @note Compté par le remplacement global de `operator new` ci-dessous (les versions tableau s'y ramènent).
+*/
+std::atomic<uint64_t> g_allocationCount{0};
+
+// Non inlinés : GCC signalerait sinon à tort des paires malloc/delete incompatibles (-Wmismatched-new-delete)
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/**
+ * @enum RenderLayer
+ * @brief Couches de rendu, dessinées dans l'ordre de déclaration.
+ * @note À l'intérieur d'une couche, les commandes sont regroupées par état OpenGL : deux commandes
+ *       qui se chevauchent et dont l'ordre compte doivent donc être placées dans des couches différentes.
+ */
+enum class RenderLayer : uint8_t {
+    BACKGROUND,    ///< Bordures latérales.
+    WORLD,         ///< Briques, raquette, balle, grille de l'éditeur.
+    WORLD_OVERLAY, ///< Surbrillance de la cellule sélectionnée.
+    UI,            ///< Boutons et logo.
+    UI_TEXT,       ///< Texte (HUD, menus, messages).
+    DEBUG_OVERLAY  ///< Overlay de performances (quads de l'atlas de glyphes uniquement, dessinés en un seul lot).
+};
+
+/**
+ * @enum RenderCommandType
+ * @brief Types de commandes de rendu supportés par `RenderQueue`.
+ */
+enum class RenderCommandType : uint8_t {
+    RECT,
+    CIRCLE,
+    TEXTURED_QUAD,
+    TEXT,
+    LINE_LOOP,
+    ATLAS_QUAD
+};
+
+/**
+ * @struct RenderCommand
+ * @brief Commande de rendu compacte.
+ * @param type Type de la commande.
+ * @param layer Couche de rendu.
+ * @param segments Nombre de segments (cercle uniquement).
+ * @param texture ID de la texture OpenGL (quad texturé uniquement).
+ * @param textOffset Position du texte dans l'arène de texte du `RenderQueue`.
+ * @param textLength Longueur du texte dans l'arène.
+ * @param rect Rectangle (rect, quad texturé, line loop). Pour un cercle : centre en (x, y) ; pour un texte : centre X et ligne de base Y.
+ * @param uv Coordonnées de texture d'un quad d'atlas (`y` désigne le haut du quad).
+ * @param param Rayon (cercle), échelle (texte), épaisseur du trait (line loop) ou opacité (quad d'atlas).
+ * @param color Couleur de la commande.
+ */
+struct RenderCommand {
+    RenderCommandType type = RenderCommandType::RECT;
+    RenderLayer layer = RenderLayer::WORLD;
+    uint16_t segments = 0;
+    GLuint texture = 0;
+    uint32_t textOffset = 0;
+    uint32_t textLength = 0;
+    Rect rect;
+    Rect uv;
+    float param = 0.0f;
+    Config::Color color = {1.0f, 1.0f, 1.0f};
+};
+
+/**
+* @class RenderQueue
+* @brief Tampon de commandes de rendu enregistré par `renderGame`/`renderMenu`/`renderEditor`.
+*
+* Les commandes sont ajoutées dans l'ordre d'appel, puis `sort()` calcule un ordre d'exécution trié par
+* couche, par état OpenGL (formes pleines, lignes, textures, texte) et par texture. L'ordre d'ajout est conservé
+* à état égal. Le tampon est réutilisé d'une trame à l'autre : après les premières trames, il n'alloue plus.
+*
+* @param m_commands Commandes enregistrées pour la trame actuelle.
+* @param m_sortKeys Clés de tri (couche, état, texture, index de la commande).
+* @param m_textArena Arène contenant le texte de toutes les commandes `TEXT` de la trame.
+*/
+class RenderQueue {
+private:
+    std::vector<RenderCommand> m_commands;
+    std::vector<uint64_t> m_sortKeys;
+    std::string m_textArena;
+
+    static constexpr uint64_t INDEX_MASK = (1ull << 28) - 1;
+
+    /** @brief Classe d'état OpenGL d'un type de commande (utilisée pour le tri). */
+    static uint64_t stateClass(RenderCommandType type) {
+        switch (type) {
+            case RenderCommandType::RECT:
+            case RenderCommandType::CIRCLE:        return 0;
+            case RenderCommandType::LINE_LOOP:     return 1;
+            case RenderCommandType::TEXTURED_QUAD: return 2;
+            case RenderCommandType::TEXT:          return 3;
+            case RenderCommandType::ATLAS_QUAD:    return 4;
+        }
+        return 0;
+    }
+
+    /** @brief Ajoute une commande et retourne une référence vers celle-ci. */
+    RenderCommand& push(RenderCommandType type, RenderLayer layer, Config::Color color) {
+        m_commands.emplace_back();
+        RenderCommand& cmd = m_commands.back();
+        cmd.type = type; cmd.layer = layer; cmd.color = color;
+        return cmd;
+    }
+
+public:
+    RenderQueue() { m_commands.reserve(512); m_sortKeys.reserve(512); m_textArena.reserve(1024); }
+
+    /** @brief Vide le tampon pour une nouvelle trame (la capacité est conservée). */
+    void clear() { m_commands.clear(); m_sortKeys.clear(); m_textArena.clear(); }
+
+    /** @brief Enregistre un rectangle plein. */
+    void rect(float x, float y, float width, float height, Config::Color color, RenderLayer layer = RenderLayer::WORLD) {
+        push(RenderCommandType::RECT, layer, color).rect = {x, y, width, height};
+    }
+
+    /** @brief Enregistre un rectangle plein en utilisant la structure Rect. */
+    void rect(const Rect& r, Config::Color color, RenderLayer layer = RenderLayer::WORLD) { rect(r.x, r.y, r.width, r.height, color, layer); }
+
+    /** @brief Enregistre un cercle plein de centre (cx, cy). */
+    void circle(float cx, float cy, float radius, int segments, Config::Color color, RenderLayer layer = RenderLayer::WORLD) {
+        RenderCommand& cmd = push(RenderCommandType::CIRCLE, layer, color);
+        cmd.rect = {cx, cy, 0.0f, 0.0f}; cmd.param = radius; cmd.segments = static_cast<uint16_t>(segments);
+    }
+
+    /** @brief Enregistre un rectangle texturé (mélange alpha activé). Ignoré si `textureID` vaut 0. */
+    void texturedQuad(float x, float y, float width, float height, GLuint textureID, RenderLayer layer = RenderLayer::UI) {
+        if (textureID == 0) return;
+        push(RenderCommandType::TEXTURED_QUAD, layer, {1.0f, 1.0f, 1.0f}).rect = {x, y, width, height};
+        m_commands.back().texture = textureID;
+    }
+
+    /** @brief Enregistre un texte centré horizontalement sur `xCenter` (voir `TextRenderer::render`). */
+    void text(std::string_view str, float xCenter, float yBaseline, float scale, Config::Color color, RenderLayer layer = RenderLayer::UI_TEXT) {
+        RenderCommand& cmd = push(RenderCommandType::TEXT, layer, color);
+        cmd.rect = {xCenter, yBaseline, 0.0f, 0.0f}; cmd.param = scale;
+        cmd.textOffset = static_cast<uint32_t>(m_textArena.size());
+        cmd.textLength = static_cast<uint32_t>(str.size());
+        m_textArena.append(str);
+    }
+
+    /** @brief Enregistre le contour d'un rectangle. */
+    void lineLoop(const Rect& r, float lineWidth, Config::Color color, RenderLayer layer = RenderLayer::WORLD_OVERLAY) {
+        RenderCommand& cmd = push(RenderCommandType::LINE_LOOP, layer, color);
+        cmd.rect = r; cmd.param = lineWidth;
+    }
+
+    /**
+     * @brief Enregistre un quad texturé par une région d'atlas, teinté par `color` avec l'opacité `alpha`.
+     * @note Les quads d'atlas consécutifs partageant la texture sont dessinés en un seul appel.
+     */
+    void atlasQuad(const Rect& r, const Rect& uv, GLuint textureID, Config::Color color, float alpha, RenderLayer layer = RenderLayer::DEBUG_OVERLAY) {
+        if (textureID == 0) return;
+        RenderCommand& cmd = push(RenderCommandType::ATLAS_QUAD, layer, color);
+        cmd.rect = r; cmd.uv = uv; cmd.texture = textureID; cmd.param = alpha;
+    }
+
+    /** @brief Calcule l'ordre d'exécution trié par couche, état et texture. */
+    void sort() {
+        PROFILE_ZONE("RenderQueue::sort");
+        m_sortKeys.clear();
+        for (size_t i = 0; i < m_commands.size(); ++i) {
+            const RenderCommand& cmd = m_commands[i];
+            uint64_t key = (static_cast<uint64_t>(cmd.layer) << 56) | (stateClass(cmd.type) << 48) |
+                           ((static_cast<uint64_t>(cmd.texture) & 0xFFFFF) << 28) | (static_cast<uint64_t>(i) & INDEX_MASK);
+            m_sortKeys.push_back(key);
+        }
+        std::sort(m_sortKeys.begin(), m_sortKeys.end());
+    }
+
+    /** @brief Nombre de commandes enregistrées. */
+    size_t size() const { return m_commands.size(); }
+
+    /** @brief Obtient la i-ème commande dans l'ordre trié (appeler `sort()` au préalable). */
+    const RenderCommand& sortedAt(size_t i) const { return m_commands[m_sortKeys[i] & INDEX_MASK]; }
+
+    /** @brief Obtient le texte d'une commande `TEXT`. */
+    std::string_view textOf(const RenderCommand& cmd) const { return std::string_view(m_textArena).substr(cmd.textOffset, cmd.textLength); }
+};
+
+/**
+* @class SpscQueue
+* @brief File circulaire sans verrou à un producteur et un consommateur.
+* @tparam T Type des éléments (copiables).
+* @tparam Capacity Capacité de la file, doit être une puissance de 2.
+* @param m_items Stockage des éléments.
+* @param m_head Index de lecture (modifié uniquement par le consommateur).
+* @param m_tail Index d'écriture (modifié uniquement par le producteur).
+*/
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+private:
+    std::array<T, Capacity> m_items{};
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+public:
+    /** @brief Ajoute un élément (producteur). @return `false` si la file est pleine. */
+    bool push(const T& item) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) return false;
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief Retire l'élément le plus ancien (consommateur). @return `false` si la file est vide. */
+    bool pop(T& out) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        out = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/**
+* @class TripleBuffer
+* @brief Triple tampon sans verrou : un écrivain publie des états complets, un lecteur récupère toujours le plus récent.
+*
+* L'écrivain remplit `back()` puis appelle `publish()`, qui échange le tampon arrière avec le tampon du milieu.
+* Le lecteur appelle `update()` pour échanger le tampon du milieu avec `front()` si un nouvel état a été publié.
+* Aucun des deux côtés n'attend l'autre, et un état publié n'est plus modifié tant que le lecteur le consulte.
+*
+* @param m_buffers Les trois tampons.
+* @param m_middle Index du tampon du milieu, avec le bit `FRESH` si celui-ci n'a pas encore été lu.
+* @param m_back Index du tampon de l'écrivain.
+* @param m_front Index du tampon du lecteur.
+*/
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr uint8_t FRESH = 0x4;
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    T m_buffers[3];
+    std::atomic<uint8_t> m_middle{1};
+    uint8_t m_back = 0;
+    uint8_t m_front = 2;
+public:
+    /** @brief Tampon en cours d'écriture (écrivain uniquement). */
+    T& back() { return m_buffers[m_back]; }
+
+    /** @brief Publie le tampon arrière (écrivain uniquement). */
+    void publish() { m_back = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH), std::memory_order_acq_rel) & INDEX_MASK; }
+
+    /** @brief Récupère le dernier état publié s'il y en a un nouveau (lecteur uniquement). @return `true` si `front()` a changé. */
+    bool update() {
+        if (!(m_middle.load(std::memory_order_acquire) & FRESH)) return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /** @brief Dernier état récupéré par `update()` (lecteur uniquement). */
+    const T& front() const { return m_buffers[m_front]; }
+};
+
+/**
+* @class WakeSignal
+* @brief Signal de réveil entre threads : un thread attend (avec délai maximal) qu'un autre le notifie.
+* @param m_mutex Verrou protégeant `m_signaled`.
+* @param m_cv Variable de condition pour l'attente.
+* @param m_signaled Indique qu'une notification n'a pas encore été consommée.
+*/
+class WakeSignal {
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_signaled = false;
+public:
+    /** @brief Réveille le thread en attente (ou le prochain appel à `waitFor`). */
+    void notify() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_signaled = true; }
+        m_cv.notify_one();
+    }
+
+    /** @brief Attend une notification pendant au plus `seconds` secondes. @return `true` si une notification a été reçue. */
+    bool waitFor(double seconds) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        bool signaled = m_cv.wait_for(lock, std::chrono::duration<double>(seconds), [this] { return m_signaled; });
+        m_signaled = false;
+        return signaled;
+    }
+};
+
+/**
+ * @enum PacingMode
+ * @brief Stratégies de cadencement des trames du thread de rendu.
+ * @note VSYNC : seul `glfwSwapBuffers` (intervalle d'échange 1) limite la cadence.
+ * @note SLEEP_SPIN : échéances fixes à la fréquence cible, sommeil haute résolution puis attente active courte.
+ * @note UNCAPPED : aucune limite, pour les mesures de performance.
+ */
+enum class PacingMode { VSYNC, SLEEP_SPIN, UNCAPPED };
+
+/**
+* @class FramePacer
+* @brief Cadence la boucle de rendu selon une `PacingMode` et mesure la durée des trames présentées.
+* @param m_mode Stratégie de cadencement.
+* @param m_targetHz Fréquence cible en Hz (utilisée par SLEEP_SPIN).
+* @param m_period Durée d'une trame à la fréquence cible.
+* @param m_deadline Échéance de la prochaine trame (SLEEP_SPIN).
+* @param m_lastPresent Instant de la dernière trame présentée ; invalide après une pause (`resetTiming`).
+* @param m_hasLastPresent Indique si `m_lastPresent` est valide.
+* @param m_samples Durées des dernières trames en secondes (tampon circulaire).
+* @param m_sampleCount Nombre total de trames mesurées.
+*/
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+private:
+    PacingMode m_mode = PacingMode::SLEEP_SPIN;
+    double m_targetHz = Config::TARGET_FPS;
+    Clock::duration m_period{};
+    Clock::time_point m_deadline{};
+    Clock::time_point m_lastPresent{};
+    bool m_hasLastPresent = false;
+    std::vector<float> m_samples;
+    size_t m_sampleCount = 0;
+public:
+    FramePacer() { m_samples.resize(Config::FRAME_TIME_SAMPLES); configure(m_mode, m_targetHz); }
+
+    /** @brief Choisit la stratégie et la fréquence cible (une fréquence non positive retombe sur `Config::TARGET_FPS`). */
+    void configure(PacingMode mode, double targetHz) {
+        m_mode = mode;
+        m_targetHz = (targetHz > 0.0) ? targetHz : Config::TARGET_FPS;
+        m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_targetHz));
+        resetTiming();
+    }
+
+    PacingMode getMode() const { return m_mode; }
+    double getTargetHz() const { return m_targetHz; }
+    /** @brief Intervalle d'échange à passer à `glfwSwapInterval` pour cette stratégie. */
+    int swapInterval() const { return (m_mode == PacingMode::VSYNC) ? 1 : 0; }
+
+    /** @brief Oublie la dernière trame présentée (après une pause), pour ne pas mesurer ni rattraper le temps d'attente. */
+    void resetTiming() { m_hasLastPresent = false; m_deadline = Clock::now() + m_period; }
+
+    /**
+     * @brief À appeler juste après `glfwSwapBuffers` : mesure l'intervalle depuis la trame précédente puis attend
+     *        l'échéance suivante (SLEEP_SPIN).
+     * @note L'échéance avance d'une période fixe, sans accumuler le retard de réveil ; en cas de retard de plus
+     *       d'une période, elle se resynchronise sur l'instant présent.
+     */
+    void endFrame() {
+        Clock::time_point now = Clock::now();
+        if (m_hasLastPresent) {
+            m_samples[m_sampleCount % m_samples.size()] = std::chrono::duration<float>(now - m_lastPresent).count();
+            ++m_sampleCount;
+        }
+        if (m_mode == PacingMode::SLEEP_SPIN) {
+            if (now - m_deadline > m_period) m_deadline = now;
+            const Clock::duration spinMargin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Config::PACING_SPIN_MARGIN));
+            if (m_deadline - now > spinMargin) std::this_thread::sleep_until(m_deadline - spinMargin);
+            while (Clock::now() < m_deadline) std::this_thread::yield();
+            m_deadline += m_period;
+        }
+        m_lastPresent = now;
+        m_hasLastPresent = true;
+    }
+
+    /** @brief Nom lisible d'une stratégie (également la valeur de l'option `--pacing=`). */
+    static const char* modeName(PacingMode mode) {
+        switch (mode) {
+            case PacingMode::VSYNC: return "vsync";
+            case PacingMode::SLEEP_SPIN: return "sleep-spin";
+            case PacingMode::UNCAPPED: return "uncapped";
+        }
+        return "?";
+    }
+
+    /** @brief Convertit un nom d'option en stratégie. @return `false` si le nom est inconnu. */
+    static bool parseMode(std::string_view name, PacingMode& outMode) {
+        for (PacingMode mode : { PacingMode::VSYNC, PacingMode::SLEEP_SPIN, PacingMode::UNCAPPED }) {
+            if (name == modeName(mode)) { outMode = mode; return true; }
+        }
+        return false;
+    }
+
+    /** @brief Affiche les percentiles de durée des trames mesurées (p50, p90, p99, p99.9, max). */
+    void report(std::ostream& out) const {
+        size_t count = std::min(m_sampleCount, m_samples.size());
+        out << "Frame pacing (" << modeName(m_mode) << ", target " << m_targetHz << " Hz): ";
+        if (count == 0) { out << "no frames measured." << std::endl; return; }
+        std::vector<float> sorted(m_samples.begin(), m_samples.begin() + count);
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](double p) { return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * (sorted.size() - 1) + 0.5))] * 1000.0f; };
+        out << count << " frames, p50 " << percentile(0.50) << " ms, p90 " << percentile(0.90) << " ms, p99 " << percentile(0.99)
+            << " ms, p99.9 " << percentile(0.999) << " ms, max " << sorted.back() * 1000.0f << " ms" << std::endl;
+    }
+};
+
+/**
+* @class LatencyHistogram
+* @brief Histogramme des latences d'entrée (de la réception d'un événement à l'affichage de son effet), par tranches de 1 ms.
+* @param m_buckets Nombre de mesures par tranche ; la dernière tranche regroupe les mesures au-delà de `MAX_MS`.
+* @param m_count Nombre total de mesures.
+* @param m_sumMs Somme des latences (moyenne).
+* @param m_maxMs Latence maximale mesurée.
+*/
+class LatencyHistogram {
+public:
+    static constexpr int MAX_MS = 200;
+private:
+    std::array<uint32_t, MAX_MS + 1> m_buckets{};
+    uint64_t m_count = 0;
+    double m_sumMs = 0.0;
+    double m_maxMs = 0.0;
+public:
+    /** @brief Ajoute une mesure, en secondes (les valeurs négatives sont ignorées). */
+    void record(double seconds) {
+        if (seconds < 0.0) return;
+        double ms = seconds * 1000.0;
+        m_buckets[std::min(static_cast<int>(ms), MAX_MS)]++;
+        ++m_count; m_sumMs += ms; m_maxMs = std::max(m_maxMs, ms);
+    }
+
+    uint64_t getCount() const { return m_count; }
+
+    /** @brief Percentile approché (borne haute de la tranche), en millisecondes. `p` entre 0 et 1. */
+    float percentileMs(double p) const {
+        if (m_count == 0) return 0.0f;
+        uint64_t rank = static_cast<uint64_t>(p * (m_count - 1)) + 1, seen = 0;
+        for (int i = 0; i <= MAX_MS; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) return static_cast<float>(std::min(i + 1.0, m_maxMs));
+        }
+        return static_cast<float>(m_maxMs);
+    }
+
+    /** @brief Affiche la synthèse et les tranches non vides, avec une barre proportionnelle. */
+    void report(std::ostream& out) const {
+        out << "Input latency (cursor event to buffer swap): ";
+        if (m_count == 0) { out << "no samples." << std::endl; return; }
+        out << m_count << " samples, mean " << m_sumMs / m_count << " ms, p50 " << percentileMs(0.50) << " ms, p90 " << percentileMs(0.90)
+            << " ms, p99 " << percentileMs(0.99) << " ms, max " << m_maxMs << " ms" << std::endl;
+        uint32_t peak = *std::max_element(m_buckets.begin(), m_buckets.end());
+        for (int i = 0; i <= MAX_MS; ++i) {
+            if (m_buckets[i] == 0) continue;
+            char label[32];
+            if (i == MAX_MS) std::snprintf(label, sizeof(label), "  >=%3d ms ", MAX_MS);
+            else std::snprintf(label, sizeof(label), "  %3d-%3d ms ", i, i + 1);
+            out << label << std::string(1 + m_buckets[i] * 50 / peak, '#') << ' ' << m_buckets[i] << std::endl;
+        }
+    }
+};
+
+/**
+ * @enum InputEventType
+ * @brief Types d'événements transmis par les callbacks GLFW au thread de simulation.
+ */
+enum class InputEventType : uint8_t {
+    KEY,
+    MOUSE_BUTTON,
+    CURSOR_POS,
+    SCROLL,
+    RESIZE
+};
+
+/**
+ * @struct InputEvent
+ * @brief Événement d'entrée copié dans la file du thread de simulation.
+ * @param type Type de l'événement.
+ * @param code Touche ou bouton (KEY, MOUSE_BUTTON), largeur du framebuffer (RESIZE).
+ * @param action Action GLFW (KEY, MOUSE_BUTTON), hauteur du framebuffer (RESIZE).
+ * @param x Position X du curseur (CURSOR_POS).
+ * @param y Position Y du curseur, origine en haut (CURSOR_POS), déplacement vertical de la molette (SCROLL).
+ * @param time Instant de réception par le callback GLFW (`glfwGetTime`, en secondes).
+ */
+struct InputEvent {
+    InputEventType type = InputEventType::KEY;
+    int code = 0;
+    int action = 0;
+    double x = 0.0;
+    double y = 0.0;
+    double time = 0.0;
+};
+
+/**
+ * @class InputManager
+ * @brief Gère les événements d'entrée du clavier, de la souris et les interactions du curseur.
+ *
+ * Les callbacks (`keyCallback`, `mouseButtonCallback`, `cursorPosCallback`, `scrollCallback`, `resizeCallback`) sont appelés sur le thread
+ * principal et ne font qu'ajouter un événement horodaté dans une file circulaire sans verrou. `nextFrame()`, appelé
+ * par le thread de simulation, vide cette file dans l'ordre et met à jour l'état des touches et de la souris. Aucune
+ * de ces étapes n'alloue de mémoire.
+ *
+ * @param m_events File sans verrou des événements horodatés (thread principal vers thread de simulation).
+ * @param m_frameEvents Événements appliqués par le dernier `nextFrame()`, dans l'ordre de réception (rejeu, simulation intra-pas).
+ * @param m_frameEventCount Nombre d'événements dans `m_frameEvents`.
+ * @param m_keyIsDown État actuel des touches, indexé par code de touche GLFW (vrai si une touche est maintenue).
+ * @param m_keyWasPressed Touches qui ont été pressées dans la trame actuelle.
+ * @param m_keyWasReleased Touches qui ont été relâchées dans la trame actuelle.
+ * @param m_mouseDown État actuel des boutons de la souris, indexé par bouton GLFW.
+ * @param m_mouseClicked Boutons de la souris cliqués dans la trame actuelle.
+ * @param m_mousePos Un objet Vec2 représentant la position actuelle de la souris.
+ * @param m_lastCursorTime Instant de réception du dernier déplacement du curseur appliqué (0 si aucun).
+ * @param m_scrollY Déplacement vertical de la molette cumulé dans la trame actuelle (positif vers le haut).
+ * @param m_windowHeight Un entier représentant la hauteur de la fenêtre, utilisé pour les calculs de position du curseur (Y inversé).
+ */
+class InputManager {
+public:
+    using EventQueue = SpscQueue<InputEvent, Config::INPUT_QUEUE_CAPACITY>;
+    using FrameEvents = std::array<InputEvent, Config::INPUT_QUEUE_CAPACITY>;
+private:
+    static constexpr int KEY_COUNT = GLFW_KEY_LAST + 1;
+    static constexpr int MOUSE_BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+    EventQueue m_events;
+    FrameEvents m_frameEvents;
+    size_t m_frameEventCount = 0;
+    std::bitset<KEY_COUNT> m_keyIsDown;
+    std::bitset<KEY_COUNT> m_keyWasPressed;
+    std::bitset<KEY_COUNT> m_keyWasReleased;
+    std::bitset<MOUSE_BUTTON_COUNT> m_mouseDown;
+    std::bitset<MOUSE_BUTTON_COUNT> m_mouseClicked;
+    Vec2 m_mousePos = {0.0f, 0.0f};
+    double m_lastCursorTime = 0.0;
+    float m_scrollY = 0.0f;
+    int m_windowHeight = Config::WINDOW_HEIGHT;
+
+    /** @brief Ajoute un événement horodaté à la file (thread principal). Un événement est perdu si la file est pleine. */
+    void pushEvent(InputEvent event) {
+        event.time = glfwGetTime();
+        m_events.push(event);
+    }
+
+    /** @brief Applique un événement à l'état des touches et de la souris (thread de simulation). */
+    void applyEvent(const InputEvent& event) {
+        switch (event.type) {
+            case InputEventType::KEY:
+                if (event.code < 0 || event.code >= KEY_COUNT) break;
+                if (event.action == GLFW_PRESS) { m_keyIsDown.set(event.code); m_keyWasPressed.set(event.code); }
+                else if (event.action == GLFW_RELEASE) { m_keyIsDown.reset(event.code); m_keyWasReleased.set(event.code); }
+                break;
+            case InputEventType::MOUSE_BUTTON:
+                if (event.code < 0 || event.code >= MOUSE_BUTTON_COUNT) break;
+                m_mouseDown.set(event.code, event.action == GLFW_PRESS);
+                if (event.action == GLFW_PRESS) m_mouseClicked.set(event.code);
+                break;
+            case InputEventType::CURSOR_POS:
+                m_mousePos.x = static_cast<float>(event.x);
+                m_mousePos.y = static_cast<float>(m_windowHeight) - static_cast<float>(event.y);
+                m_lastCursorTime = event.time;
+                break;
+            case InputEventType::SCROLL:
+                m_scrollY += static_cast<float>(event.y);
+                break;
+            case InputEventType::RESIZE:
+                setWindowHeight(event.action);
+                break;
+        }
+    }
+
+public:
+    InputManager() = default;
+
+    /** @brief Définit la hauteur de la fenêtre pour le calcul correct de la position Y de la souris. */
+    void setWindowHeight(int height) { m_windowHeight = height > 0 ? height : 1; }
+    
+    /**
+     * @brief Commence une nouvelle trame (thread de simulation) : réinitialise les clics/pressions de touches,
+     *        puis applique dans l'ordre les événements reçus depuis la trame précédente.
+     * @note Les événements appliqués restent consultables via `getFrameEvents()` jusqu'à l'appel suivant.
+     */
+    void nextFrame() {
+        m_keyWasPressed.reset(); m_keyWasReleased.reset(); m_mouseClicked.reset();
+        m_scrollY = 0.0f;
+        m_frameEventCount = 0;
+        InputEvent event;
+        while (m_events.pop(event)) {
+            applyEvent(event);
+            if (m_frameEventCount < m_frameEvents.size()) m_frameEvents[m_frameEventCount++] = event;
+        }
+    }
+    
+    /** @brief Fonction de Callback pour les événements clavier (thread principal). */
+    void keyCallback(int key, int action) { pushEvent({InputEventType::KEY, key, action}); }
+
+    /** @brief Fonction de Callback pour les événements des boutons de la souris (thread principal). */
+    void mouseButtonCallback(int button, int action) { pushEvent({InputEventType::MOUSE_BUTTON, button, action}); }
+    
+    /** @brief Fonction de Callback pour la position du curseur (thread principal). Y est inversé lors de l'application. */
+    void cursorPosCallback(double xpos, double ypos) { pushEvent({InputEventType::CURSOR_POS, 0, 0, xpos, ypos}); }
+
+    /** @brief Fonction de Callback pour la molette de la souris (thread principal). */
+    void scrollCallback(double xoffset, double yoffset) { pushEvent({InputEventType::SCROLL, 0, 0, xoffset, yoffset}); }
+
+    /** @brief Transmet un changement de taille du framebuffer dans l'ordre des autres événements (thread principal). */
+    void resizeCallback(int width, int height) { pushEvent({InputEventType::RESIZE, width, height}); }
+
+    /** @brief Obtient les événements appliqués par le dernier `nextFrame()` (les `getFrameEventCount()` premiers). */
+    const FrameEvents& getFrameEvents() const { return m_frameEvents; }
+
+    /** @brief Obtient le nombre d'événements appliqués par le dernier `nextFrame()`. */
+    size_t getFrameEventCount() const { return m_frameEventCount; }
+    
+    /** @brief Vérifie si une touche est actuellement maintenue enfoncée. */
+    bool isKeyDown(int key) const { return key >= 0 && key < KEY_COUNT && m_keyIsDown.test(key); }
+    
+    /** @brief Vérifie si une touche a été pressée dans la trame actuelle. */
+    bool wasKeyPressed(int key) const { return key >= 0 && key < KEY_COUNT && m_keyWasPressed.test(key); }
+    
+    /** @brief Vérifie si une touche a été relâchée dans la trame actuelle. */
+    bool wasKeyReleased(int key) const { return key >= 0 && key < KEY_COUNT && m_keyWasReleased.test(key); }
+    
+    /** @brief Obtient la position actuelle de la souris. */
+    const Vec2& getMousePos() const { return m_mousePos; }
+    
+    /** @brief Obtient la coordonnée X actuelle de la souris. */
+    float getMouseX() const { return m_mousePos.x; }
+    
+    /** @brief Obtient la coordonnée Y actuelle de la souris (origine en bas à gauche). */
+    float getMouseY() const { return m_mousePos.y; }
+
+    /** @brief Obtient l'instant de réception (`glfwGetTime`) du dernier déplacement du curseur appliqué. */
+    double getLastCursorTime() const { return m_lastCursorTime; }
+    
+    /** @brief Vérifie si le bouton gauche de la souris est actuellement maintenu enfoncé. */
+    bool isMouseLeftDown() const { return m_mouseDown.test(GLFW_MOUSE_BUTTON_LEFT); }
+    
+    /** @brief Vérifie si le bouton gauche de la souris a été cliqué dans la trame actuelle. */
+    bool wasMouseLeftClicked() const { return m_mouseClicked.test(GLFW_MOUSE_BUTTON_LEFT); }
+    
+    /** @brief Vérifie si le bouton droit de la souris est actuellement maintenu enfoncé. */
+    bool isMouseRightDown() const { return m_mouseDown.test(GLFW_MOUSE_BUTTON_RIGHT); }
+    
+    /** @brief Vérifie si le bouton droit de la souris a été cliqué dans la trame actuelle. */
+    bool wasMouseRightClicked() const { return m_mouseClicked.test(GLFW_MOUSE_BUTTON_RIGHT); }
+    
+    /** @brief Vérifie si le bouton du milieu de la souris est actuellement maintenu enfoncé. */
+    bool isMouseMiddleDown() const { return m_mouseDown.test(GLFW_MOUSE_BUTTON_MIDDLE); }
+
+    /** @brief Obtient le déplacement vertical de la molette dans la trame actuelle (en crans, positif vers le haut). */
+    float getScrollY() const { return m_scrollY; }
+
+    /** @brief Vérifie si l'une des touches Maj (Shift) est maintenue enfoncée. */
+    bool isShiftDown() const { return isKeyDown(GLFW_KEY_LEFT_SHIFT) || isKeyDown(GLFW_KEY_RIGHT_SHIFT); }
+
+    /** @brief Vérifie si une touche Ctrl est enfoncée. */
+    bool isControlDown() const { return isKeyDown(GLFW_KEY_LEFT_CONTROL) || isKeyDown(GLFW_KEY_RIGHT_CONTROL); }
+};
+
+/**
+* @class TextRenderer
+* @brief Gère le rendu du texte à l'écran en utilisant FreeType.
+*
+* @param m_ft Instance de la bibliothèque FreeType.
+* @param m_face Instance de la police FreeType (FT_Face).
+* @param m_characters Map des caractères pré-rendus (ASCII vers la structure Character).
+* @param m_atlasTexture Atlas regroupant tous les glyphes et un bloc opaque, pour dessiner texte et formes en un seul lot.
+* @param m_atlasWidth Largeur de l'atlas en pixels.
+* @param m_atlasHeight Hauteur de l'atlas en pixels.
+* @param m_initialized Indicateur booléen de l'état d'initialisation du moteur de rendu.
+*/
+class TextRenderer {
+private:
+    /**
+    * @struct Character
+    * @brief Structure pour stocker les propriétés d'un caractère de police.
+    * @param textureID ID de la texture OpenGL pour le glyphe du caractère.
+    * @param sizeX Largeur de la texture du caractère.
+    * @param sizeY Hauteur de la texture du caractère.
+    * @param bearingX Décalage X de la ligne de base au point le plus à gauche du caractère.
+    * @param bearingY Décalage Y de la ligne de base au point le plus haut du caractère.
+    * @param advance Décalage horizontal vers le caractère suivant.
+    * @param atlasUV Région du glyphe dans l'atlas (`y` désigne le haut du glyphe).
+    */
+    struct Character {
+        unsigned int textureID = 0; 
+        int sizeX = 0; 
+        int sizeY = 0;
+        int bearingX = 0; 
+        int bearingY = 0; 
+        unsigned int advance = 0;
+        Rect atlasUV;
+    };
+    FT_Library m_ft = nullptr; 
+    FT_Face m_face = nullptr;
+    std::map<char, Character> m_characters; 
+    GLuint m_atlasTexture = 0;
+    int m_atlasWidth = 0;
+    int m_atlasHeight = 0;
+    bool m_initialized = false;
+
+    /** @brief Largeur de l'atlas de glyphes ; la hauteur est la puissance de 2 suffisante. */
+    static constexpr int ATLAS_WIDTH = 512;
+    /** @brief Côté du bloc opaque placé en (0, 0) de l'atlas (échantillonné pour les formes pleines). */
+    static constexpr int ATLAS_SOLID_SIZE = 4;
+
+    /**
+     * @brief Construit l'atlas de glyphes : bloc opaque en haut à gauche, puis les glyphes rangés par lignes.
+     * @note Les glyphes sont rechargés depuis FreeType ; appelée par `init` une fois `m_characters` rempli.
+     */
+    void buildAtlas() {
+        struct Placement { char c; int x, y, w, h; };
+        std::vector<Placement> placements;
+        int penX = ATLAS_SOLID_SIZE + 1, penY = 0, rowHeight = ATLAS_SOLID_SIZE;
+        for (auto& [c, ch] : m_characters) {
+            if (ch.sizeX == 0 || ch.sizeY == 0) continue;
+            if (penX + ch.sizeX > ATLAS_WIDTH) { penX = 0; penY += rowHeight + 1; rowHeight = 0; }
+            placements.push_back({c, penX, penY, ch.sizeX, ch.sizeY});
+            penX += ch.sizeX + 1;
+            rowHeight = std::max(rowHeight, ch.sizeY);
+        }
+        int height = 1;
+        while (height < penY + rowHeight) height <<= 1;
+
+        std::vector<unsigned char> pixels(static_cast<size_t>(ATLAS_WIDTH) * height, 0);
+        for (int y = 0; y < ATLAS_SOLID_SIZE; ++y) std::fill_n(pixels.begin() + static_cast<size_t>(y) * ATLAS_WIDTH, ATLAS_SOLID_SIZE, 255);
+        for (const Placement& pl : placements) {
+            if (FT_Load_Char(m_face, static_cast<unsigned char>(pl.c), FT_LOAD_RENDER)) continue;
+            const FT_Bitmap& bitmap = m_face->glyph->bitmap;
+            for (int row = 0; row < pl.h && row < static_cast<int>(bitmap.rows); ++row) {
+                const unsigned char* src = bitmap.buffer + row * bitmap.pitch;
+                std::copy(src, src + std::min(pl.w, static_cast<int>(bitmap.width)), pixels.begin() + static_cast<size_t>(pl.y + row) * ATLAS_WIDTH + pl.x);
+            }
+            m_characters[pl.c].atlasUV = { static_cast<float>(pl.x) / ATLAS_WIDTH, static_cast<float>(pl.y) / height,
+                                           static_cast<float>(pl.w) / ATLAS_WIDTH, static_cast<float>(pl.h) / height };
+        }
+
+        glGenTextures(1, &m_atlasTexture); glBindTexture(GL_TEXTURE_2D, m_atlasTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_WIDTH, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        m_atlasWidth = ATLAS_WIDTH; m_atlasHeight = height;
+    }
+public:
+    TextRenderer() = default; 
+    ~TextRenderer() { cleanup(); }
+    TextRenderer(const TextRenderer&) = delete; 
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    /**
+     * @brief Initialise le moteur de rendu de texte.
+     * @param fontPath Chemin vers le fichier de police (.ttf).
+     * @param pixelSize Taille de la police en pixels.
+     * @return `true` si l'initialisation réussit, `false` sinon.
+     */
+    bool init(const char* fontPath, int pixelSize) {
+        if (m_initialized) return true;
+        if (FT_Init_FreeType(&m_ft)) {  return false; }
+        if (FT_New_Face(m_ft, fontPath, 0, &m_face)) { FT_Done_FreeType(m_ft); m_ft = nullptr; return false; }
+        FT_Set_Pixel_Sizes(m_face, 0, pixelSize); // Définit la largeur à 0 pour un calcul automatique
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Désactive la restriction d'alignement des octets
+        for (unsigned char c = 32; c < 127; c++) { // Charge les caractères ASCII imprimables
+            if (FT_Load_Char(m_face, c, FT_LOAD_RENDER)) {  continue; }
+            unsigned int texture; glGenTextures(1, &texture); glBindTexture(GL_TEXTURE_2D, texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_face->glyph->bitmap.width, m_face->glyph->bitmap.rows, 0, GL_ALPHA, GL_UNSIGNED_BYTE, m_face->glyph->bitmap.buffer);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); 
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); 
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            Character character = { texture, static_cast<int>(m_face->glyph->bitmap.width), static_cast<int>(m_face->glyph->bitmap.rows),
+                                    m_face->glyph->bitmap_left, m_face->glyph->bitmap_top, static_cast<unsigned int>(m_face->glyph->advance.x), {} };
+            m_characters.insert({c, character});
+        }
+        buildAtlas();
+        glBindTexture(GL_TEXTURE_2D, 0);
+        std::cout << "Text rendering initialized with font: " << fontPath << std::endl;
+        m_initialized = true; 
+        return true;
+    }
+
+    /**
+     * @brief Nettoie les ressources utilisées par le moteur de rendu de texte.
+     */
+    void cleanup() {
+        if (m_initialized) {
+            std::cout << "Cleaning up TextRenderer..." << std::endl;
+            for (auto const& [key, val] : m_characters) { if (val.textureID != 0) glDeleteTextures(1, &val.textureID); }
+            m_characters.clear();
+            if (m_atlasTexture != 0) { glDeleteTextures(1, &m_atlasTexture); m_atlasTexture = 0; }
+            if (m_face) { FT_Done_Face(m_face); m_face = nullptr; }
+            if (m_ft) { FT_Done_FreeType(m_ft); m_ft = nullptr; }
+            m_initialized = false;
+        }
+    }
+
+    /**
+     * @brief Calcule la largeur d'une chaîne de texte rendue.
+     * @param text Le texte à mesurer.
+     * @param scale L'échelle à appliquer au texte.
+     * @return La largeur du texte en pixels à l'échelle donnée.
+     */
+    float getTextWidth(std::string_view text, float scale) const {
+        if (!m_initialized) return 0.0f; 
+        float width = 0.0f;
+        for (char c : text) { auto it = m_characters.find(c); if (it != m_characters.end()) width += (it->second.advance >> 6) * scale; }
+        return width;
+    }
+
+    /** @brief Obtient la texture de l'atlas de glyphes (0 si non initialisé). */
+    GLuint getAtlasTexture() const { return m_atlasTexture; }
+
+    /** @brief Coordonnées de texture du bloc opaque de l'atlas : un quad d'atlas avec ces UV est une forme pleine. */
+    Rect getAtlasSolidUV() const {
+        if (m_atlasWidth == 0) return {};
+        float half = ATLAS_SOLID_SIZE * 0.5f;
+        return { half / m_atlasWidth, half / m_atlasHeight, 0.0f, 0.0f };
+    }
+
+    /**
+     * @brief Enregistre une ligne de texte alignée à gauche sous forme de quads d'atlas.
+     * @param queue Tampon de commandes de destination.
+     * @param text Texte sur une seule ligne.
+     * @param xLeft Coordonnée X du début de la ligne.
+     * @param yBaseline Coordonnée Y de la ligne de base.
+     * @param scale L'échelle à appliquer au texte.
+     * @param color La couleur du texte.
+     * @param layer Couche de rendu.
+     */
+    void recordAtlasText(RenderQueue& queue, std::string_view text, float xLeft, float yBaseline, float scale, Config::Color color, RenderLayer layer = RenderLayer::DEBUG_OVERLAY) const {
+        if (!m_initialized || m_atlasTexture == 0) return;
+        float currentX = xLeft;
+        for (char c : text) {
+            auto it = m_characters.find(c);
+            if (it == m_characters.end()) continue;
+            const Character& ch = it->second;
+            if (ch.sizeX > 0 && ch.sizeY > 0) {
+                Rect quad = { currentX + ch.bearingX * scale, yBaseline + (ch.bearingY - ch.sizeY) * scale, ch.sizeX * scale, ch.sizeY * scale };
+                queue.atlasQuad(quad, ch.atlasUV, m_atlasTexture, color, 1.0f, layer);
+            }
+            currentX += (ch.advance >> 6) * scale;
+        }
+    }
+
+    /**
+     * @brief Calcule la hauteur d'une ligne de texte rendue (basée sur les métriques de la police).
+     * @param scale L'échelle à appliquer au texte.
+     * @return La hauteur du texte en pixels à l'échelle donnée.
+     */
+    float getTextHeight(float scale) const {
+        if (!m_initialized || !m_face || !m_face->size) return 0.0f; 
+        return (static_cast<float>(m_face->size->metrics.height >> 6) * scale);
+    }
+
+    /**
+     * @brief Effectue le rendu d'une chaîne de texte à l'écran.
+     * @param text Le texte à afficher. Gère les sauts de ligne '\n'.
+     * @param x_center Coordonnée X du centre horizontal du bloc de texte.
+     * @param y_baseline_start Coordonnée Y de la ligne de base de la première ligne de texte (le texte s'étend vers le bas).
+     * @param scale L'échelle à appliquer au texte.
+     * @param color La couleur du texte.
+     * @return Le nombre de glyphes dessinés (un quad par glyphe).
+     * @note Appelée uniquement par `GLRenderBackend`, qui active au préalable `GL_TEXTURE_2D` et `GL_BLEND`.
+     */
+    int render(std::string_view text, float x_center, float y_baseline_start, float scale, Config::Color color) const {
+        if (!m_initialized) return 0;
+        int glyphsDrawn = 0;
+        glColor3f(color.r, color.g, color.b); 
+        glActiveTexture(GL_TEXTURE0);
+        
+        float currentY = y_baseline_start;
+        
+        // Calcul de la hauteur de ligne
+        float lineHeight = 0.0f;
+        if (m_face && m_face->size && m_face->size->metrics.height) {
+            lineHeight = (static_cast<float>(m_face->size->metrics.height >> 6) * scale);
+        } else { // Solution de repli si les métriques de la police ne sont pas disponibles
+            if (!m_characters.empty()) {
+                auto it_char = m_characters.begin();
+                if (m_characters.count('M')) it_char = m_characters.find('M');
+                else if (m_characters.count('A')) it_char = m_characters.find('A'); // Utilise 'M' ou 'A' comme référence
+                if (it_char != m_characters.end()) {
+                    lineHeight = static_cast<float>(it_char->second.sizeY) * scale * 1.2f; // 1.2f pour un espacement
+                }
+            }
+            if (lineHeight <= 0.001f) lineHeight = 20.0f * scale; // Valeur de secours absolue positive
+        }
+        if (lineHeight <= 0.001f) lineHeight = 20.0f * scale; // Assure une hauteur de ligne positive
+
+        // Gestion des sauts de ligne
+        std::vector<std::string_view> lines;
+        size_t lineStart = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\n') {
+                lines.push_back(text.substr(lineStart, i - lineStart));
+                lineStart = i + 1;
+            }
+        }
+        lines.push_back(text.substr(lineStart)); // Ajoute la dernière ligne
+
+        for (std::string_view line : lines) {
+            float lineWidth = getTextWidth(line, scale);
+            float lineStartX = x_center - (lineWidth / 2.0f);
+            float currentX = lineStartX;
+
+            // Rendu de chaque ligne
+            for (char c_char : line) {
+                auto it = m_characters.find(c_char); 
+                if (it == m_characters.end()) { // Caractère non trouvé
+                    if (m_characters.count(' ')) { // Avance par la largeur d'un espace si disponible
+                         currentX += (m_characters.at(' ').advance >> 6) * scale;
+                    }
+                    continue;
+                }
+                const Character& ch = it->second;
+                
+                // Si c'est un espace ou si le caractère n'a pas de texture/taille visible, on avance juste
+                if (c_char == ' ' || ch.textureID == 0 || ch.sizeX == 0 || ch.sizeY == 0) { 
+                    currentX += (ch.advance >> 6) * scale; 
+                    continue; 
+                }
+                
+                
+                float xpos = currentX + ch.bearingX * scale;
+                // La position Y est la ligne de base + (espaceY - hauteur_glyphe) * échelle
+                // car bearingY est la distance de la ligne de base au sommet du glyphe,
+                // et le quad est dessiné depuis son coin inférieur gauche.
+                float ypos = currentY + (ch.bearingY - ch.sizeY) * scale; 
+                float w = ch.sizeX * scale; 
+                float h = ch.sizeY * scale;
+                
+                glBindTexture(GL_TEXTURE_2D, ch.textureID);
+                glBegin(GL_QUADS);
+                // Attention : les coordonnées de texture Y sont souvent inversées par rapport à OpenGL.
+                // FreeType rend avec Y=0 en haut du glyphe. Si on charge avec stbi_set_flip_vertically_on_load(true)
+                // pour les textures normales, ici il faut être cohérent.
+                // Les glyphes FreeType sont généralement générés avec l'origine en bas à gauche du bitmap.
+                // Ici, le quad est défini avec (xpos, ypos) comme coin inférieur gauche.
+                glTexCoord2f(0.0f, 0.0f); glVertex2f(xpos, ypos + h);
+                glTexCoord2f(1.0f, 0.0f); glVertex2f(xpos + w, ypos + h);
+                glTexCoord2f(1.0f, 1.0f); glVertex2f(xpos + w, ypos);
+                glTexCoord2f(0.0f, 1.0f); glVertex2f(xpos, ypos);
+                glEnd();
+                ++glyphsDrawn;
+                
+                currentX += (ch.advance >> 6) * scale; // Avance pour le prochain caractère
+            }
+            currentY -= lineHeight; // Déplace la ligne de base vers le bas pour la ligne suivante
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return glyphsDrawn;
+    }
+};
+
+/**
+* @class RenderBackend
+* @brief Interface d'exécution d'un `RenderQueue` trié.
+* @param m_lastDrawCalls Nombre d'appels de dessin émis depuis le dernier `beginFrame()`.
+*/
+class RenderBackend {
+protected:
+    int m_lastDrawCalls = 0;
+public:
+    virtual ~RenderBackend() = default;
+
+    /**
+     * @brief Prépare une nouvelle trame (effacement et projection orthographique).
+     * @param width Largeur du framebuffer.
+     * @param height Hauteur du framebuffer.
+     */
+    virtual void beginFrame(int width, int height) = 0;
+
+    /** @brief Exécute les commandes du tampon dans l'ordre trié. */
+    virtual void submit(const RenderQueue& queue) = 0;
+
+    /** @brief Indique si le backend peut conserver une couche statique (bordures, briques) entre les trames. */
+    virtual bool supportsStaticLayer() const { return false; }
+
+    /**
+     * @brief Dessine des commandes dans la couche statique conservée.
+     * @param queue Commandes à dessiner dans la couche (trié).
+     * @param width Largeur de la couche (taille du framebuffer).
+     * @param height Hauteur de la couche.
+     * @param full `true` pour effacer la couche avant de dessiner, `false` pour une mise à jour partielle.
+     */
+    virtual void updateStaticLayer(const RenderQueue&, int, int, bool) {}
+
+    /** @brief Dessine la couche statique conservée en plein écran (à appeler après `beginFrame()`). */
+    virtual void drawStaticLayer(int, int) {}
+
+    /** @brief Obtient le nombre d'appels de dessin de la trame en cours ou de la dernière trame. */
+    int getLastDrawCalls() const { return m_lastDrawCalls; }
+};
+
+/**
+* @class GLRenderBackend
+* @brief Exécute les commandes avec OpenGL en mode immédiat.
+*
+* Les rectangles consécutifs sont regroupés dans un seul `glBegin(GL_QUADS)`, de même que les quads texturés
+* et les quads d'atlas consécutifs partageant la même texture. Les changements d'état (texture, mélange) ne sont émis qu'aux transitions.
+*
+* La couche statique est conservée dans une texture attachée à un framebuffer object (FBO). Les fonctions FBO
+* sont chargées à l'exécution ; si elles sont indisponibles, `supportsStaticLayer()` retourne `false`.
+*
+* @param m_textRenderer Moteur de rendu de texte utilisé pour les commandes `TEXT`.
+* @param m_texturing Indique si `GL_TEXTURE_2D` et `GL_BLEND` sont actuellement activés.
+* @param m_staticFbo Framebuffer object de la couche statique.
+* @param m_staticTexture Texture couleur de la couche statique.
+* @param m_staticWidth Largeur de la texture de la couche statique.
+* @param m_staticHeight Hauteur de la texture de la couche statique.
+*/
+class GLRenderBackend : public RenderBackend {
+private:
+    const TextRenderer& m_textRenderer;
+    bool m_texturing = false;
+
+    PFNGLGENFRAMEBUFFERSPROC m_glGenFramebuffers = nullptr;
+    PFNGLDELETEFRAMEBUFFERSPROC m_glDeleteFramebuffers = nullptr;
+    PFNGLBINDFRAMEBUFFERPROC m_glBindFramebuffer = nullptr;
+    PFNGLFRAMEBUFFERTEXTURE2DPROC m_glFramebufferTexture2D = nullptr;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC m_glCheckFramebufferStatus = nullptr;
+    GLuint m_staticFbo = 0;
+    GLuint m_staticTexture = 0;
+    int m_staticWidth = 0;
+    int m_staticHeight = 0;
+
+    /** @brief Charge une fonction OpenGL par son nom (version cœur, puis extension EXT). */
+    template <typename Proc>
+    static Proc loadProc(const char* name, const char* extName) {
+        Proc proc = reinterpret_cast<Proc>(glfwGetProcAddress(name));
+        if (!proc) proc = reinterpret_cast<Proc>(glfwGetProcAddress(extName));
+        return proc;
+    }
+
+    /** @brief Définit une projection orthographique de la taille du framebuffer. */
+    static void setOrthoProjection(int width, int height) {
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(0.0, static_cast<double>(width), 0.0, static_cast<double>(height), -1.0, 1.0);
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+    }
+
+    /** @brief (Ré)alloue la texture et le FBO de la couche statique à la taille demandée. @return `false` en cas d'échec. */
+    bool ensureStaticTarget(int width, int height) {
+        if (m_staticFbo != 0 && m_staticWidth == width && m_staticHeight == height) return true;
+        if (m_staticTexture == 0) glGenTextures(1, &m_staticTexture);
+        if (m_staticFbo == 0) m_glGenFramebuffers(1, &m_staticFbo);
+        glBindTexture(GL_TEXTURE_2D, m_staticTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        m_glBindFramebuffer(GL_FRAMEBUFFER, m_staticFbo);
+        m_glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_staticTexture, 0);
+        bool complete = m_glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        m_glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete) {
+            std::cerr << "Warning: Static layer framebuffer incomplete. Falling back to direct rendering." << std::endl;
+            m_glDeleteFramebuffers(1, &m_staticFbo);
+            glDeleteTextures(1, &m_staticTexture);
+            m_staticFbo = 0; m_staticTexture = 0;
+            m_staticWidth = 0; m_staticHeight = 0;
+            m_glGenFramebuffers = nullptr;
+            return false;
+        }
+        m_staticWidth = width; m_staticHeight = height;
+        std::cout << "Static layer allocated: " << width << "x" << height << std::endl;
+        return true;
+    }
+
+    /** @brief Active ou désactive le texturage et le mélange alpha si nécessaire. */
+    void setTexturing(bool enabled) {
+        if (enabled == m_texturing) return;
+        if (enabled) {
+            glEnable(GL_TEXTURE_2D);
+            glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        } else {
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDisable(GL_TEXTURE_2D); glDisable(GL_BLEND);
+        }
+        m_texturing = enabled;
+    }
+
+public:
+    /** @note Doit être construit avec le contexte OpenGL courant (chargement des fonctions FBO). */
+    explicit GLRenderBackend(const TextRenderer& textRenderer) : m_textRenderer(textRenderer) {
+        m_glGenFramebuffers = loadProc<PFNGLGENFRAMEBUFFERSPROC>("glGenFramebuffers", "glGenFramebuffersEXT");
+        m_glDeleteFramebuffers = loadProc<PFNGLDELETEFRAMEBUFFERSPROC>("glDeleteFramebuffers", "glDeleteFramebuffersEXT");
+        m_glBindFramebuffer = loadProc<PFNGLBINDFRAMEBUFFERPROC>("glBindFramebuffer", "glBindFramebufferEXT");
+        m_glFramebufferTexture2D = loadProc<PFNGLFRAMEBUFFERTEXTURE2DPROC>("glFramebufferTexture2D", "glFramebufferTexture2DEXT");
+        m_glCheckFramebufferStatus = loadProc<PFNGLCHECKFRAMEBUFFERSTATUSPROC>("glCheckFramebufferStatus", "glCheckFramebufferStatusEXT");
+        if (!supportsStaticLayer()) std::cerr << "Warning: Framebuffer objects unavailable. Static layer caching disabled." << std::endl;
+    }
+
+    ~GLRenderBackend() override {
+        if (m_staticFbo != 0 && m_glDeleteFramebuffers) m_glDeleteFramebuffers(1, &m_staticFbo);
+        if (m_staticTexture != 0) glDeleteTextures(1, &m_staticTexture);
+    }
+
+    void beginFrame(int width, int height) override {
+        m_lastDrawCalls = 0;
+        glClear(GL_COLOR_BUFFER_BIT);
+        setOrthoProjection(width, height);
+    }
+
+    bool supportsStaticLayer() const override {
+        return m_glGenFramebuffers && m_glDeleteFramebuffers && m_glBindFramebuffer && m_glFramebufferTexture2D && m_glCheckFramebufferStatus;
+    }
+
+    void updateStaticLayer(const RenderQueue& queue, int width, int height, bool full) override {
+        if (!supportsStaticLayer() || !ensureStaticTarget(width, height)) return;
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        m_glBindFramebuffer(GL_FRAMEBUFFER, m_staticFbo);
+        glViewport(0, 0, width, height);
+        if (full) glClear(GL_COLOR_BUFFER_BIT);
+        submit(queue);
+        m_glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
+    void drawStaticLayer(int width, int height) override {
+        if (m_staticTexture == 0) return;
+        glEnable(GL_TEXTURE_2D); glDisable(GL_BLEND);
+        glBindTexture(GL_TEXTURE_2D, m_staticTexture);
+        glColor3f(1.0f, 1.0f, 1.0f);
+        glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 0.0f); glVertex2f(0.0f, 0.0f);
+        glTexCoord2f(1.0f, 0.0f); glVertex2f(static_cast<float>(width), 0.0f);
+        glTexCoord2f(1.0f, 1.0f); glVertex2f(static_cast<float>(width), static_cast<float>(height));
+        glTexCoord2f(0.0f, 1.0f); glVertex2f(0.0f, static_cast<float>(height));
+        glEnd();
+        glBindTexture(GL_TEXTURE_2D, 0); glDisable(GL_TEXTURE_2D);
+        ++m_lastDrawCalls;
+    }
+
+    void submit(const RenderQueue& queue) override {
+        PROFILE_ZONE("GLRenderBackend::submit");
+        glDisable(GL_TEXTURE_2D); glDisable(GL_BLEND);
+        m_texturing = false;
+        size_t i = 0;
+        const size_t count = queue.size();
+        while (i < count) {
+            const RenderCommand& cmd = queue.sortedAt(i);
+            switch (cmd.type) {
+                case RenderCommandType::RECT: {
+                    setTexturing(false);
+                    glBegin(GL_QUADS);
+                    for (; i < count && queue.sortedAt(i).type == RenderCommandType::RECT; ++i) {
+                        const RenderCommand& r = queue.sortedAt(i);
+                        glColor3f(r.color.r, r.color.g, r.color.b);
+                        glVertex2f(r.rect.x, r.rect.y);
+                        glVertex2f(r.rect.x + r.rect.width, r.rect.y);
+                        glVertex2f(r.rect.x + r.rect.width, r.rect.y + r.rect.height);
+                        glVertex2f(r.rect.x, r.rect.y + r.rect.height);
+                    }
+                    glEnd();
+                    break;
+                }
+                case RenderCommandType::CIRCLE:
+                    setTexturing(false);
+                    Utils::drawCircle(cmd.rect.x, cmd.rect.y, cmd.param, cmd.segments, cmd.color);
+                    ++i;
+                    break;
+                case RenderCommandType::LINE_LOOP:
+                    setTexturing(false);
+                    Utils::drawLineLoop(cmd.rect, cmd.param, cmd.color);
+                    ++i;
+                    break;
+                case RenderCommandType::TEXTURED_QUAD: {
+                    setTexturing(true);
+                    GLuint texture = cmd.texture;
+                    glBindTexture(GL_TEXTURE_2D, texture);
+                    glColor3f(1.0f, 1.0f, 1.0f);
+                    glBegin(GL_QUADS);
+                    for (; i < count && queue.sortedAt(i).type == RenderCommandType::TEXTURED_QUAD && queue.sortedAt(i).texture == texture; ++i) {
+                        const Rect& q = queue.sortedAt(i).rect;
+                        glTexCoord2f(0.0f, 0.0f); glVertex2f(q.x, q.y);
+                        glTexCoord2f(1.0f, 0.0f); glVertex2f(q.x + q.width, q.y);
+                        glTexCoord2f(1.0f, 1.0f); glVertex2f(q.x + q.width, q.y + q.height);
+                        glTexCoord2f(0.0f, 1.0f); glVertex2f(q.x, q.y + q.height);
+                    }
+                    glEnd();
+                    break;
+                }
+                case RenderCommandType::TEXT: {
+                    setTexturing(true);
+                    m_lastDrawCalls += m_textRenderer.render(queue.textOf(cmd), cmd.rect.x, cmd.rect.y, cmd.param, cmd.color);
+                    ++i;
+                    break;
+                }
+                case RenderCommandType::ATLAS_QUAD: {
+                    setTexturing(true);
+                    GLuint texture = cmd.texture;
+                    glBindTexture(GL_TEXTURE_2D, texture);
+                    glBegin(GL_QUADS);
+                    for (; i < count && queue.sortedAt(i).type == RenderCommandType::ATLAS_QUAD && queue.sortedAt(i).texture == texture; ++i) {
+                        const RenderCommand& a = queue.sortedAt(i);
+                        const Rect& q = a.rect; const Rect& uv = a.uv;
+                        glColor4f(a.color.r, a.color.g, a.color.b, a.param);
+                        glTexCoord2f(uv.x, uv.y + uv.height);            glVertex2f(q.x, q.y);
+                        glTexCoord2f(uv.x + uv.width, uv.y + uv.height); glVertex2f(q.x + q.width, q.y);
+                        glTexCoord2f(uv.x + uv.width, uv.y);             glVertex2f(q.x + q.width, q.y + q.height);
+                        glTexCoord2f(uv.x, uv.y);                        glVertex2f(q.x, q.y + q.height);
+                    }
+                    glEnd();
+                    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+                    break;
+                }
+            }
+            if (cmd.type != RenderCommandType::TEXT) ++m_lastDrawCalls;
+        }
+        setTexturing(false);
+    }
+};
+
+/**
+* @class NullRenderBackend
+* @brief Backend qui ignore les commandes : permet de mesurer le coût de la logique et de l'enregistrement sans le coût OpenGL.
+* @param m_submittedCommands Nombre total de commandes reçues depuis le lancement.
+*/
+class NullRenderBackend : public RenderBackend {
+private:
+    uint64_t m_submittedCommands = 0;
+public:
+    void beginFrame(int, int) override { m_lastDrawCalls = 0; }
+    void submit(const RenderQueue& queue) override { m_submittedCommands += queue.size(); }
+
+    /** @brief Obtient le nombre total de commandes reçues. */
+    uint64_t getSubmittedCommands() const { return m_submittedCommands; }
+};
+
+/**
+* @class Paddle
+* @brief Représente la raquette contrôlée par le joueur.
+* @param m_rect Rectangle définissant la position et la taille de la raquette.
+* @param m_color Couleur de la raquette.
+* @param m_path Trajectoire de la raquette pendant le pas en cours : positions X aux fractions du pas (0 = début, 1 = fin).
+* @param m_pathCount Nombre de points de `m_path` (moins de 2 : raquette immobile en `m_rect.x`).
+*/
+class Paddle {
+public:
+    /** @brief Nombre maximal de points de trajectoire par pas (début, positions intermédiaires du curseur, fin). */
+    static constexpr int MAX_PATH_POINTS = 10;
+private:
+    /**
+    * @struct PathPoint
+    * @brief Position X de la raquette à une fraction du pas de simulation.
+    */
+    struct PathPoint { float fraction; float x; };
+
+    Rect m_rect; 
+    Config::Color m_color;
+    std::array<PathPoint, MAX_PATH_POINTS> m_path{};
+    int m_pathCount = 0;
+
+    /** @brief Position X clampée de la raquette centrée sur `cursorX`. */
+    float clampedX(float cursorX, float windowWidth) const { return std::clamp(cursorX - m_rect.width / 2.0f, 0.0f, windowWidth - m_rect.width); }
+public:
+    Paddle() : m_color(Config::COLOR_PADDLE) { m_rect.width = Config::PADDLE_WIDTH; m_rect.height = Config::PADDLE_HEIGHT; }
+    
+    /** @brief Initialise la position de la raquette. */
+    void init(float windowWidth, float windowHeight) { 
+        m_rect.x = (windowWidth - m_rect.width) / 2.0f; 
+        m_rect.y = windowHeight * 0.1f; 
+        m_pathCount = 0;
+    }
+
+    /** @brief Réinitialise la position horizontale de la raquette au centre. */
+    void resetPosition(float windowWidth) { 
+        m_rect.x = (windowWidth - m_rect.width) / 2.0f; 
+        m_pathCount = 0;
+    }
+
+    /** @brief Commence la trajectoire d'un pas de simulation à la position actuelle. */
+    void beginPath() { m_path[0] = { 0.0f, m_rect.x }; m_pathCount = 1; }
+
+    /**
+     * @brief Ajoute une position intermédiaire du curseur à la trajectoire du pas.
+     * @param fraction Instant de l'échantillon en fraction du pas (0 à 1, croissant).
+     * @note Les échantillons au-delà de la capacité sont ignorés (la dernière place est réservée à la fin du pas).
+     */
+    void addPathSample(float fraction, float cursorX, float windowWidth) {
+        if (m_pathCount == 0 || m_pathCount >= MAX_PATH_POINTS - 1) return;
+        fraction = std::clamp(fraction, m_path[m_pathCount - 1].fraction, 1.0f);
+        m_path[m_pathCount++] = { fraction, clampedX(cursorX, windowWidth) };
+    }
+
+    /** @brief Termine la trajectoire du pas à la position actuelle (après `update` ou `followCursor`). */
+    void endPath() {
+        if (m_pathCount == 0) return;
+        m_path[m_pathCount++] = { 1.0f, m_rect.x };
+    }
+
+    /**
+     * @brief Position X de la raquette à une fraction du pas, par interpolation linéaire de la trajectoire.
+     * @param fraction Instant en fraction du pas (0 = début, 1 = fin).
+     */
+    float xAt(float fraction) const {
+        if (m_pathCount < 2) return m_rect.x;
+        if (fraction <= m_path[0].fraction) return m_path[0].x;
+        for (int i = 1; i < m_pathCount; ++i) {
+            const PathPoint& a = m_path[i - 1];
+            const PathPoint& b = m_path[i];
+            if (fraction <= b.fraction) {
+                float span = b.fraction - a.fraction;
+                return span > 0.0f ? a.x + (b.x - a.x) * (fraction - a.fraction) / span : b.x;
+            }
+        }
+        return m_path[m_pathCount - 1].x;
+    }
+
+    /** @brief Met à jour la position de la raquette en fonction des entrées et des limites de la fenêtre. */
+    void update(const InputManager& input, float windowWidth) { followCursor(input.getMouseX(), windowWidth); }
+
+    /** @brief Centre la raquette sur une position X du curseur, dans les limites de la fenêtre. */
+    void followCursor(float cursorX, float windowWidth) { m_rect.x = clampedX(cursorX, windowWidth); }
+
+    /** @brief Enregistre le dessin de la raquette. */
+    void render(RenderQueue& queue) const { queue.rect(m_rect, m_color); }
+
+    /** @brief Obtient la coordonnée X de la raquette. */
+    float getX() const { return m_rect.x; } 
+    
+    /** @brief Obtient la coordonnée Y de la raquette. */
+    float getY() const { return m_rect.y; }
+    
+    /** @brief Obtient la largeur de la raquette. */
+    float getWidth() const { return m_rect.width; } 
+    
+    /** @breif Obtient la hauteur de la raquette. */
+    float getHeight() const { return m_rect.height; }
+    
+    /** @brief Obtient le rectangle de la raquette. */
+    const Rect& getRect() const { return m_rect; }
+    
+    /** @brief Définit la position de la raquette. */
+    void setPosition(float x, float y) { m_rect.x = x; m_rect.y = y; } 
+    
+    /** @brief Définit la couleur de la raquette. */
+    void setColor(const Config::Color& color) { m_color = color; }
+};
+
+/**
+* @class Ball
+* @brief Représente la balle du jeu.
+* @param m_pos Position actuelle du centre de la balle.
+* @param m_velocity Vitesse actuelle de la balle (déplacement par seconde).
+* @param m_preservedvelocity Vitesse de la balle conservée après la perte d'une vie, pour le prochain lancement.
+* @param m_nextCollisionPos Position du centre de la balle au moment de la prochaine collision anticipée.
+* @param m_hasPendingCollision Booléen indiquant si une collision avec une brique est anticipée.
+* @param m_radius Rayon de la balle.
+* @param m_color Couleur de la balle.
+* @param m_pendingCollisionNormal Normale de la surface de collision pour la prochaine collision anticipée.
+* @param m_pendingHitBrickIndex Index de la brique qui sera touchée lors de la prochaine collision anticipée.
+*/
+class Ball {
+    private:
+        Vec2 m_pos; 
+        Vec2 m_velocity;
+        Vec2 m_preservedvelocity;
+        Vec2 m_nextCollisionPos;
+        bool m_hasPendingCollision = false;
+        float m_radius; 
+        Config::Color m_color;
+        Vec2 m_pendingCollisionNormal; 
+        int m_pendingHitBrickIndex = -1; 
+    public:
+        Ball() : m_radius(Config::BALL_RADIUS), m_color(Config::COLOR_BALL) {}
+        
+        /** 
+         * @brief Initialise la position et la vitesse de la balle.
+         * @param startX Position X initiale.
+         * @param startY Position Y initiale.
+         * @param initialVelX Composante X de la vitesse initiale.
+         * @param initialVelY Composante Y de la vitesse initiale.
+         */
+        void init(float startX, float startY, float initialVelX, float initialVelY) { 
+            m_pos = {startX, startY}; 
+            m_velocity = {initialVelX, initialVelY}; 
+            clearPendingCollision(); // Reset collision state
+        }
+
+        /** 
+         * @brief Réinitialise la balle à une position et vitesse données.
+         * @param startX Position X de départ.
+         * @param startY Position Y de départ.
+         * @param initialVelX Composante X de la vitesse initiale.
+         * @param initialVelY Composante Y de la vitesse initiale.
+         */
+        void reset(float startX, float startY, float initialVelX, float initialVelY) { 
+            init(startX, startY, initialVelX, initialVelY); 
+        }
+    
+        /**
+         * @brief Met à jour la position de la balle et gère les collisions avec les murs et les briques (via le mécanisme de collision en attente).
+         * @param dt Delta-temps, temps écoulé depuis la dernière trame.
+         * @param windowHeight Hauteur de la fenêtre de jeu.
+         * @param gridMinX Coordonnée X minimale de la zone de jeu (bord gauche de la grille de briques).
+         * @param gridMaxX Coordonnée X maximale de la zone de jeu (bord droit de la grille de briques).
+         * @return L'index de la brique touchée si une collision en attente a été résolue, sinon -1.
+         */
+        int update(float dt, float windowHeight, float gridMinX, float gridMaxX) {
+            int brickHitThisFrame = -1;
+            Vec2 oldPos = m_pos;
+
+            m_pos.x += m_velocity.x * dt;
+            m_pos.y += m_velocity.y * dt;
+            
+            // Si une collision est en attente
+            if (m_hasPendingCollision) {
+                Vec2 travelVec = {m_pos.x - oldPos.x, m_pos.y - oldPos.y};
+                Vec2 targetVec = {m_nextCollisionPos.x - oldPos.x, m_nextCollisionPos.y - oldPos.y};
+                float travelLenSq = travelVec.x*travelVec.x + travelVec.y*travelVec.y;
+                float targetLenSq = targetVec.x*targetVec.x + targetVec.y*targetVec.y;
+
+                // Petite tolérance pour les comparaisons flottantes
+                float epsilonSq = 0.01f * 0.01f;
+                // Vérifie si la distance parcourue est suffisante pour atteindre ou dépasser le point de collision 
+                bool reachedTargetDistance = (travelLenSq >= targetLenSq - epsilonSq && targetLenSq > epsilonSq);
+                
+                Vec2 vecFromNewPosToCollisionPoint = {m_nextCollisionPos.x - m_pos.x, m_nextCollisionPos.y - m_pos.y};
+                float dotWithVelocity = vecFromNewPosToCollisionPoint.x * m_velocity.x + vecFromNewPosToCollisionPoint.y * m_velocity.y;
+                bool passedTargetPlane = (dotWithVelocity <= 0 && targetLenSq > epsilonSq);
+
+                if (reachedTargetDistance || passedTargetPlane) {
+                    m_pos = m_nextCollisionPos;
+
+                    brickHitThisFrame = m_pendingHitBrickIndex;
+                
+                    float dot_product = m_velocity.x * m_pendingCollisionNormal.x + m_velocity.y * m_pendingCollisionNormal.y;
+                    m_velocity.x -= 2 * dot_product * m_pendingCollisionNormal.x;
+                    m_velocity.y -= 2 * dot_product * m_pendingCollisionNormal.y;
+ 
+                    float safetyOffset = 0.01f;
+                    m_pos.x += m_pendingCollisionNormal.x * safetyOffset;
+                    m_pos.y += m_pendingCollisionNormal.y * safetyOffset;
+
+                    clearPendingCollision();
+                }
+            }
+        
+            if (m_pos.y + m_radius > windowHeight) {
+                m_pos.y = windowHeight - m_radius;
+                if (m_velocity.y > 0) {
+                    m_velocity.y *= -1.0f;
+                    clearPendingCollision();
+                }
+            }
+            if (m_pos.x - m_radius < gridMinX) {
+                m_pos.x = gridMinX + m_radius;
+                if (m_velocity.x < 0) {
+                    m_velocity.x *= -1.0f;
+                    clearPendingCollision();
+                }
+            } else if (m_pos.x + m_radius > gridMaxX) {
+                m_pos.x = gridMaxX - m_radius;
+                if (m_velocity.x > 0) {
+                    m_velocity.x *= -1.0f;
+                    clearPendingCollision();
+                }
+            }
+            return brickHitThisFrame;
+        }
+    
+        /**
+         * @brief Définit les informations pour la prochaine collision anticipée avec une brique.
+         * @param collisionPos Position du centre de la balle au moment de l'impact.
+         * @param normal Normale de la surface de la brique au point d'impact.
+         * @param brickIndex Index de la brique concernée par la collision.
+         */
+        void setNextCollision(const Vec2& collisionPos, const Vec2& normal, int brickIndex) {
+            m_nextCollisionPos = collisionPos;
+            m_pendingCollisionNormal = normal;
+            m_pendingHitBrickIndex = brickIndex;
+            m_hasPendingCollision = true;
+        }
+    
+        /**
+         * @brief Efface l'état de collision en attente.
+         */
+        void clearPendingCollision() {
+            m_hasPendingCollision = false;
+            m_pendingHitBrickIndex = -1;
+        }
+
+        /**
+         * @brief Vérifie et gère la collision entre la balle et la raquette.
+         * @param paddle La raquette avec laquelle vérifier la collision.
+         * @param dt Delta-temps, utilisé pour prédire la position de la balle.
+         * @param arenaWidth Largeur de la zone de jeu : la balle renvoyée va au moins à un quart de cette largeur par seconde.
+         * @return `true` si une collision avec la raquette s'est produite, `false` sinon.
+         * @note Test balayé : la raquette est un segment mobile dont la trajectoire pendant le pas est donnée par
+         *       `Paddle::xAt`. Quand la balle traverse le haut de la raquette, les positions de la balle et de la
+         *       raquette sont évaluées à l'instant du contact, ce qui corrige les rebonds manqués ou mal orientés
+         *       lors des mouvements rapides de la souris.
+         */
+        bool checkCollisionPaddle(const Paddle& paddle, float dt, float arenaWidth) {
+            const Rect& paddleRect = paddle.getRect();
+            float paddleTopY = paddleRect.y + paddleRect.height;
+            float paddleBottomY = paddleRect.y;
+
+            float ballCurrentBottomY = m_pos.y - m_radius;
+            float ballCurrentTopY = m_pos.y + m_radius;
+            // Prédit la position du bas de la balle après le dt actuel
+            float ballNextBottomY = (m_pos.y + m_velocity.y * dt) - m_radius;
+
+            bool isMovingDown = m_velocity.y < 0;
+            if (!isMovingDown) return false;
+
+            bool collisionDetected = false;
+            float hitBallX = m_pos.x;
+            float hitPaddleX = paddleRect.x;
+
+            // Cas 1: La balle était au-dessus ou au niveau du haut de la raquette et va la croiser ou la toucher dans cette trame
+            if (ballCurrentBottomY >= paddleTopY && ballNextBottomY < paddleTopY) {
+                float contactFraction = (ballCurrentBottomY - paddleTopY) / (ballCurrentBottomY - ballNextBottomY);
+                hitBallX = m_pos.x + m_velocity.x * dt * contactFraction;
+                hitPaddleX = paddle.xAt(contactFraction);
+                collisionDetected = (hitBallX + m_radius > hitPaddleX && hitBallX - m_radius < hitPaddleX + paddleRect.width);
+            }
+            // Cas 2: Le bas de la balle intersecte déjà l'épaisseur de la raquette par le haut (position finale de la raquette)
+            else if (ballCurrentBottomY < paddleTopY && ballCurrentBottomY >= paddleBottomY && ballCurrentTopY > paddleTopY) {
+                collisionDetected = (m_pos.x + m_radius > paddleRect.x && m_pos.x - m_radius < paddleRect.x + paddleRect.width);
+            }
+
+            if (collisionDetected) {
+                // Ajuste la position de la balle pour qu'elle soit juste au-dessus de la raquette
+                m_pos.y = paddleTopY + m_radius; 
+
+                float hitCenterOffset = hitBallX - (hitPaddleX + paddleRect.width / 2.0f);
+                float normalizedOffset = std::clamp(hitCenterOffset / (paddleRect.width / 2.0f), -1.0f, 1.0f);
+                float speed = std::sqrt(m_velocity.x * m_velocity.x + m_velocity.y * m_velocity.y);
+                
+                float minSpeed = arenaWidth / 4.0f;
+                if (speed < minSpeed) speed = minSpeed;
+                
+                float maxAngleRad = Config::PADDLE_MAX_BOUNCE_ANGLE_DEG * (M_PI / 180.0f);
+                float bounceAngle = normalizedOffset * maxAngleRad;
+                m_velocity.x = speed * std::sin(bounceAngle);
+                m_velocity.y = speed * std::cos(bounceAngle);
+                m_velocity.y = std::abs(m_velocity.y); // Ensure velocity is upwards
+                
+                clearPendingCollision(); // Paddle hit overrides any pending brick collision
+                return true;
+            }
+            return false;
+        }
+        
+    /** @brief Arrête la balle (vitesse nulle). */
+    void stop() { m_velocity.x = 0.0f; m_velocity.y = 0.0f; }
+    
+    /** @brief Enregistre le dessin de la balle. */
+    void render(RenderQueue& queue) const { queue.circle(m_pos.x, m_pos.y, m_radius, 20, m_color); }
+    
+    /** @brief Obtient la coordonnée X de la balle. */
+    float getX() const { return m_pos.x; } 
+    
+    /** @brief Obtient la coordonnée Y de la balle. */
+    float getY() const { return m_pos.y; }
+    
+    /** @brief Obtient la position de la balle. */
+    const Vec2& getPosition() const { return m_pos; } 
+    
+    /** @brief Obtient le rayon de la balle. */
+    float getRadius() const { return m_radius; }
+    
+    /** @brief Obtient la composante X de la vitesse de la balle. */
+    float getDx() const { return m_velocity.x; } 
+    
+    /** @brief Obtient la composante Y de la vitesse de la balle. */
+    float getDy() const { return m_velocity.y; }
+    
+    /** @brief Obtient le vecteur vitesse de la balle. */
+    const Vec2& getVelocity() const { return m_velocity; } 
+    
+    /** @brief Obtient le vecteur vitesse sauvegardé de la balle (utilisé après une perte de vie). */
+    const Vec2& getPreservedVelocity() const { return m_preservedvelocity; }
+    
+    /** @brief Définit la vitesse sauvegardée de la balle. */
+    void setPreservedVelocity(float dx, float dy) { m_preservedvelocity.x = dx; m_preservedvelocity.y = dy; }
+    
+    /** @brief Vérifie si la balle est en mouvement. */
+    bool isMoving() const { return m_velocity.x != 0.0f || m_velocity.y != 0.0f; }
+    
+    /** @brief Définit la position de la balle. */
+    void setPosition(float x, float y) { m_pos.x = x; m_pos.y = y; } 
+    
+    /** @brief Définit la vitesse de la balle. */
+    void setVelocity(float dx, float dy) { m_velocity.x = dx; m_velocity.y = dy; }
+    
+    /** @brief Définit le rayon de la balle. */
+    void setRadius(float r) { m_radius = r; } 
+    
+    /** @brief Définit la couleur de la balle. */
+    void setColor(const Config::Color& color) { m_color = color; }
+};
+
+/**
+ * @struct BallSweep
+ * @brief Test balayé d'une balle contre des rectangles (`Level::checkCollisions`) : le centre parcourt la vitesse de la balle (une seconde de trajet) contre chaque rectangle élargi du rayon.
+ * @note Les inverses de la vitesse sont calculés une fois par balle et non une fois par rectangle.
+ */
+struct BallSweep {
+    Vec2 position;
+    Vec2 velocity;
+    float radius;
+    Vec2 inverse;
+    bool movesX;
+    bool movesY;
+
+    explicit BallSweep(const Ball& ball)
+        : position(ball.getPosition()), velocity(ball.getVelocity()), radius(ball.getRadius()),
+          movesX(std::abs(velocity.x) > 0.0001f), movesY(std::abs(velocity.y) > 0.0001f) {
+        inverse = { movesX ? 1.0f / velocity.x : 0.0f, movesY ? 1.0f / velocity.y : 0.0f };
+    }
+
+    /**
+     * @brief Teste la trajectoire contre un rectangle.
+     * @param closestTime Instant (en fraction de la trajectoire) du plus proche impact trouvé, mis à jour si celui-ci est plus proche.
+     * @param normal Normale de la face touchée, mise à jour avec `closestTime`.
+     * @return `true` si l'impact est plus proche que `closestTime`.
+     */
+    bool test(const Rect& rect, float& closestTime, Vec2& normal) const {
+        float left = rect.x - radius;
+        float right = rect.x + rect.width + radius;
+        float bottom = rect.y - radius;
+        float top = rect.y + rect.height + radius;
+
+        float txMin = 0.0f, txMax = 1.0f;
+        if (movesX) {
+            txMin = (left - position.x) * inverse.x;
+            txMax = (right - position.x) * inverse.x;
+            if (txMin > txMax) std::swap(txMin, txMax);
+        } else if (position.x < left || position.x > right) {
+            return false;
+        }
+
+        float tyMin = 0.0f, tyMax = 1.0f;
+        if (movesY) {
+            tyMin = (bottom - position.y) * inverse.y;
+            tyMax = (top - position.y) * inverse.y;
+            if (tyMin > tyMax) std::swap(tyMin, tyMax);
+        } else if (position.y < bottom || position.y > top) {
+            return false;
+        }
+
+        float tMin = std::max(txMin, tyMin);
+        float tMax = std::min(txMax, tyMax);
+        if (tMin > tMax || tMax < 0.0f || tMin > 1.0f || tMin >= closestTime) return false;
+
+        closestTime = tMin;
+        if (txMin > tyMin) normal = {(velocity.x > 0.0f) ? -1.0f : 1.0f, 0.0f};
+        else normal = {0.0f, (velocity.y > 0.0f) ? -1.0f : 1.0f};
+        return true;
+    }
+
+    /** @brief Position du centre à l'instant `time` de la trajectoire. */
+    Vec2 pointAt(float time) const { return { position.x + velocity.x * time, position.y + velocity.y * time }; }
+};
+
+/**
+* @struct SpeedBoosts
+* @brief Accélérations de la balle au cours d'une partie (chacune multiplie sa vitesse par 1.19, une seule fois) :
+*        première brique orange, première brique rouge, 4e et 12e briques touchées.
+* @param bricksHit Compteur de briques touchées dans la partie en cours.
+* @param firstOrangeHit Indicateur si la première brique orange a été touchée.
+* @param firstRedHit Indicateur si la première brique rouge a été touchée.
+* @param fourthHitDone Indicateur si le bonus de vitesse pour la 4ème brique a été appliqué.
+* @param twelfthHitDone Indicateur si le bonus de vitesse pour la 12ème brique a été appliqué.
+*/
+struct SpeedBoosts {
+    int bricksHit = 0;
+    bool firstOrangeHit = false;
+    bool firstRedHit = false;
+    bool fourthHitDone = false;
+    bool twelfthHitDone = false;
+
+    /**
+     * @brief Compte une brique détruite et applique à la balle les accélérations qu'elle déclenche.
+     * @param ball Balle à accélérer.
+     * @param score Valeur de score de la brique touchée.
+     */
+    void onBrickHit(Ball& ball, int score) {
+        bricksHit++;
+        float speedMultiplier = 1.0f;
+        if (score == Config::SCORE_ORANGE && !firstOrangeHit) {
+            speedMultiplier *= 1.19f; firstOrangeHit = true;
+        }
+        if (score == Config::SCORE_RED && !firstRedHit) {
+            speedMultiplier *= 1.19f; firstRedHit = true;
+        }
+        if (bricksHit == 4 && !fourthHitDone) {
+            speedMultiplier *= 1.19f; fourthHitDone = true;
+        }
+        if (bricksHit == 12 && !twelfthHitDone) {
+            speedMultiplier *= 1.19f; twelfthHitDone = true;
+        }
+        if (speedMultiplier > 1.001f) {
+            Vec2 currentVel = ball.getVelocity();
+            ball.setVelocity(currentVel.x * speedMultiplier, currentVel.y * speedMultiplier);
+        }
+    }
+};
+
+/**
+* @class Brick
+* @brief Représente une brique individuelle dans le jeu.
+* @param m_rect Rectangle définissant la position et la taille de la brique.
+* @param m_color Couleur de la brique, déterminée par sa valeur de score.
+* @param m_active Indicateur booléen de l'état actif de la brique (visible et destructible).
+* @param m_scoreValue Valeur du score de la brique. Peut être `Config::SCORE_INDESTRUCTIBLE`.
+*/
+class Brick {
+private:
+    Rect m_rect;
+    Config::Color m_color;
+    bool m_active;
+    int m_scoreValue;
+
+    /** @brief Met à jour la couleur de la brique en fonction de son état actif et de sa valeur de score. */
+    void updateColor() {
+        m_color = (m_active) ? Config::getBrickColorByScore(m_scoreValue) : Config::COLOR_BRICK_EMPTY;
+    }
+
+public:
+    Brick() : m_active(false), m_scoreValue(0) {
+        m_rect.width = Config::BRICK_WIDTH;
+        m_rect.height = Config::BRICK_HEIGHT;
+        updateColor();
+    }
+
+    /**
+     * @brief Initialise une brique avec une position, une taille et une valeur de score.
+     * @param x Position X du coin supérieur gauche de la brique.
+     * @param y Position Y du coin supérieur gauche de la brique.
+     * @param width Largeur de la brique.
+     * @param height Hauteur de la brique.
+     * @param scoreValue Valeur du score de la brique. Si 0, la brique est inactive (vide).
+     */
+    void init(float x, float y, float width, float height, int scoreValue) {
+        m_rect = { x, y, width, height };
+        m_scoreValue = scoreValue;
+        m_active = (m_scoreValue != 0);
+        updateColor();
+    }
+
+    /**
+     * @brief Gère la collision avec la brique. La désactive si elle n'est pas indestructible.
+     * @return Le score obtenu en touchant la brique. Retourne 0 si la brique est indestructible ou déjà inactive.
+     */
+    int hit() {
+        if (!m_active) return 0;
+
+        if (m_scoreValue == Config::SCORE_INDESTRUCTIBLE) {
+            return 0;
+        }
+
+        int scoreAwarded = m_scoreValue;
+        m_active = false;
+        m_scoreValue = 0;
+        updateColor();
+        return scoreAwarded;
+    }
+
+    /** @brief Vérifie si la brique est active. */
+    bool isActive() const { return m_active; }
+    
+    /** @brief Vérifie si la brique est indestructible. */
+    bool isIndestructible() const { return m_scoreValue == Config::SCORE_INDESTRUCTIBLE; }
+   
+    /** @brief Obtient le rectangle de la brique. */
+    const Rect& getRect() const { return m_rect; }
+    
+    /** @brief Obtient la coordonnée X de la brique. */
+    float getX() const { return m_rect.x; }
+    
+    /** @brief Obtient la coordonnée Y de la brique. */
+    float getY() const { return m_rect.y; }
+    
+    /** @brief Obtient la largeur de la brique. */
+    float getWidth() const { return m_rect.width; }
+    
+    /** @brief Obtient la hauteur de la brique. */
+    float getHeight() const { return m_rect.height; }
+    
+    /** @brief Obtient la valeur du score de la brique. */
+    int getScoreValue() const { return m_scoreValue; }
+
+    /**
+     * @brief Définit l'état actif de la brique et son type (normal/indestructible).
+     * @param active `true` pour activer la brique, `false` pour la désactiver.
+     * @param indestructible `true` si la brique activée doit être indestructible.
+     */
+    void setActive(bool active, bool indestructible = false) {
+         if (active && !m_active) {
+             m_scoreValue = indestructible ? Config::SCORE_INDESTRUCTIBLE : 0;
+             m_active = (m_scoreValue != 0);
+         } else if (!active && m_active) {
+             m_scoreValue = 0;
+             m_active = false;
+         }
+         updateColor();
+    }
+
+    /**
+     * @brief Définit la valeur de score de la brique. Met à jour son état actif et sa couleur.
+     * @param score La nouvelle valeur de score. Doit être une des valeurs prédéfinies dans `Config` ou 0.
+     */
+    void setScoreValue(int score) {
+         bool validScore = false;
+         if (score == 0 || score == Config::SCORE_INDESTRUCTIBLE) validScore = true;
+         else if (score == Config::SCORE_YELLOW || score == Config::SCORE_GREEN ||
+                  score == Config::SCORE_ORANGE || score == Config::SCORE_RED) {
+             validScore = true;
+         }
+
+         if (validScore) {
+             m_scoreValue = score;
+             m_active = (m_scoreValue != 0);
+             updateColor();
+         } else {
+             std::cerr << "Warning: Attempted to set invalid score value: " << score << std::endl;
+         }
+    }
+};
+
+/**
+ * @struct GridLayout
+ * @brief Position et dimensions de la grille de briques à l'écran.
+ * @param startX Position X du coin inférieur gauche de la grille.
+ * @param startY Position Y du coin inférieur gauche de la grille.
+ * @param totalWidth Largeur totale de la grille (avec espacements).
+ * @param totalHeight Hauteur totale de la grille (avec espacements).
+ * @param cellWidth Largeur d'une cellule.
+ * @param cellHeight Hauteur d'une cellule.
+ * @param spacing Espacement entre deux cellules.
+ * @param view Zone de l'écran où la grille est visible : les cellules en dehors ne sont pas dessinées, celles à cheval sont découpées.
+ */
+struct GridLayout {
+    float startX = 0.0f, startY = 0.0f; float totalWidth = 0.0f, totalHeight = 0.0f;
+    float cellWidth = Config::BRICK_WIDTH, cellHeight = Config::BRICK_HEIGHT, spacing = Config::BRICK_SPACING;
+    Rect view = { 0.0f, 0.0f, static_cast<float>(Config::DEFAULT_WINDOW_WIDTH), static_cast<float>(Config::DEFAULT_WINDOW_HEIGHT) };
+};
+
+/**
+ * @struct BrickField
+ * @brief Copie immuable des valeurs de score de la grille, partagée entre les états publiés par la simulation.
+ * @param rows Nombre de rangées (rangée logique 0 en haut).
+ * @param cols Nombre de colonnes.
+ * @param cells Valeurs de score, rangée par rangée (0 pour une cellule vide ou une brique détruite).
+ * @param version Version du niveau au moment de la copie (voir `Level::getVersion`).
+ * @param baseVersion Version de la grille publiée précédemment, à laquelle `changedCells` s'applique.
+ * @param changedCells Index des cellules modifiées depuis `baseVersion` (vide si `fullChange`).
+ * @param fullChange Indique que la grille a changé dans son ensemble (chargement, nouvelle partie, changement de vue).
+ */
+struct BrickField {
+    int rows = 0;
+    int cols = 0;
+    std::vector<int8_t> cells;
+    uint64_t version = 0;
+    uint64_t baseVersion = 0;
+    std::vector<int> changedCells;
+    bool fullChange = true;
+
+    /** @brief Obtient la valeur de score d'une cellule. */
+    int at(int row, int col) const { return cells[static_cast<size_t>(row) * cols + col]; }
+};
+
+/**
+ * @struct HitHeatmap
+ * @brief Touches par cellule accumulées sur des parties simulées de la grille de l'éditeur (`HeatmapSampler`),
+ *        copie immuable partagée entre les états publiés.
+ * @param rows Nombre de rangées.
+ * @param cols Nombre de colonnes.
+ * @param version Version du niveau simulée (voir `Level::getVersion`).
+ * @param games Nombre de parties terminées.
+ * @param hits Nombre total de touches de chaque cellule.
+ * @param hitGames Nombre de parties où la cellule a été touchée au moins une fois.
+ * @param firstHitSeconds Somme, sur ces parties, des délais avant la première touche de la cellule.
+ * @param maxIndestructibleHits Maximum de `hits` des briques indestructibles (les autres sont touchées au plus une fois par partie).
+ * @param maxFirstHitSeconds Maximum des délais moyens avant la première touche.
+ * @param neverHit Nombre de briques (destructibles ou non) jamais touchées.
+ */
+struct HitHeatmap {
+    int rows = 0;
+    int cols = 0;
+    uint64_t version = 0;
+    int games = 0;
+    std::vector<uint32_t> hits;
+    std::vector<uint32_t> hitGames;
+    std::vector<float> firstHitSeconds;
+    uint32_t maxIndestructibleHits = 0;
+    float maxFirstHitSeconds = 0.0f;
+    int neverHit = 0;
+
+    /** @brief Délai moyen avant la première touche d'une cellule, sur les parties où elle a été touchée (-1 si jamais). */
+    float averageFirstHit(size_t index) const { return hitGames[index] ? firstHitSeconds[index] / hitGames[index] : -1.0f; }
+};
+
+/**
+ * @brief Identifiant d'une entité de `EntityWorld` : index sur 24 bits et génération sur 8 bits. Un identifiant conservé
+ *        après la destruction de son entité ne désigne pas l'entité qui réutilise ensuite son index.
+ * @note La génération revient à 0 après 256 destructions d'un même index : un identifiant conservé pendant 256 réutilisations
+ *       de son index désigne de nouveau une entité vivante. Les identifiants ne doivent donc pas être gardés longtemps.
+ */
+using Entity = uint32_t;
+constexpr uint32_t ENTITY_INDEX_BITS = 24;
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr Entity NO_ENTITY = UINT32_MAX;
+
+/** @brief Index d'une entité (position dans les tableaux clairsemés des `ComponentPool`). */
+constexpr uint32_t entityIndex(Entity entity) { return entity & ENTITY_INDEX_MASK; }
+
+/**
+ * @class ComponentPool
+ * @brief Stockage d'un type de composant en ensemble clairsemé : les composants sont contigus (tableau dense, sans trou) et
+ *        `m_sparse` donne la position dense de chaque index d'entité. Ajout, recherche et suppression sont en O(1).
+ * @tparam T Type du composant.
+ * @param m_sparse Position dense de chaque index d'entité (`ABSENT` si l'entité n'a pas ce composant).
+ * @param m_entities Entité de chaque composant, dans l'ordre dense.
+ * @param m_components Composants, dans l'ordre dense.
+ * @note La suppression déplace le dernier composant à la place du composant supprimé : l'ordre dense n'est pas stable.
+ */
+template <typename T>
+class ComponentPool {
+private:
+    static constexpr uint32_t ABSENT = UINT32_MAX;
+    std::vector<uint32_t> m_sparse;
+    std::vector<Entity> m_entities;
+    std::vector<T> m_components;
+
+    /** @brief Position dense du composant d'une entité, `ABSENT` si elle n'en a pas. */
+    uint32_t slot(Entity entity) const {
+        uint32_t index = entityIndex(entity);
+        if (index >= m_sparse.size()) return ABSENT;
+        uint32_t dense = m_sparse[index];
+        return (dense != ABSENT && m_entities[dense] == entity) ? dense : ABSENT;
+    }
+
+public:
+    /** @brief Ajoute (ou remplace) le composant d'une entité. */
+    T& add(Entity entity, const T& component) {
+        uint32_t index = entityIndex(entity);
+        if (index >= m_sparse.size()) m_sparse.resize(index + 1, ABSENT);
+        uint32_t& dense = m_sparse[index];
+        if (dense != ABSENT) { m_entities[dense] = entity; return m_components[dense] = component; }
+        dense = static_cast<uint32_t>(m_components.size());
+        m_entities.push_back(entity);
+        m_components.push_back(component);
+        return m_components.back();
+    }
+
+    /** @brief Indique si une entité a ce composant. */
+    bool has(Entity entity) const { return slot(entity) != ABSENT; }
+
+    /** @brief Obtient le composant d'une entité (`nullptr` si elle n'en a pas). */
+    T* find(Entity entity) { uint32_t dense = slot(entity); return dense != ABSENT ? &m_components[dense] : nullptr; }
+    const T* find(Entity entity) const { uint32_t dense = slot(entity); return dense != ABSENT ? &m_components[dense] : nullptr; }
+
+    /** @brief Retire le composant d'une entité (sans effet si elle n'en a pas). */
+    void remove(Entity entity) {
+        uint32_t dense = slot(entity);
+        if (dense == ABSENT) return;
+        uint32_t last = static_cast<uint32_t>(m_components.size() - 1);
+        if (dense != last) {
+            m_components[dense] = std::move(m_components[last]);
+            m_entities[dense] = m_entities[last];
+            m_sparse[entityIndex(m_entities[dense])] = dense;
+        }
+        m_components.pop_back();
+        m_entities.pop_back();
+        m_sparse[entityIndex(entity)] = ABSENT;
+    }
+
+    /** @brief Retire tous les composants (la capacité est conservée). */
+    void clear() {
+        for (Entity entity : m_entities) m_sparse[entityIndex(entity)] = ABSENT;
+        m_entities.clear();
+        m_components.clear();
+    }
+
+    /** @brief Nombre de composants. */
+    size_t size() const { return m_components.size(); }
+
+    /** @brief Entité du i-ème composant (ordre dense). */
+    Entity entityAt(size_t i) const { return m_entities[i]; }
+
+    /** @brief i-ème composant (ordre dense). */
+    T& at(size_t i) { return m_components[i]; }
+    const T& at(size_t i) const { return m_components[i]; }
+};
+
+/**
+ * @brief Composants des entités de `EntityWorld`.
+ * @note `Bounds` : rectangle à l'écran (éclats). `Motion` : vitesse et accélération d'un `Bounds`. `Sprite` : couleur d'un
+ *       `Bounds` dessiné. `Lifetime` : durée de vie restante et initiale (l'entité est détruite à expiration).
+ */
+struct Bounds { Rect rect; };
+struct Motion { Vec2 velocity; Vec2 acceleration; };
+struct Sprite { Config::Color color = {1.0f, 1.0f, 1.0f}; };
+struct Lifetime { float remaining = 0.0f; float total = 0.0f; };
+
+/**
+ * @struct EntityWorld
+ * @brief Magasin d'entités et de leurs composants, un `ComponentPool` par type : les systèmes (`EntitySystems`) parcourent
+ *        chaque type de composant par lots contigus.
+ * @param generations Génération courante de chaque index d'entité (incrémentée à la destruction et par `clear`).
+ * @param freeIndices Index d'entités détruites, réutilisés par `create`.
+ * @param alive Nombre d'entités vivantes.
+ * @note Au plus 2^24 entités vivantes. Copier le monde (publication d'un état) réutilise la capacité des tableaux de la copie.
+ */
+struct EntityWorld {
+    ComponentPool<Bounds> bounds;
+    ComponentPool<Motion> motions;
+    ComponentPool<Sprite> sprites;
+    ComponentPool<Lifetime> lifetimes;
+    std::vector<uint8_t> generations;
+    std::vector<uint32_t> freeIndices;
+    size_t alive = 0;
+
+    /** @brief Crée une entité sans composant. */
+    Entity create() {
+        uint32_t index;
+        if (!freeIndices.empty()) { index = freeIndices.back(); freeIndices.pop_back(); }
+        else { index = static_cast<uint32_t>(generations.size()); generations.push_back(0); }
+        ++alive;
+        return index | (static_cast<uint32_t>(generations[index]) << ENTITY_INDEX_BITS);
+    }
+
+    /** @brief Indique si une entité n'a pas été détruite. */
+    bool isAlive(Entity entity) const {
+        uint32_t index = entityIndex(entity);
+        return entity != NO_ENTITY && index < generations.size() && generations[index] == (entity >> ENTITY_INDEX_BITS);
+    }
+
+    /** @brief Détruit une entité et retire tous ses composants. */
+    void destroy(Entity entity) {
+        if (!isAlive(entity)) return;
+        bounds.remove(entity); motions.remove(entity); sprites.remove(entity); lifetimes.remove(entity);
+        uint32_t index = entityIndex(entity);
+        ++generations[index];
+        freeIndices.push_back(index);
+        --alive;
+    }
+
+    /**
+     * @brief Détruit toutes les entités (la capacité est conservée).
+     * @note Les générations sont conservées et incrémentées : un identifiant obtenu avant `clear` ne désigne pas l'entité
+     *       qui réutilise ensuite son index.
+     */
+    void clear() {
+        bounds.clear(); motions.clear(); sprites.clear(); lifetimes.clear();
+        freeIndices.clear();
+        // Ordre décroissant : `create` réutilise d'abord les petits index
+        for (size_t index = generations.size(); index-- > 0;) {
+            ++generations[index];
+            freeIndices.push_back(static_cast<uint32_t>(index));
+        }
+        alive = 0;
+    }
+};
+
+/**
+ * @class EntitySystems
+ * @brief Systèmes de `EntityWorld`, chacun parcourant un type de composant par lot : déplacement, expiration et rendu.
+ * @note Seuls les éclats des briques détruites sont des entités : la raquette, la balle et les briques restent les objets
+ *       `Paddle`, `Ball` et `Level` partagés par l'éditeur, l'historique, les parties simulées et l'état publié.
+ */
+class EntitySystems {
+public:
+
+    /** @brief Déplace les `Bounds` animés par un `Motion` (accélération puis vitesse). */
+    static void move(EntityWorld& world, float dt) {
+        for (size_t i = 0; i < world.motions.size(); ++i) {
+            Bounds* bounds = world.bounds.find(world.motions.entityAt(i));
+            if (!bounds) continue;
+            Motion& motion = world.motions.at(i);
+            motion.velocity.x += motion.acceleration.x * dt;
+            motion.velocity.y += motion.acceleration.y * dt;
+            bounds->rect.x += motion.velocity.x * dt;
+            bounds->rect.y += motion.velocity.y * dt;
+        }
+    }
+
+    /** @brief Décompte les durées de vie et détruit les entités expirées. */
+    static void expire(EntityWorld& world, float dt) {
+        // Parcours à rebours : la destruction remplace l'élément courant par le dernier, déjà traité
+        for (size_t i = world.lifetimes.size(); i-- > 0;) {
+            Lifetime& lifetime = world.lifetimes.at(i);
+            lifetime.remaining -= dt;
+            if (lifetime.remaining <= 0.0f) world.destroy(world.lifetimes.entityAt(i));
+        }
+    }
+
+    /** @brief Crée les éclats d'une brique détruite : `Config::DEBRIS_PER_BRICK` carrés projetés vers le haut, qui retombent. */
+    static void spawnDebris(EntityWorld& world, const Rect& rect, Config::Color color, std::mt19937& rng) {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const float size = Config::DEBRIS_SIZE;
+        for (int i = 0; i < Config::DEBRIS_PER_BRICK; ++i) {
+            Entity debris = world.create();
+            Rect square = { rect.x + unit(rng) * (rect.width - size), rect.y + unit(rng) * (rect.height - size), size, size };
+            Vec2 velocity = { (unit(rng) * 2.0f - 1.0f) * Config::DEBRIS_SPEED, unit(rng) * Config::DEBRIS_SPEED };
+            world.bounds.add(debris, { square });
+            world.motions.add(debris, { velocity, { 0.0f, -Config::DEBRIS_GRAVITY } });
+            world.sprites.add(debris, { color });
+            world.lifetimes.add(debris, { Config::DEBRIS_LIFETIME, Config::DEBRIS_LIFETIME });
+        }
+    }
+
+    /** @brief Enregistre le dessin des rectangles colorés (réduits en fin de vie). */
+    static void render(const EntityWorld& world, RenderQueue& queue) {
+        for (size_t i = 0; i < world.sprites.size(); ++i) {
+            Entity entity = world.sprites.entityAt(i);
+            const Bounds* bounds = world.bounds.find(entity);
+            if (!bounds) continue;
+            Rect rect = bounds->rect;
+            if (const Lifetime* lifetime = world.lifetimes.find(entity)) {
+                float scale = lifetime->total > 0.0f ? std::max(0.0f, lifetime->remaining / lifetime->total) : 1.0f;
+                rect = { rect.x + rect.width * (1.0f - scale) / 2.0f, rect.y + rect.height * (1.0f - scale) / 2.0f, rect.width * scale, rect.height * scale };
+            }
+            queue.rect(rect, world.sprites.at(i).color);
+        }
+    }
+};
+
+/**
+ * @class MappedFile
+ * @brief Projection en lecture seule d'un fichier en mémoire (`mmap`), libérée à la destruction.
+ * @param m_data Début de la projection (`nullptr` si aucun fichier n'est ouvert ou si le fichier est vide).
+ * @param m_size Taille du fichier en octets.
+ * @note Aucune copie ni lecture n'a lieu à l'ouverture : les pages sont chargées par le noyau au premier accès.
+ */
+class MappedFile {
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    /**
+     * @brief Projette un fichier en mémoire.
+     * @param filename Chemin du fichier.
+     * @return `true` si le fichier a pu être ouvert et projeté, `false` s'il n'existe pas ou n'est pas lisible.
+     */
+    bool open(const std::string& filename) {
+        close();
+        int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) { ::close(fd); return false; }
+        size_t size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) { ::close(fd); return false; }
+            m_data = static_cast<const uint8_t*>(mapping);
+        }
+        m_size = size;
+        ::close(fd);
+        return true;
+    }
+
+    /** @brief Libère la projection. */
+    void close() {
+        if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    /** @brief Obtient le début du fichier projeté. */
+    const uint8_t* data() const { return m_data; }
+
+    /** @brief Obtient la taille du fichier en octets. */
+    size_t size() const { return m_size; }
+};
+
+/**
+ * @class AtomicFileWriter
+ * @brief Écriture d'un fichier qui remplace atomiquement l'existant : les données vont dans un fichier temporaire
+ *        voisin, synchronisé sur le disque puis renommé à la place de la destination par `commit`.
+ * @param m_filename Fichier de destination.
+ * @param m_tempFilename Fichier temporaire (`m_filename` suivi de `.tmp`), dans le même répertoire pour que `rename` soit atomique.
+ * @param m_fd Descripteur du fichier temporaire, -1 si aucun fichier n'est ouvert.
+ * @param m_failed Indique qu'une écriture a échoué (le `commit` échouera).
+ * @note Un plantage pendant l'écriture laisse la destination intacte. Sans `commit`, le fichier temporaire est supprimé à la destruction.
+ */
+class AtomicFileWriter {
+private:
+    std::string m_filename;
+    std::string m_tempFilename;
+    int m_fd = -1;
+    bool m_failed = false;
+
+public:
+    AtomicFileWriter() = default;
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+    ~AtomicFileWriter() { abort(); }
+
+    /**
+     * @brief Crée le fichier temporaire.
+     * @param filename Fichier de destination.
+     * @return `true` si le fichier temporaire a pu être créé.
+     */
+    bool open(const std::string& filename) {
+        abort();
+        m_filename = filename;
+        m_tempFilename = filename + ".tmp";
+        m_failed = false;
+        m_fd = ::open(m_tempFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        return m_fd >= 0;
+    }
+
+    /** @brief Ajoute des octets au fichier temporaire (les écritures partielles sont reprises). */
+    void write(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0 && !m_failed && m_fd >= 0) {
+            ssize_t written = ::write(m_fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                m_failed = true;
+                break;
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    /**
+     * @brief Synchronise le fichier temporaire, le renomme à la place de la destination puis synchronise le répertoire.
+     * @return `true` si la destination contient désormais les données écrites.
+     */
+    bool commit() {
+        if (m_fd < 0) return false;
+        bool success = !m_failed && fsync(m_fd) == 0;
+        success = (::close(m_fd) == 0) && success;
+        m_fd = -1;
+        if (!success || std::rename(m_tempFilename.c_str(), m_filename.c_str()) != 0) {
+            std::remove(m_tempFilename.c_str());
+            return false;
+        }
+        size_t slash = m_filename.find_last_of('/');
+        std::string directory = (slash == std::string::npos) ? "." : (slash == 0 ? "/" : m_filename.substr(0, slash));
+        int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) { fsync(dirFd); ::close(dirFd); } // Rend le renommage durable
+        return true;
+    }
+
+    /** @brief Abandonne l'écriture en cours et supprime le fichier temporaire. */
+    void abort() {
+        if (m_fd < 0) return;
+        ::close(m_fd);
+        m_fd = -1;
+        std::remove(m_tempFilename.c_str());
+    }
+};
+
+/**
+ * @class LevelFile
+ * @brief Format binaire versionné des niveaux : un en-tête de taille fixe suivi des cellules, un octet signé par cellule.
+ * @note Disposition (petit-boutiste) : magic "BRKL", version, taille de l'en-tête, rangées, colonnes, somme de contrôle,
+ *       puis `rangées * colonnes` valeurs de score rangée par rangée (rangée logique 0 en haut).
+ *       Les cellules commencent à `headerSize`, ce qui permet aux versions suivantes d'étendre l'en-tête.
+ */
+class LevelFile {
+public:
+    /** @brief En-tête du fichier, lu et écrit tel quel. */
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t rows;
+        uint32_t cols;
+        uint64_t checksum;
+        uint64_t reserved;
+    };
+    static_assert(sizeof(Header) == 32, "LevelFile::Header must stay 32 bytes");
+
+    static constexpr char MAGIC[4] = { 'B', 'R', 'K', 'L' };
+    static constexpr uint16_t VERSION = 1;
+
+    /**
+     * @brief Somme de contrôle des cellules (FNV-1a appliqué à des mots de 64 bits).
+     * @param data Octets à contrôler.
+     * @param size Nombre d'octets.
+     * @note Traiter 8 octets par multiplication garde la vérification d'une grille de 16 Mo sous quelques millisecondes.
+     */
+    static uint64_t checksum(const uint8_t* data, size_t size) {
+        constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+        uint64_t hash = FNV_OFFSET;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash = (hash ^ word) * FNV_PRIME;
+        }
+        for (; i < size; ++i) hash = (hash ^ data[i]) * FNV_PRIME;
+        return hash ^ (hash >> 32);
+    }
+
+    /**
+     * @brief Vérifie qu'une suite de cellules ne contient que des valeurs de score valides.
+     * @note Passe sans branche à travers une table de 256 entrées : les valeurs aléatoires d'une grande grille
+     *       ne provoquent pas d'erreurs de prédiction.
+     */
+    static bool allScoresValid(const int8_t* cells, size_t count) {
+        static constexpr std::array<uint8_t, 256> INVALID = [] {
+            std::array<uint8_t, 256> table{};
+            for (int i = 0; i < 256; ++i) table[i] = Config::isValidScore(static_cast<int8_t>(i)) ? 0 : 1;
+            return table;
+        }();
+        uint8_t invalid = 0;
+        for (size_t i = 0; i < count; ++i) invalid |= INVALID[static_cast<uint8_t>(cells[i])];
+        return invalid == 0;
+    }
+
+    /** @brief Vérifie qu'un bloc d'octets commence par le magic du format binaire. */
+    static bool hasMagic(const uint8_t* data, size_t size) {
+        return data && size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    /**
+     * @brief Lit et valide l'en-tête d'un fichier de niveau en mémoire.
+     * @param data Début du fichier.
+     * @param size Taille du fichier.
+     * @param out En-tête lu.
+     * @param error Raison de l'échec, le cas échéant.
+     * @return `true` si l'en-tête est cohérent avec la taille du fichier. La somme de contrôle n'est pas vérifiée ici.
+     */
+    static bool readHeader(const uint8_t* data, size_t size, Header& out, std::string& error) {
+        if (size < sizeof(Header) || !hasMagic(data, size)) { error = "not a binary level file"; return false; }
+        std::memcpy(&out, data, sizeof(Header));
+        if (out.version == 0 || out.version > VERSION) { error = "unsupported version " + std::to_string(out.version); return false; }
+        if (out.headerSize < sizeof(Header) || out.headerSize > size) { error = "invalid header size"; return false; }
+        if (out.rows == 0 || out.cols == 0 || out.rows > static_cast<uint32_t>(Config::LEVEL_MAX_DIMENSION) ||
+            out.cols > static_cast<uint32_t>(Config::LEVEL_MAX_DIMENSION)) {
+            error = "invalid dimensions " + std::to_string(out.rows) + "x" + std::to_string(out.cols);
+            return false;
+        }
+        if (size - out.headerSize != static_cast<size_t>(out.rows) * out.cols) { error = "truncated or oversized cell data"; return false; }
+        return true;
+    }
+
+    /**
+     * @brief Écrit un niveau au format binaire.
+     * @param filename Fichier de destination, remplacé atomiquement s'il existe (`AtomicFileWriter`).
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score, rangée par rangée.
+     * @param checksumOut Reçoit la somme de contrôle écrite dans l'en-tête, si non nul.
+     * @return `true` si l'écriture a réussi.
+     */
+    static bool write(const std::string& filename, int rows, int cols, const int8_t* cells, uint64_t* checksumOut = nullptr) {
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.headerSize = sizeof(Header);
+        header.rows = static_cast<uint32_t>(rows);
+        header.cols = static_cast<uint32_t>(cols);
+        header.checksum = checksum(reinterpret_cast<const uint8_t*>(cells), cellCount);
+        if (checksumOut) *checksumOut = header.checksum;
+        AtomicFileWriter file;
+        if (!file.open(filename)) return false;
+        file.write(&header, sizeof(header));
+        file.write(cells, cellCount);
+        return file.commit();
+    }
+};
+
+/**
+ * @class LevelTextParser
+ * @brief Analyseur du format texte des niveaux (une ligne par rangée, valeurs de score séparées par des espaces),
+ *        en un seul passage sur un tampon en mémoire avec `std::from_chars`.
+ * @note Les dimensions sont libres : la première rangée non vide fixe le nombre de colonnes. Chaque anomalie
+ *       (caractère inattendu, score invalide, rangée trop courte ou trop longue, rangées au-delà de
+ *       `Config::LEVEL_MAX_DIMENSION`) est signalée avec sa ligne et sa colonne.
+ */
+class LevelTextParser {
+public:
+    /** @brief Anomalie rencontrée pendant l'analyse (ligne et colonne à partir de 1). */
+    struct Diagnostic {
+        int line;
+        int column;
+        std::string message;
+    };
+
+    /**
+     * @brief Résultat de l'analyse.
+     * @param rows Nombre de rangées lues.
+     * @param cols Nombre de colonnes (celui de la première rangée).
+     * @param cells Valeurs de score rangée par rangée ; les cellules invalides ou manquantes valent 0.
+     * @param diagnostics Premières anomalies rencontrées (au plus `MAX_DIAGNOSTICS`).
+     * @param errorCount Nombre total d'anomalies.
+     */
+    struct Result {
+        int rows = 0;
+        int cols = 0;
+        std::vector<int8_t> cells;
+        std::vector<Diagnostic> diagnostics;
+        size_t errorCount = 0;
+    };
+
+    /** @brief Nombre maximal d'anomalies conservées dans `Result::diagnostics`. */
+    static constexpr size_t MAX_DIAGNOSTICS = 64;
+
+private:
+    /** @brief Scores valides de -9 à 9 : le bit `score + 9` est à 1 si `Config::isValidScore(score)`. */
+    static constexpr uint32_t VALID_SCORE_MASK = [] {
+        uint32_t mask = 0;
+        for (int score = -9; score <= 9; ++score) if (Config::isValidScore(score)) mask |= 1u << (score + 9);
+        return mask;
+    }();
+
+public:
+
+    /**
+     * @brief Analyse un niveau au format texte.
+     * @param data Début du texte.
+     * @param size Taille du texte en octets.
+     * @return Grille lue et anomalies rencontrées.
+     */
+    static Result parse(const char* data, size_t size) {
+        PROFILE_ZONE("LevelTextParser::parse");
+        Result result;
+        result.cells.resize(size / 2 + 1); // Estimation : une cellule pour deux octets, agrandie si des rangées sont complétées
+        const char* end = data + size;
+        const char* lineStart = data;
+        size_t cellCount = 0;
+        int lineNumber = 0;
+        while (lineStart < end && result.rows < Config::LEVEL_MAX_DIMENSION) {
+            ++lineNumber;
+            const char* lineEnd = static_cast<const char*>(std::memchr(lineStart, '\n', end - lineStart));
+            if (!lineEnd) lineEnd = end;
+
+            // Une valeur occupe au moins deux octets ("7 ") : la rangée tient dans (longueur + 1) / 2 cellules
+            const int limit = result.rows > 0 ? result.cols
+                                              : static_cast<int>(std::min<size_t>((lineEnd - lineStart + 1) / 2, Config::LEVEL_MAX_DIMENSION));
+            if (result.cells.size() < cellCount + limit) result.cells.resize(std::max(cellCount + limit, result.cells.size() * 2));
+            int8_t* out = result.cells.data() + cellCount;
+            int count = 0;
+            const char* p = lineStart;
+            for (;;) {
+                while (p < lineEnd && isBlank(*p)) ++p;
+                if (p >= lineEnd) break;
+                const char* token = p;
+                // Cas courant : un chiffre, éventuellement précédé d'un signe moins, suivi d'un espace ou de la fin de ligne.
+                // Décodé sans branche dépendant de la valeur, pour ne pas subir d'erreurs de prédiction sur une grille aléatoire.
+                const bool negative = (*p == '-');
+                const char* digit = p + negative;
+                const unsigned digitValue = digit < lineEnd ? static_cast<unsigned>(*digit - '0') : 10u;
+                int value;
+                if (digitValue <= 9 && (digit + 1 == lineEnd || isBlank(digit[1]))) {
+                    value = negative ? -static_cast<int>(digitValue) : static_cast<int>(digitValue);
+                    p = digit + 1;
+                    if (!((VALID_SCORE_MASK >> (value + 9)) & 1u)) value = reportInvalidScore(result, lineNumber, token - lineStart, value);
+                } else {
+                    value = parseToken(result, lineNumber, lineStart, lineEnd, p);
+                }
+                if (count < limit) out[count] = static_cast<int8_t>(value);
+                else if (count == limit) report(result, lineNumber, token - lineStart, "row has more than " + std::to_string(limit) + " values, extra values ignored");
+                ++count;
+            }
+
+            if (count > 0) {
+                if (result.rows == 0) {
+                    result.cols = std::min(count, limit);
+                } else if (count < result.cols) {
+                    report(result, lineNumber, lineEnd - lineStart,
+                           "row has " + std::to_string(count) + " values, expected " + std::to_string(result.cols) + ", missing cells set to 0");
+                    std::fill(out + count, out + result.cols, 0);
+                }
+                cellCount += result.cols;
+                ++result.rows;
+            }
+            lineStart = lineEnd + 1;
+        }
+        // Rangées au-delà de la limite : signalées une fois, à la première ligne non vide ignorée
+        while (lineStart < end) {
+            ++lineNumber;
+            const char* lineEnd = static_cast<const char*>(std::memchr(lineStart, '\n', end - lineStart));
+            if (!lineEnd) lineEnd = end;
+            const char* p = lineStart;
+            while (p < lineEnd && isBlank(*p)) ++p;
+            if (p < lineEnd) {
+                report(result, lineNumber, p - lineStart, "level has more than " + std::to_string(Config::LEVEL_MAX_DIMENSION) + " rows, extra rows ignored");
+                break;
+            }
+            lineStart = lineEnd + 1;
+        }
+        result.cells.resize(cellCount);
+        return result;
+    }
+
+private:
+    /** @brief Séparateur de valeurs : espace, tabulation, retour chariot (et autres caractères de contrôle). */
+    static bool isBlank(char c) { return static_cast<unsigned char>(c) <= ' '; }
+
+    /** @brief Enregistre une anomalie à la position `offset` (à partir de 0) de la ligne `line`. */
+    static void report(Result& result, int line, std::ptrdiff_t offset, std::string message) {
+        if (result.diagnostics.size() < MAX_DIAGNOSTICS) result.diagnostics.push_back({ line, static_cast<int>(offset) + 1, std::move(message) });
+        ++result.errorCount;
+    }
+
+    /** @brief Signale une valeur de score invalide et retourne la valeur de remplacement (0). */
+    static int reportInvalidScore(Result& result, int line, std::ptrdiff_t offset, int value) {
+        report(result, line, offset, "invalid score " + std::to_string(value));
+        return 0;
+    }
+
+    /**
+     * @brief Cas général : lit une valeur avec `std::from_chars` et avance `p` après le mot lu.
+     * @return La valeur lue, ou 0 (anomalie signalée) si le mot n'est pas un score valide.
+     */
+    static int parseToken(Result& result, int line, const char* lineStart, const char* lineEnd, const char*& p) {
+        const char* token = p;
+        int value = 0;
+        std::from_chars_result parsed = std::from_chars(token, lineEnd, value);
+        if (parsed.ec != std::errc() || (parsed.ptr < lineEnd && !isBlank(*parsed.ptr))) {
+            while (p < lineEnd && !isBlank(*p)) ++p;
+            report(result, line, token - lineStart, "unexpected '" + std::string(token, std::min<size_t>(p - token, 16)) + "', expected a score value");
+            return 0;
+        }
+        p = parsed.ptr;
+        if (!Config::isValidScore(value)) return reportInvalidScore(result, line, token - lineStart, value);
+        return value;
+    }
+};
+
+/**
+ * @class EditHistory
+ * @brief Historique d'annulation/rétablissement de l'éditeur, sous forme de différences compactes de cellules.
+ * @param m_undo Groupes annulables, du plus ancien au plus récent.
+ * @param m_redo Groupes annulés, rétablissables dans l'ordre inverse.
+ * @param m_open Groupe en cours d'enregistrement.
+ * @param m_groupOpen Indique qu'un groupe est en cours d'enregistrement (`beginGroup`).
+ * @param m_undoBytes Mémoire occupée par `m_undo`.
+ * @note Une opération (placement, effacement, remplissage...) forme un groupe, annulé ou rétabli d'un bloc en O(taille du changement).
+ * @note Un groupe est une suite de segments de cellules consécutives. Dans un segment, l'ancienne et la nouvelle valeur ne sont
+ *       stockées qu'une fois lorsqu'elles sont uniformes, un octet par cellule sinon : remplir un million de cellules coûte
+ *       quelques octets par rangée, et au pire un octet par cellule et par valeur.
+ * @note La mémoire est bornée par `Config::EDITOR_HISTORY_MAX_BYTES` et `Config::EDITOR_HISTORY_MAX_GROUPS` : les groupes les
+ *       plus anciens sont oubliés. Le dernier groupe est toujours conservé, même s'il dépasse la limite à lui seul.
+ */
+class EditHistory {
+private:
+    /** @brief Segment de cellules consécutives modifiées. */
+    struct Run {
+        uint32_t start = 0;
+        uint32_t count = 0;
+        uint32_t beforeOffset = 0;
+        uint32_t afterOffset = 0;
+        int8_t before = 0;
+        int8_t after = 0;
+        bool beforeVaries = false;
+        bool afterVaries = false;
+    };
+
+    /** @brief Modifications d'une opération. Les valeurs non uniformes sont dans `beforeBytes`/`afterBytes`. */
+    struct Group {
+        std::vector<Run> runs;
+        std::vector<int8_t> beforeBytes;
+        std::vector<int8_t> afterBytes;
+        size_t cellCount = 0;
+
+        size_t bytes() const { return runs.capacity() * sizeof(Run) + beforeBytes.capacity() + afterBytes.capacity(); }
+    };
+
+    std::deque<Group> m_undo;
+    std::vector<Group> m_redo;
+    Group m_open;
+    bool m_groupOpen = false;
+    size_t m_undoBytes = 0;
+
+    /**
+     * @brief Applique les valeurs d'un groupe à la grille.
+     * @param useAfter `true` pour rétablir (nouvelles valeurs), `false` pour annuler (anciennes valeurs).
+     * @param changed Reçoit les index des cellules des segments appliqués, au plus `maxChanged` ; un segment
+     *                peut contenir des cellules dont la valeur ne change pas.
+     */
+    static void apply(const Group& group, bool useAfter, std::vector<int8_t>& cells, std::vector<int>& changed, size_t maxChanged) {
+        // Les segments sont appliqués en ordre inverse pour l'annulation : une cellule modifiée deux fois retrouve sa valeur initiale
+        for (size_t n = 0; n < group.runs.size(); ++n) {
+            const Run& run = group.runs[useAfter ? n : group.runs.size() - 1 - n];
+            int8_t* target = cells.data() + run.start;
+            if (useAfter ? run.afterVaries : run.beforeVaries) {
+                const int8_t* source = (useAfter ? group.afterBytes.data() + run.afterOffset : group.beforeBytes.data() + run.beforeOffset);
+                std::copy(source, source + run.count, target);
             } else {
-                currentLineStr += c;
+                std::fill(target, target + run.count, useAfter ? run.after : run.before);
+            }
+            for (uint32_t i = 0; i < run.count && changed.size() < maxChanged; ++i) changed.push_back(static_cast<int>(run.start + i));
+        }
+    }
+
+    /** @brief Passe une valeur uniforme du segment courant en valeurs individuelles (`count` copies en fin de `bytes`). */
+    static void makeVarying(std::vector<int8_t>& bytes, uint32_t& offset, bool& varies, int8_t value, uint32_t count) {
+        offset = static_cast<uint32_t>(bytes.size());
+        bytes.insert(bytes.end(), count, value);
+        varies = true;
+    }
+
+    /** @brief Oublie les groupes les plus anciens tant que les limites sont dépassées. */
+    void enforceLimits() {
+        while (m_undo.size() > 1 && (m_undoBytes > Config::EDITOR_HISTORY_MAX_BYTES || m_undo.size() > Config::EDITOR_HISTORY_MAX_GROUPS)) {
+            m_undoBytes -= m_undo.front().bytes();
+            m_undo.pop_front();
+        }
+    }
+
+public:
+    /** @brief Oublie tout l'historique (nouvelle grille). */
+    void clear() {
+        m_undo.clear();
+        m_redo.clear();
+        m_open = Group();
+        m_groupOpen = false;
+        m_undoBytes = 0;
+    }
+
+    /** @brief Commence une opération : les modifications enregistrées jusqu'à `endGroup` seront annulées ensemble. */
+    void beginGroup() {
+        m_open = Group();
+        m_groupOpen = true;
+    }
+
+    /**
+     * @brief Enregistre la modification d'une cellule dans le groupe ouvert (ignorée si aucun groupe n'est ouvert).
+     * @param index Index de la cellule (rangée * colonnes + colonne).
+     * @param before Ancienne valeur.
+     * @param after Nouvelle valeur.
+     * @note Les modifications de cellules consécutives (parcours rangée par rangée) prolongent le segment courant en O(1).
+     */
+    void record(uint32_t index, int8_t before, int8_t after) {
+        if (!m_groupOpen || before == after) return;
+        ++m_open.cellCount;
+        if (!m_open.runs.empty()) {
+            Run& run = m_open.runs.back();
+            if (index == run.start + run.count) {
+                if (!run.beforeVaries && before != run.before) makeVarying(m_open.beforeBytes, run.beforeOffset, run.beforeVaries, run.before, run.count);
+                if (!run.afterVaries && after != run.after) makeVarying(m_open.afterBytes, run.afterOffset, run.afterVaries, run.after, run.count);
+                if (run.beforeVaries) m_open.beforeBytes.push_back(before);
+                if (run.afterVaries) m_open.afterBytes.push_back(after);
+                ++run.count;
+                return;
+            }
+        }
+        Run run;
+        run.start = index;
+        run.count = 1;
+        run.before = before;
+        run.after = after;
+        m_open.runs.push_back(run);
+    }
+
+    /**
+     * @brief Enregistre la modification de cellules consécutives dans le groupe ouvert (ignorée si aucun groupe n'est ouvert).
+     * @param start Index de la première cellule.
+     * @param count Nombre de cellules.
+     * @param before Anciennes valeurs (`count` octets).
+     * @param after Nouvelles valeurs (`count` octets), ou `nullptr` si toutes valent `afterValue`.
+     * @param afterValue Nouvelle valeur uniforme (si `after` est `nullptr`).
+     * @note Les opérations par rangée (rectangle, remplissage, collage) ajoutent ainsi un seul segment par rangée.
+     */
+    void recordSpan(uint32_t start, uint32_t count, const int8_t* before, const int8_t* after, int8_t afterValue) {
+        if (!m_groupOpen || count == 0) return;
+        size_t changedCount = 0;
+        if (after) for (uint32_t i = 0; i < count; ++i) changedCount += (before[i] != after[i]);
+        else for (uint32_t i = 0; i < count; ++i) changedCount += (before[i] != afterValue);
+        if (changedCount == 0) return;
+        m_open.cellCount += changedCount;
+
+        Run run;
+        run.start = start;
+        run.count = count;
+        run.before = before[0];
+        run.after = after ? after[0] : afterValue;
+        if (std::any_of(before + 1, before + count, [&](int8_t v) { return v != run.before; })) {
+            run.beforeOffset = static_cast<uint32_t>(m_open.beforeBytes.size());
+            m_open.beforeBytes.insert(m_open.beforeBytes.end(), before, before + count);
+            run.beforeVaries = true;
+        }
+        if (after && std::any_of(after + 1, after + count, [&](int8_t v) { return v != run.after; })) {
+            run.afterOffset = static_cast<uint32_t>(m_open.afterBytes.size());
+            m_open.afterBytes.insert(m_open.afterBytes.end(), after, after + count);
+            run.afterVaries = true;
+        }
+        m_open.runs.push_back(run);
+    }
+
+    /**
+     * @brief Termine l'opération en cours.
+     * @return `true` si elle a modifié au moins une cellule (elle devient annulable et l'historique de rétablissement est vidé).
+     */
+    bool endGroup() {
+        if (!m_groupOpen) return false;
+        m_groupOpen = false;
+        if (m_open.cellCount == 0) return false;
+        m_open.runs.shrink_to_fit();
+        m_open.beforeBytes.shrink_to_fit();
+        m_open.afterBytes.shrink_to_fit();
+        m_undoBytes += m_open.bytes();
+        m_undo.push_back(std::move(m_open));
+        m_open = Group();
+        m_redo.clear();
+        enforceLimits();
+        return true;
+    }
+
+    /** @brief Nombre de cellules modifiées par le groupe ouvert. */
+    size_t openGroupCellCount() const { return m_groupOpen ? m_open.cellCount : 0; }
+
+    /** @brief Indique si une opération peut être annulée. */
+    bool canUndo() const { return !m_undo.empty(); }
+
+    /** @brief Indique si une opération peut être rétablie. */
+    bool canRedo() const { return !m_redo.empty(); }
+
+    /**
+     * @brief Annule la dernière opération.
+     * @param cells Grille à modifier.
+     * @param changed Reçoit les index des cellules modifiées, au plus `maxChanged`.
+     * @param maxChanged Nombre maximal d'index à retourner.
+     * @return Le nombre de cellules modifiées (0 si rien à annuler).
+     */
+    size_t undo(std::vector<int8_t>& cells, std::vector<int>& changed, size_t maxChanged) {
+        if (m_undo.empty()) return 0;
+        Group group = std::move(m_undo.back());
+        m_undo.pop_back();
+        m_undoBytes -= group.bytes();
+        apply(group, false, cells, changed, maxChanged);
+        size_t count = group.cellCount;
+        m_redo.push_back(std::move(group));
+        return count;
+    }
+
+    /**
+     * @brief Rétablit la dernière opération annulée.
+     * @param cells Grille à modifier.
+     * @param changed Reçoit les index des cellules modifiées, au plus `maxChanged`.
+     * @param maxChanged Nombre maximal d'index à retourner.
+     * @return Le nombre de cellules modifiées (0 si rien à rétablir).
+     */
+    size_t redo(std::vector<int8_t>& cells, std::vector<int>& changed, size_t maxChanged) {
+        if (m_redo.empty()) return 0;
+        Group group = std::move(m_redo.back());
+        m_redo.pop_back();
+        apply(group, true, cells, changed, maxChanged);
+        size_t count = group.cellCount;
+        m_undoBytes += group.bytes();
+        m_undo.push_back(std::move(group));
+        enforceLimits();
+        return count;
+    }
+};
+
+/**
+* @class Level
+* @brief Gère la grille de briques, le chargement et la sauvegarde des niveaux.
+* @param m_bricks Vecteur d'objets Brick constituant le niveau (créé par `setupBricks`).
+* @param m_rows Nombre de rangées de la grille.
+* @param m_cols Nombre de colonnes de la grille.
+* @param m_gridState État de la grille rangée par rangée (valeurs de score des briques, un octet par cellule).
+* @param m_activeBrickCount Nombre de briques actives (destructibles) dans le niveau.
+* @param m_editorSelectedRow Ligne sélectionnée en mode éditeur (logique, 0 en haut).
+* @param m_editorSelectedCol Colonne sélectionnée en mode éditeur (logique, 0 à gauche).
+* @param m_editorAnchorRow Rangée de l'ancre (sélection précédente), coin opposé des outils Rectangle, Ligne et Copier.
+* @param m_editorAnchorCol Colonne de l'ancre.
+* @param m_clipboard Cellules copiées par `copySelection`, rangée par rangée.
+* @param m_clipboardRows Nombre de rangées copiées.
+* @param m_clipboardCols Nombre de colonnes copiées.
+* @param m_gridTotalWidth Largeur totale de la grille de briques (avec espacements).
+* @param m_gridTotalHeight Hauteur totale de la grille de briques (avec espacements).
+* @param m_gridStartX Position X de départ (coin supérieur gauche) de la grille.
+* @param m_gridStartY Position Y de départ (coin supérieur gauche) de la grille.
+* @param m_cellWidth Largeur d'une cellule à l'écran.
+* @param m_cellHeight Hauteur d'une cellule à l'écran.
+* @param m_cellSpacing Espacement entre deux cellules à l'écran.
+* @param m_gridView Zone de l'écran où la grille est visible (toute la fenêtre en jeu, la bande de la grille dans l'éditeur).
+* @param m_editorZoom Facteur de zoom de l'éditeur (1 : grille entière visible).
+* @param m_editorMaxZoom Zoom maximal de l'éditeur : une cellule mesure au plus `Config::EDITOR_MAX_CELL_PIXELS` de large.
+* @param m_editorPanX Décalage horizontal de la vue de l'éditeur, en pixels.
+* @param m_editorPanY Décalage vertical de la vue de l'éditeur, en pixels.
+* @param m_editorWindowWidth Largeur de la fenêtre lors du dernier `calculateEditorGridDimensions`.
+* @param m_editorWindowHeight Hauteur de la fenêtre lors du dernier `calculateEditorGridDimensions`.
+* @param m_version Compteur incrémenté à chaque modification des briques ou de la grille.
+* @param m_changedCells Index des cellules modifiées depuis le dernier appel à `takeChanges()`.
+* @param m_allChanged Indique que toute la grille a changé depuis le dernier appel à `takeChanges()`.
+* @param m_collisionTests Nombre de tests balle/brique effectués depuis le dernier appel à `takeCollisionTests()`.
+* @param m_history Historique d'annulation des modifications de l'éditeur (vidé lorsque la grille est remplacée).
+*/
+class Level {
+private:
+    std::vector<Brick> m_bricks;
+    int m_rows = 0;
+    int m_cols = 0;
+    std::vector<int8_t> m_gridState;
+    int m_activeBrickCount = 0;
+    int m_editorSelectedRow = -1;
+    int m_editorSelectedCol = -1;
+    int m_editorAnchorRow = -1;
+    int m_editorAnchorCol = -1;
+    std::vector<int8_t> m_clipboard;
+    int m_clipboardRows = 0;
+    int m_clipboardCols = 0;
+    float m_editorZoom = 1.0f;
+    float m_editorMaxZoom = 1.0f;
+    float m_editorPanX = 0.0f;
+    float m_editorPanY = 0.0f;
+    float m_editorWindowWidth = static_cast<float>(Config::DEFAULT_WINDOW_WIDTH);
+    float m_editorWindowHeight = static_cast<float>(Config::DEFAULT_WINDOW_HEIGHT);
+    uint64_t m_version = 0;
+    std::vector<int> m_changedCells;
+    bool m_allChanged = true;
+    uint32_t m_collisionTests = 0;
+    EditHistory m_history;
+
+    /** @brief Nombre maximal de cellules échantillonnées par côté d'un bloc de l'éditeur (`renderEditorBlock`). */
+    static constexpr int EDITOR_BLOCK_SAMPLES = 4;
+
+    /** @brief Nombre de cellules modifiées au-delà duquel la grille est considérée comme entièrement modifiée. */
+    static constexpr size_t MAX_TRACKED_CHANGES = 256;
+
+    /** @brief Enregistre la modification d'une cellule et incrémente la version. */
+    void markCellChanged(int row, int col) {
+        ++m_version;
+        if (m_allChanged) return;
+        if (m_changedCells.size() >= MAX_TRACKED_CHANGES) { m_allChanged = true; m_changedCells.clear(); return; }
+        m_changedCells.push_back(row * m_cols + col);
+    }
+
+    /** @brief Enregistre une modification de toute la grille et incrémente la version. */
+    void markAllChanged() { ++m_version; m_allChanged = true; m_changedCells.clear(); }
+
+    /** @brief Obtient la valeur de score d'une cellule de `m_gridState`. */
+    int8_t& cell(int row, int col) { return m_gridState[static_cast<size_t>(row) * m_cols + col]; }
+    int8_t cell(int row, int col) const { return m_gridState[static_cast<size_t>(row) * m_cols + col]; }
+
+    /** @brief Modifie une cellule en l'enregistrant dans l'opération ouverte de l'historique, puis la marque comme modifiée. */
+    void setCell(int row, int col, int8_t value) {
+        size_t index = static_cast<size_t>(row) * m_cols + col;
+        m_history.record(static_cast<uint32_t>(index), m_gridState[index], value);
+        m_gridState[index] = value;
+        markCellChanged(row, col);
+    }
+
+    /** @brief Signale la modification de `count` cellules consécutives d'une rangée (toute la grille au-delà de `MAX_TRACKED_CHANGES`). */
+    void markSpanChanged(int row, int col, int count) {
+        if (m_allChanged || m_changedCells.size() + count > MAX_TRACKED_CHANGES) { markAllChanged(); return; }
+        for (int c = col; c < col + count; ++c) markCellChanged(row, c);
+    }
+
+    /** @brief Remplit `count` cellules consécutives d'une rangée avec `value`, en une seule entrée d'historique. */
+    void fillSpan(int row, int col, int count, int8_t value) {
+        size_t index = static_cast<size_t>(row) * m_cols + col;
+        int8_t* first = m_gridState.data() + index;
+        m_history.recordSpan(static_cast<uint32_t>(index), static_cast<uint32_t>(count), first, nullptr, value);
+        std::fill(first, first + count, value);
+        markSpanChanged(row, col, count);
+    }
+
+    /** @brief Copie `count` valeurs dans des cellules consécutives d'une rangée, en une seule entrée d'historique. */
+    void copySpan(int row, int col, int count, const int8_t* values) {
+        size_t index = static_cast<size_t>(row) * m_cols + col;
+        int8_t* first = m_gridState.data() + index;
+        m_history.recordSpan(static_cast<uint32_t>(index), static_cast<uint32_t>(count), first, values, 0);
+        std::copy(values, values + count, first);
+        markSpanChanged(row, col, count);
+    }
+
+    /** @brief Valeur de score posée par un pinceau sur une rangée (`BRUSH_BY_ROW` : couleur selon la rangée). */
+    int8_t brushValue(int brush, int row) const {
+        return static_cast<int8_t>(brush == BRUSH_BY_ROW ? defaultScoreForRow(row, m_rows) : brush);
+    }
+
+    /** @brief Indique si l'ancre de l'éditeur désigne une cellule de la grille. */
+    bool hasEditorAnchor() const {
+        return m_editorAnchorRow >= 0 && m_editorAnchorRow < m_rows && m_editorAnchorCol >= 0 && m_editorAnchorCol < m_cols;
+    }
+
+    /** @brief Remplit le rectangle entre l'ancre et la sélection, rangée par rangée. */
+    void fillRect(int brush) {
+        int top = std::min(m_editorAnchorRow, m_editorSelectedRow), bottom = std::max(m_editorAnchorRow, m_editorSelectedRow);
+        int left = std::min(m_editorAnchorCol, m_editorSelectedCol), right = std::max(m_editorAnchorCol, m_editorSelectedCol);
+        for (int r = top; r <= bottom; ++r) fillSpan(r, left, right - left + 1, brushValue(brush, r));
+    }
+
+    /** @brief Trace un segment de l'ancre à la sélection (algorithme de Bresenham). */
+    void drawLine(int brush) {
+        int r = m_editorAnchorRow, c = m_editorAnchorCol;
+        int dr = std::abs(m_editorSelectedRow - r), dc = std::abs(m_editorSelectedCol - c);
+        int stepR = r < m_editorSelectedRow ? 1 : -1, stepC = c < m_editorSelectedCol ? 1 : -1;
+        int error = dc - dr;
+        while (true) {
+            setCell(r, c, brushValue(brush, r));
+            if (r == m_editorSelectedRow && c == m_editorSelectedCol) break;
+            int doubled = 2 * error;
+            if (doubled > -dr) { error -= dr; c += stepC; }
+            if (doubled < dc) { error += dc; r += stepR; }
+        }
+    }
+
+    /**
+     * @brief Remplit la zone 4-connexe de même valeur que la cellule sélectionnée (remplissage par segments de rangée).
+     * @note Chaque segment est étendu à gauche et à droite, puis seul le début de chaque segment candidat des rangées
+     *       voisines est empilé : le coût est proportionnel à la zone remplie. Les segments sont collectés avant d'être
+     *       remplis, ce qui permet d'utiliser un pinceau dont la valeur coïncide avec la zone sur certaines rangées.
+     */
+    void floodFill(int brush) {
+        struct Span { int row, left, count; };
+        const int8_t target = cell(m_editorSelectedRow, m_editorSelectedCol);
+        std::vector<uint64_t> visited((m_gridState.size() + 63) / 64, 0);
+        auto matches = [&](int row, int col) {
+            size_t index = static_cast<size_t>(row) * m_cols + col;
+            return m_gridState[index] == target && !(visited[index >> 6] & (uint64_t(1) << (index & 63)));
+        };
+        std::vector<Span> spans;
+        std::vector<std::pair<int, int>> seeds = { { m_editorSelectedRow, m_editorSelectedCol } };
+        while (!seeds.empty()) {
+            auto [row, col] = seeds.back();
+            seeds.pop_back();
+            if (!matches(row, col)) continue;
+            int left = col, right = col;
+            while (left > 0 && matches(row, left - 1)) --left;
+            while (right + 1 < m_cols && matches(row, right + 1)) ++right;
+            for (size_t index = static_cast<size_t>(row) * m_cols + left; index <= static_cast<size_t>(row) * m_cols + right; ++index) {
+                visited[index >> 6] |= uint64_t(1) << (index & 63);
+            }
+            spans.push_back({ row, left, right - left + 1 });
+            for (int next : { row - 1, row + 1 }) {
+                if (next < 0 || next >= m_rows) continue;
+                for (int c = left; c <= right; ++c) {
+                    if (matches(next, c) && (c == left || !matches(next, c - 1))) seeds.push_back({ next, c });
+                }
+            }
+        }
+        for (const Span& span : spans) fillSpan(span.row, span.left, span.count, brushValue(brush, span.row));
+    }
+
+    /**
+     * @brief Annule ou rétablit une opération de l'historique et signale les cellules modifiées.
+     * @return Le nombre de cellules modifiées.
+     */
+    size_t applyHistory(bool undo) {
+        // Les segments couvrent aussi des cellules inchangées : c'est leur taille, et non `count`, qui décide du
+        // rafraîchissement partiel. Un index de plus que la limite est demandé pour détecter la troncature.
+        std::vector<int> changed;
+        size_t count = undo ? m_history.undo(m_gridState, changed, MAX_TRACKED_CHANGES + 1)
+                            : m_history.redo(m_gridState, changed, MAX_TRACKED_CHANGES + 1);
+        if (changed.size() > MAX_TRACKED_CHANGES) markAllChanged();
+        else for (int index : changed) markCellChanged(index / m_cols, index % m_cols);
+        return count;
+    }
+
+    /**
+     * @brief Redimensionne la grille et annule la sélection de l'éditeur.
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score à copier, rangée par rangée (`nullptr` pour une grille vide).
+     */
+    void resizeGrid(int rows, int cols, const int8_t* cells = nullptr) {
+        m_rows = rows;
+        m_cols = cols;
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        if (cells) m_gridState.assign(cells, cells + cellCount);
+        else m_gridState.assign(cellCount, 0);
+        m_bricks.clear();
+        m_editorSelectedRow = -1;
+        m_editorSelectedCol = -1;
+        m_editorAnchorRow = -1;
+        m_editorAnchorCol = -1;
+        m_editorZoom = 1.0f;
+        m_editorPanX = 0.0f;
+        m_editorPanY = 0.0f;
+        m_history.clear();
+    }
+
+    /** @brief Remplit la grille avec la disposition par défaut (GRID_ROWS x GRID_COLS). */
+    void createDefaultLayout() {
+        resizeGrid(Config::GRID_ROWS, Config::GRID_COLS);
+        for (int r = 0; r < m_rows; ++r) {
+            for (int c = 0; c < m_cols; ++c) cell(r, c) = static_cast<int8_t>(defaultScoreForRow(r, m_rows));
+        }
+    }
+
+    /** @brief Indique si un nom de fichier désigne le format texte (extension `.txt`). */
+    static bool isTextFilename(const std::string& filename) {
+        return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".txt") == 0;
+    }
+
+    /**
+     * @brief Charge un niveau binaire déjà projeté en mémoire.
+     * @param file Fichier projeté.
+     * @param filename Nom du fichier (pour les messages).
+     * @return `true` si l'en-tête et la somme de contrôle sont valides. En cas d'échec, la grille n'est pas modifiée.
+     */
+    bool loadBinary(const MappedFile& file, const std::string& filename) {
+        LevelFile::Header header;
+        std::string error;
+        if (!LevelFile::readHeader(file.data(), file.size(), header, error)) {
+            std::cerr << "Error: Could not load level file " << filename << ": " << error << "." << std::endl;
+            return false;
+        }
+        return loadCells(static_cast<int>(header.rows), static_cast<int>(header.cols),
+                         reinterpret_cast<const int8_t*>(file.data() + header.headerSize), header.checksum, filename);
+    }
+
+public:
+    float m_gridTotalWidth = 0.0f;
+    float m_gridTotalHeight = 0.0f;
+    float m_gridStartX = 0.0f;
+    float m_gridStartY = 0.0f;
+    float m_cellWidth = Config::BRICK_WIDTH;
+    float m_cellHeight = Config::BRICK_HEIGHT;
+    float m_cellSpacing = Config::BRICK_SPACING;
+    Rect m_gridView = { 0.0f, 0.0f, static_cast<float>(Config::DEFAULT_WINDOW_WIDTH), static_cast<float>(Config::DEFAULT_WINDOW_HEIGHT) };
+
+    /** @brief Pinceau de l'éditeur posant la couleur de la rangée (quart supérieur rouge, ..., quart inférieur jaune). */
+    static constexpr int BRUSH_BY_ROW = -128;
+    
+    Level() {
+        resizeGrid(Config::GRID_ROWS, Config::GRID_COLS);
+        m_bricks.resize(m_gridState.size());
+    }
+
+    /**
+     * @brief Charge la grille depuis des cellules au format binaire (fichier de niveau ou archive projetés en mémoire).
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score, rangée par rangée.
+     * @param checksum Somme de contrôle attendue (`LevelFile::checksum`).
+     * @param source Origine des cellules (pour les messages).
+     * @return `true` si la somme de contrôle correspond et que toutes les valeurs sont valides.
+     *         Si la somme de contrôle ne correspond pas, la grille n'est pas modifiée.
+     * @note Les cellules sont copiées telles quelles ; seules les valeurs de score invalides sont remplacées par 0.
+     */
+    bool loadCells(int rows, int cols, const int8_t* cells, uint64_t checksum, const std::string& source) {
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        if (LevelFile::checksum(reinterpret_cast<const uint8_t*>(cells), cellCount) != checksum) {
+            std::cerr << "Error: Could not load level " << source << ": checksum mismatch." << std::endl;
+            return false;
+        }
+
+        std::cout << "Loading level from " << source << " (" << rows << "x" << cols << ")" << std::endl;
+        resizeGrid(rows, cols, cells);
+        markAllChanged();
+        if (!LevelFile::allScoresValid(m_gridState.data(), cellCount)) {
+            size_t invalidCount = 0;
+            for (int8_t& score : m_gridState) {
+                if (!Config::isValidScore(score)) { score = 0; ++invalidCount; }
+            }
+            std::cerr << "Warning: " << invalidCount << " invalid score values in " << source << ". Setting them to 0." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Charge la configuration du niveau depuis un fichier binaire, ou depuis un fichier texte si son extension est `.txt`.
+     * @param filename Le nom du fichier de niveau.
+     * @return `true` si le chargement réussit ou si un niveau par défaut est créé, `false` si une erreur majeure se produit.
+     * @note Si le fichier binaire n'existe pas, `Config::LEVEL_TEXT_FILENAME` est importé puis sauvegardé au format binaire.
+     *       À défaut, un niveau par défaut est créé et sauvegardé.
+     * @note Un fichier binaire corrompu (en-tête ou somme de contrôle invalide) n'est pas chargé : le niveau précédent est conservé.
+     */
+    bool load(const std::string& filename) {
+        PROFILE_ZONE("Level::load");
+        if (isTextFilename(filename)) return importText(filename);
+
+        MappedFile file;
+        if (file.open(filename)) return loadBinary(file, filename);
+
+        std::ifstream legacyFile(Config::LEVEL_TEXT_FILENAME);
+        if (legacyFile.is_open()) {
+            legacyFile.close();
+            std::cout << "Binary level " << filename << " not found. Importing " << Config::LEVEL_TEXT_FILENAME << "." << std::endl;
+            bool success = importText(Config::LEVEL_TEXT_FILENAME);
+            save(filename);
+            return success;
+        }
+        std::cerr << "Warning: Could not load level file: " << filename << ". Creating default layout." << std::endl;
+        createDefaultLayout();
+        save(filename);
+        markAllChanged();
+        return true;
+    }
+
+    /**
+     * @brief Importe un niveau au format texte (une ligne par rangée, valeurs de score séparées par des espaces).
+     * @param filename Le nom du fichier texte.
+     * @return `true` si l'import réussit ou si un niveau par défaut est créé, `false` si une erreur de format se produit.
+     * @note Si le fichier n'existe pas, un niveau par défaut est créé et sauvegardé.
+     * @note Les dimensions sont déduites du fichier (la première rangée fixe le nombre de colonnes).
+     *       Les valeurs manquantes ou invalides sont remplacées par 0 et signalées avec leur ligne et leur colonne.
+     * @note Le fichier est projeté en mémoire et analysé en un seul passage (`LevelTextParser`).
+     */
+    bool importText(const std::string& filename) {
+        MappedFile levelFile;
+        if (!levelFile.open(filename)) {
+            std::cerr << "Warning: Could not load level file: " << filename << ". Creating default layout." << std::endl;
+            createDefaultLayout();
+            save(filename);
+            markAllChanged();
+            return true;
+        }
+
+        std::cout << "Loading level from " << filename << std::endl;
+        LevelTextParser::Result parsed = LevelTextParser::parse(reinterpret_cast<const char*>(levelFile.data()), levelFile.size());
+        levelFile.close();
+        for (const LevelTextParser::Diagnostic& diagnostic : parsed.diagnostics) {
+            std::cerr << "Warning: " << filename << ":" << diagnostic.line << ":" << diagnostic.column << ": " << diagnostic.message << std::endl;
+        }
+        if (parsed.errorCount > parsed.diagnostics.size()) {
+            std::cerr << "Warning: " << filename << ": " << (parsed.errorCount - parsed.diagnostics.size()) << " more problems not shown." << std::endl;
+        }
+        if (parsed.rows == 0) {
+            std::cerr << "Warning: Level file " << filename << " is empty. Creating default layout." << std::endl;
+            createDefaultLayout();
+            markAllChanged();
+            return false;
+        }
+
+        resizeGrid(parsed.rows, parsed.cols, parsed.cells.data());
+        markAllChanged();
+        return parsed.errorCount == 0;
+    }
+
+    /**
+     * @brief Sauvegarde la configuration actuelle du niveau (les valeurs de score de `m_gridState`) dans un fichier.
+     * @param filename Le nom du fichier de niveau. Le format texte est utilisé si son extension est `.txt`, le format binaire sinon.
+     * @return `true` si la sauvegarde réussit, `false` sinon.
+     * @note Le fichier existant est remplacé atomiquement : une sauvegarde interrompue le laisse intact.
+     */
+    bool save(const std::string& filename) const {
+        if (isTextFilename(filename)) return exportText(filename);
+        std::cout << "Saving level (" << m_rows << "x" << m_cols << ") to " << filename << std::endl;
+        if (!LevelFile::write(filename, m_rows, m_cols, m_gridState.data())) {
+            std::cerr << "Error: Could not open level file for saving: " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Exporte le niveau au format texte, lisible et modifiable à la main.
+     * @param filename Le nom du fichier texte.
+     * @return `true` si l'export réussit, `false` sinon.
+     * @note Les valeurs de score sont écrites dans le même format que celui utilisé par `importText`.
+     * @note Les briques indestructibles sont représentées par `Config::SCORE_INDESTRUCTIBLE`, les cellules vides par 0.
+     * @note Le texte est construit en mémoire puis écrit d'un bloc, en remplaçant atomiquement le fichier (`AtomicFileWriter`).
+     */
+    bool exportText(const std::string& filename) const {
+        AtomicFileWriter levelFile;
+        if (!levelFile.open(filename)) {
+            std::cerr << "Error: Could not open level file for saving: " << filename << std::endl;
+            return false;
+        }
+        std::cout << "Saving level (score values) to " << filename << std::endl;
+        std::string text;
+        text.reserve(m_gridState.size() * 3);
+        char buffer[8];
+        for (int r = 0; r < m_rows; ++r) {
+            for (int c = 0; c < m_cols; ++c) {
+                char* end = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<int>(cell(r, c))).ptr;
+                text.append(buffer, end);
+                text += (c == m_cols - 1) ? '\n' : ' ';
+            }
+        }
+        levelFile.write(text.data(), text.size());
+        if (!levelFile.commit()) {
+            std::cerr << "Error: Could not write level file: " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Calcule les dimensions et la position de départ de la grille de briques.
+     * @param windowWidth Largeur de la fenêtre.
+     * @param windowHeight Hauteur de la fenêtre.
+     * @note La grille est centrée horizontalement. Sa position Y est calculée pour être en haut de l'écran,
+     *       mais pas trop bas pour laisser de la place pour la raquette et la zone de jeu.
+     * @note Une grille plus grande que GRID_ROWS x GRID_COLS est réduite pour tenir dans la même surface.
+     */
+    void calculateGridDimensions(float windowWidth, float windowHeight) {
+        auto extent = [](int count, float size) { return count * (size + Config::BRICK_SPACING) - Config::BRICK_SPACING; };
+        float scale = std::min({ 1.0f,
+                                 extent(Config::GRID_COLS, Config::BRICK_WIDTH) / extent(m_cols, Config::BRICK_WIDTH),
+                                 extent(Config::GRID_ROWS, Config::BRICK_HEIGHT) / extent(m_rows, Config::BRICK_HEIGHT) });
+        m_cellWidth = Config::BRICK_WIDTH * scale;
+        m_cellHeight = Config::BRICK_HEIGHT * scale;
+        m_cellSpacing = Config::BRICK_SPACING * scale;
+        m_gridTotalWidth = m_cols * (m_cellWidth + m_cellSpacing) - m_cellSpacing;
+        m_gridTotalHeight = m_rows * (m_cellHeight + m_cellSpacing) - m_cellSpacing;
+        m_gridStartX = (windowWidth - m_gridTotalWidth) / 2.0f;
+        m_gridStartY = windowHeight * 0.90f - m_gridTotalHeight;
+        if (m_gridStartY < windowHeight * 0.25f) {
+            m_gridStartY = windowHeight * 0.25f;
+        }
+        m_gridView = { 0.0f, 0.0f, windowWidth, windowHeight };
+    }
+
+    /**
+     * @brief Calcule la disposition de la grille dans l'éditeur : vue d'ensemble (`calculateGridDimensions`), puis zoom et déplacement.
+     * @param windowWidth Largeur de la fenêtre.
+     * @param windowHeight Hauteur de la fenêtre.
+     * @note La grille n'est visible que dans la bande entre les boutons et le titre (`m_gridView`). Le zoom s'applique autour
+     *       du centre de cette bande. Une grille plus petite que la bande y reste entière ; une grille plus grande la couvre.
+     */
+    void calculateEditorGridDimensions(float windowWidth, float windowHeight) {
+        calculateGridDimensions(windowWidth, windowHeight);
+        m_editorWindowWidth = windowWidth;
+        m_editorWindowHeight = windowHeight;
+        float viewBottom = std::min(m_gridStartY, windowHeight * 0.25f);
+        float viewTop = std::max(m_gridStartY + m_gridTotalHeight, windowHeight * 0.90f);
+        m_gridView = { 0.0f, viewBottom, windowWidth, viewTop - viewBottom };
+
+        m_editorMaxZoom = std::max(1.0f, Config::EDITOR_MAX_CELL_PIXELS / std::max(m_cellWidth, 1e-6f));
+        m_editorZoom = std::clamp(m_editorZoom, 1.0f, m_editorMaxZoom);
+        if (m_editorZoom == 1.0f) { m_editorPanX = 0.0f; m_editorPanY = 0.0f; }
+        float centerX = m_gridView.x + m_gridView.width / 2.0f, centerY = m_gridView.y + m_gridView.height / 2.0f;
+        m_cellWidth *= m_editorZoom;
+        m_cellHeight *= m_editorZoom;
+        m_cellSpacing *= m_editorZoom;
+        m_gridTotalWidth = m_cols * (m_cellWidth + m_cellSpacing) - m_cellSpacing;
+        m_gridTotalHeight = m_rows * (m_cellHeight + m_cellSpacing) - m_cellSpacing;
+
+        auto clampAxis = [](float start, float extent, float viewStart, float viewExtent) {
+            if (extent <= viewExtent) return std::clamp(start, viewStart, viewStart + viewExtent - extent);
+            return std::clamp(start, viewStart + viewExtent - extent, viewStart);
+        };
+        float zoomedX = centerX + (m_gridStartX - centerX) * m_editorZoom;
+        float zoomedY = centerY + (m_gridStartY - centerY) * m_editorZoom;
+        m_gridStartX = clampAxis(zoomedX + m_editorPanX, m_gridTotalWidth, m_gridView.x, m_gridView.width);
+        m_gridStartY = clampAxis(zoomedY + m_editorPanY, m_gridTotalHeight, m_gridView.y, m_gridView.height);
+        m_editorPanX = m_gridStartX - zoomedX;
+        m_editorPanY = m_gridStartY - zoomedY;
+    }
+
+    /**
+     * @brief Zoome la vue de l'éditeur en gardant fixe le point de la grille sous le curseur.
+     * @param factor Facteur multiplicatif (> 1 pour agrandir).
+     * @param mouseX Position X du curseur.
+     * @param mouseY Position Y du curseur.
+     */
+    void zoomEditorView(float factor, float mouseX, float mouseY) {
+        float newZoom = std::clamp(m_editorZoom * factor, 1.0f, m_editorMaxZoom);
+        if (newZoom == m_editorZoom) return;
+        float centerX = m_gridView.x + m_gridView.width / 2.0f, centerY = m_gridView.y + m_gridView.height / 2.0f;
+        float ratio = newZoom / m_editorZoom;
+        // Position de la vue d'ensemble par rapport au centre, puis position voulue après zoom
+        float fitOffsetX = (m_gridStartX - m_editorPanX - centerX) / m_editorZoom;
+        float fitOffsetY = (m_gridStartY - m_editorPanY - centerY) / m_editorZoom;
+        m_editorPanX = mouseX - (mouseX - m_gridStartX) * ratio - centerX - fitOffsetX * newZoom;
+        m_editorPanY = mouseY - (mouseY - m_gridStartY) * ratio - centerY - fitOffsetY * newZoom;
+        m_editorZoom = newZoom;
+        calculateEditorGridDimensions(m_editorWindowWidth, m_editorWindowHeight);
+    }
+
+    /** @brief Déplace la vue de l'éditeur (la grille suit le déplacement, en pixels). */
+    void panEditorView(float dx, float dy) {
+        m_editorPanX += dx;
+        m_editorPanY += dy;
+        calculateEditorGridDimensions(m_editorWindowWidth, m_editorWindowHeight);
+    }
+
+    /** @brief Revient à la vue d'ensemble de la grille dans l'éditeur. */
+    void resetEditorView() {
+        m_editorZoom = 1.0f;
+        calculateEditorGridDimensions(m_editorWindowWidth, m_editorWindowHeight);
+    }
+
+    /** @brief Obtient le facteur de zoom de l'éditeur (1 : grille entière). */
+    float getEditorZoom() const { return m_editorZoom; }
+
+    /**
+     * @brief Crée/Met à jour les objets Brick basés sur `m_gridState`.
+     * @param windowWidth Largeur de la fenêtre.
+     * @param windowHeight Hauteur de la fenêtre.
+     * @note Cette fonction doit être appelée après `load()` et `calculateGridDimensions()`.
+     *       Elle initialise chaque brique avec sa position et son type/score.
+     */
+    void setupBricks(float windowWidth, float windowHeight) {
+        PROFILE_ZONE("Level::setupBricks");
+        calculateGridDimensions(windowWidth, windowHeight);
+        m_activeBrickCount = 0;
+        m_bricks.resize(m_gridState.size());
+        const GridLayout layout = getLayout();
+        int brickIndex = 0;
+        for (int r = 0; r < m_rows; ++r) {
+            for (int c = 0; c < m_cols; ++c) {
+                Brick& brick = m_bricks[brickIndex];
+                int scoreValue = cell(r, c);
+
+                Rect rect = cellRect(layout, m_rows, r, c);
+
+                brick.init(rect.x, rect.y, rect.width, rect.height, scoreValue);
+                if (brick.isActive() && !brick.isIndestructible()) {
+                    m_activeBrickCount++;
+                }
+                brickIndex++;
+            }
+        }
+        markAllChanged();
+    }
+
+    /**
+     * @brief Vérifie les collisions entre la balle et les briques du niveau en utilisant une méthode de balayage (swept collision).
+     *        Si une collision est détectée comme la plus proche dans la trajectoire actuelle de la balle,
+     *        elle informe la balle de cette collision imminente (position, normale, index de la brique).
+     * @param ball La balle à vérifier.
+     * @note Cette méthode ne modifie pas l'état des briques ni de la balle directement, elle prépare la balle à gérer la collision dans son propre `update()`.
+     */
+    void checkCollisions(Ball& ball) {
+        PROFILE_ZONE("Level::checkCollisions");
+        const BallSweep sweep(ball);
+        float closestTime = 1.0f;
+        int closestBrickIndex = -1;
+        Vec2 closestNormal = {0.0f, 0.0f};
+
+        for (size_t i = 0; i < m_bricks.size(); ++i) {
+            const Brick& brick = m_bricks[i];
+            if (!brick.isActive()) continue;
+            ++m_collisionTests;
+            if (sweep.test(brick.getRect(), closestTime, closestNormal)) closestBrickIndex = static_cast<int>(i);
+        }
+
+        if (closestBrickIndex >= 0) {
+            ball.setNextCollision(sweep.pointAt(closestTime), closestNormal, closestBrickIndex);
+        }
+    }
+
+    /**
+     * @brief Traite l'impact confirmé avec une brique (après que la balle a géré la collision).
+     * @param brickIndex L'index de la brique qui a été touchée.
+     * @return Le score obtenu de la brique. 0 si la brique est invalide, inactive ou indestructible.
+     * @note Met à jour `m_activeBrickCount`.
+     */
+    int processBrickHit(int brickIndex) {
+        if (brickIndex < 0 || static_cast<size_t>(brickIndex) >= m_bricks.size()) {
+            return 0;
+        }
+        Brick& brick = m_bricks[brickIndex];
+        if (!brick.isActive()) {
+            return 0;
+        }
+
+        int scoreAwarded = brick.hit(); // This deactivates the brick and returns its score value
+
+        if (scoreAwarded > 0 && !brick.isIndestructible()) { // Check if it was a destructible brick that gave score
+            m_activeBrickCount = std::max(0, m_activeBrickCount - 1);
+            markCellChanged(brickIndex / m_cols, brickIndex % m_cols);
+        }
+        return scoreAwarded;
+    }
+
+    /**
+     * @brief Calcule le rectangle d'une cellule de la grille à l'écran.
+     * @param layout Position et dimensions de la grille.
+     * @param rows Nombre de rangées de la grille.
+     * @param row Rangée logique (0 en haut).
+     * @param col Colonne logique (0 à gauche).
+     */
+    static Rect cellRect(const GridLayout& layout, int rows, int row, int col) {
+        int visualRow = rows - 1 - row;
+        return { layout.startX + col * (layout.cellWidth + layout.spacing),
+                 layout.startY + visualRow * (layout.cellHeight + layout.spacing),
+                 layout.cellWidth, layout.cellHeight };
+    }
+
+    /**
+     * @brief Enregistre le dessin d'une seule cellule, en effaçant d'abord son emplacement avec la couleur de fond.
+     * @param queue Tampon de commandes de rendu.
+     * @param field Valeurs de score de la grille.
+     * @param layout Position et dimensions de la grille.
+     * @param cellIndex Index de la cellule (rangée * colonnes + colonne).
+     * @param editorView `true` pour dessiner aussi les cellules vides (grille de l'éditeur).
+     * @note Utilisée pour les mises à jour partielles de la couche statique.
+     */
+    static void renderCell(RenderQueue& queue, const BrickField& field, const GridLayout& layout, int cellIndex, bool editorView) {
+        int r = cellIndex / field.cols, c = cellIndex % field.cols;
+        Rect cell = cellRect(layout, field.rows, r, c);
+        int scoreValue = field.at(r, c);
+        queue.rect(cell, Config::COLOR_BG);
+        if (scoreValue != 0 || editorView) queue.rect(cell, Config::getBrickColorByScore(scoreValue));
+    }
+
+    /**
+     * @brief Enregistre le dessin de toutes les briques actives d'une grille publiée.
+     * @param queue Tampon de commandes de rendu.
+     * @param field Valeurs de score de la grille.
+     * @param layout Position et dimensions de la grille.
+     */
+    static void renderBricks(RenderQueue& queue, const BrickField& field, const GridLayout& layout) {
+        for (int r = 0; r < field.rows; ++r) {
+            for (int c = 0; c < field.cols; ++c) {
+                int scoreValue = field.at(r, c);
+                if (scoreValue != 0) queue.rect(cellRect(layout, field.rows, r, c), Config::getBrickColorByScore(scoreValue));
             }
         }
-        lines.push_back(currentLineStr); // Ajoute la dernière ligne
+    }
 
-        for (const std::string& line : lines) {
-            float lineWidth = getTextWidth(line, scale);
-            float lineStartX = x_center - (lineWidth / 2.0f);
-            float currentX = lineStartX;
+    /**
+     * @brief Nombre de cellules par côté des blocs dessinés par l'éditeur (1 : chaque cellule est dessinée).
+     * @note Lorsque les cellules mesurent moins de `Config::EDITOR_AGGREGATE_PIXELS` à l'écran, elles sont regroupées
+     *       en blocs carrés d'au moins cette taille : le nombre de rectangles dessinés est borné par la surface de la vue.
+     */
+    static int editorBlockSize(const GridLayout& layout) {
+        float pitch = std::min(layout.cellWidth, layout.cellHeight) + layout.spacing;
+        if (pitch >= Config::EDITOR_AGGREGATE_PIXELS) return 1;
+        return static_cast<int>(std::ceil(Config::EDITOR_AGGREGATE_PIXELS / std::max(pitch, 1e-6f)));
+    }
 
-            // Rendu de chaque ligne
-            for (char c_char : line) {
-                auto it = m_characters.find(c_char); 
-                if (it == m_characters.end()) { // Caractère non trouvé
-                    if (m_characters.count(' ')) { // Avance par la largeur d'un espace si disponible
-                         currentX += (m_characters.at(' ').advance >> 6) * scale;
+    /** @brief Découpe un rectangle à la zone visible de la grille (largeur ou hauteur nulle s'il est hors de la zone). */
+    static Rect clipToView(const Rect& rect, const GridLayout& layout) {
+        float x0 = std::max(rect.x, layout.view.x), y0 = std::max(rect.y, layout.view.y);
+        float x1 = std::min(rect.x + rect.width, layout.view.x + layout.view.width);
+        float y1 = std::min(rect.y + rect.height, layout.view.y + layout.view.height);
+        return { x0, y0, std::max(0.0f, x1 - x0), std::max(0.0f, y1 - y0) };
+    }
+
+    /** @brief Rectangle visible (découpé à la vue) d'un bloc de `blockSize` x `blockSize` cellules de l'éditeur. */
+    static Rect editorBlockRect(const GridLayout& layout, int rows, int cols, int blockSize, int blockRow, int blockCol) {
+        int row0 = blockRow * blockSize, col0 = blockCol * blockSize;
+        int row1 = std::min(rows, row0 + blockSize) - 1, col1 = std::min(cols, col0 + blockSize) - 1;
+        // Rangée logique la plus basse = bas du bloc à l'écran
+        Rect first = cellRect(layout, rows, row1, col0), last = cellRect(layout, rows, row0, col1);
+        return clipToView({ first.x, first.y, last.x + last.width - first.x, last.y + last.height - first.y }, layout);
+    }
+
+    /**
+     * @brief Calcule les rangées logiques [rowBegin, rowEnd) et colonnes [colBegin, colEnd) couvrant la zone visible de la grille.
+     * @return `false` si aucune cellule n'est visible.
+     */
+    static bool visibleCells(const GridLayout& layout, int rows, int cols, int& rowBegin, int& rowEnd, int& colBegin, int& colEnd) {
+        float pitchX = layout.cellWidth + layout.spacing, pitchY = layout.cellHeight + layout.spacing;
+        // Colonnes et rangées visuelles (0 en bas) couvrant la vue
+        colBegin = std::max(0, static_cast<int>(std::floor((layout.view.x - layout.startX) / pitchX)));
+        colEnd = std::min(cols, static_cast<int>(std::ceil((layout.view.x + layout.view.width - layout.startX) / pitchX)));
+        int visualBegin = std::max(0, static_cast<int>(std::floor((layout.view.y - layout.startY) / pitchY)));
+        int visualEnd = std::min(rows, static_cast<int>(std::ceil((layout.view.y + layout.view.height - layout.startY) / pitchY)));
+        rowBegin = rows - visualEnd;
+        rowEnd = rows - visualBegin;
+        return colBegin < colEnd && visualBegin < visualEnd;
+    }
+
+    /**
+     * @brief Dessine un bloc de `blockSize` x `blockSize` cellules de l'éditeur avec la couleur la plus fréquente du bloc
+     *        (parmi des cellules échantillonnées régulièrement pour les grands blocs).
+     * @param blockRow Rangée du bloc (rangées logiques `blockRow * blockSize` et suivantes).
+     * @param blockCol Colonne du bloc.
+     * @param clearFirst `true` pour effacer d'abord l'emplacement du bloc (mise à jour partielle de la couche statique).
+     */
+    static void renderEditorBlock(RenderQueue& queue, const BrickField& field, const GridLayout& layout, int blockSize,
+                                  int blockRow, int blockCol, bool clearFirst) {
+        int row0 = blockRow * blockSize, col0 = blockCol * blockSize;
+        int row1 = std::min(field.rows, row0 + blockSize) - 1, col1 = std::min(field.cols, col0 + blockSize) - 1;
+        int8_t score = field.at(row0, col0);
+        if (blockSize > 1) {
+            // Au plus EDITOR_BLOCK_SAMPLES x EDITOR_BLOCK_SAMPLES cellules échantillonnées par bloc : le coût ne dépend pas du zoom
+            int stride = std::max(1, blockSize / EDITOR_BLOCK_SAMPLES);
+            std::array<uint32_t, 9> counts{}; // Valeurs de score -1 à 7
+            for (int r = row0; r <= row1; r += stride) {
+                const int8_t* cells = field.cells.data() + static_cast<size_t>(r) * field.cols;
+                for (int c = col0; c <= col1; c += stride) ++counts[static_cast<size_t>(std::clamp<int>(cells[c], -1, 7) + 1)];
+            }
+            score = static_cast<int8_t>(std::max_element(counts.begin(), counts.end()) - counts.begin() - 1);
+        }
+        Rect block = editorBlockRect(layout, field.rows, field.cols, blockSize, blockRow, blockCol);
+        if (block.width <= 0.0f || block.height <= 0.0f) return;
+        if (clearFirst) queue.rect(block, Config::COLOR_BG);
+        queue.rect(block, Config::getBrickColorByScore(score));
+    }
+
+    /**
+     * @brief Enregistre le dessin de la grille de l'éditeur, montrant l'état de chaque cellule (y compris les cellules vides).
+     * @param queue Tampon de commandes de rendu.
+     * @param field Valeurs de score de la grille.
+     * @param layout Position et dimensions de la grille.
+     * @note Seules les cellules de la zone visible (`layout.view`) sont dessinées, regroupées en blocs si elles sont
+     *       plus petites qu'un pixel ou deux (`editorBlockSize`) : le coût suit la surface affichée, pas la taille de la grille.
+     */
+    static void renderEditorGrid(RenderQueue& queue, const BrickField& field, const GridLayout& layout) {
+        if (field.rows == 0 || field.cols == 0) return;
+        int blockSize = editorBlockSize(layout);
+        int rowBegin, rowEnd, colBegin, colEnd;
+        if (!visibleCells(layout, field.rows, field.cols, rowBegin, rowEnd, colBegin, colEnd)) return;
+        for (int blockRow = rowBegin / blockSize; blockRow * blockSize < rowEnd; ++blockRow) {
+            for (int blockCol = colBegin / blockSize; blockCol * blockSize < colEnd; ++blockCol) {
+                renderEditorBlock(queue, field, layout, blockSize, blockRow, blockCol, false);
+            }
+        }
+    }
+
+    /**
+     * @brief Enregistre la carte de chaleur par-dessus la grille de l'éditeur : une teinte du froid (bleu) au chaud (rouge)
+     *        par brique, magenta pour les briques jamais touchées.
+     * @param queue Tampon de commandes de rendu.
+     * @param heatmap Touches accumulées (rien n'est dessiné avant la première partie terminée, ni pour une autre version de la grille).
+     * @param field Valeurs de score de la grille de l'éditeur.
+     * @param layout Position et dimensions de la grille.
+     * @param mode HITS : part des parties où la brique est touchée (touches par partie en échelle logarithmique pour les
+     *        briques indestructibles) ; FIRST_HIT : délai moyen avant la première touche, les briques touchées tôt étant chaudes.
+     * @param atlas Texture de l'atlas de glyphes : les quads semi-transparents de l'atlas sont dessinés en un seul lot.
+     * @param solidUV Région pleine de l'atlas.
+     * @note Seules les cellules visibles sont dessinées. Un bloc de cellules regroupées prend la teinte de la brique
+     *       échantillonnée la plus chaude.
+     */
+    static void renderHeatmap(RenderQueue& queue, const HitHeatmap& heatmap, const BrickField& field, const GridLayout& layout,
+                              HeatmapMode mode, GLuint atlas, const Rect& solidUV) {
+        if (heatmap.games == 0 || heatmap.version != field.version || heatmap.rows != field.rows || heatmap.cols != field.cols) return;
+        int blockSize = editorBlockSize(layout);
+        int rowBegin, rowEnd, colBegin, colEnd;
+        if (!visibleCells(layout, field.rows, field.cols, rowBegin, rowEnd, colBegin, colEnd)) return;
+        const float games = static_cast<float>(heatmap.games);
+        const float logMaxHits = std::log1p(heatmap.maxIndestructibleHits / games);
+        auto heat = [&](size_t i) { // -1 : jamais touchée
+            if (heatmap.hitGames[i] == 0) return -1.0f;
+            if (mode == HeatmapMode::FIRST_HIT) {
+                return heatmap.maxFirstHitSeconds > 0.0f ? 1.0f - heatmap.averageFirstHit(i) / heatmap.maxFirstHitSeconds : 1.0f;
+            }
+            if (field.cells[i] != Config::SCORE_INDESTRUCTIBLE) return heatmap.hitGames[i] / games;
+            return logMaxHits > 0.0f ? std::log1p(heatmap.hits[i] / games) / logMaxHits : 1.0f;
+        };
+        int stride = std::max(1, blockSize / EDITOR_BLOCK_SAMPLES);
+        for (int blockRow = rowBegin / blockSize; blockRow * blockSize < rowEnd; ++blockRow) {
+            for (int blockCol = colBegin / blockSize; blockCol * blockSize < colEnd; ++blockCol) {
+                int row0 = blockRow * blockSize, col0 = blockCol * blockSize;
+                int row1 = std::min(field.rows, row0 + blockSize), col1 = std::min(field.cols, col0 + blockSize);
+                bool brick = false;
+                float hottest = -1.0f;
+                for (int r = row0; r < row1; r += stride) {
+                    for (int c = col0; c < col1; c += stride) {
+                        size_t i = static_cast<size_t>(r) * field.cols + c;
+                        if (field.cells[i] == 0) continue;
+                        brick = true;
+                        hottest = std::max(hottest, heat(i));
                     }
-                    continue;
                 }
-                const Character& ch = it->second;
-                
-                // Si c'est un espace ou si le caractère n'a pas de texture/taille visible, on avance juste
-                if (c_char == ' ' || ch.textureID == 0 || ch.sizeX == 0 || ch.sizeY == 0) { 
-                    currentX += (ch.advance >> 6) * scale; 
-                    continue; 
+                if (!brick) continue;
+                Rect block = editorBlockRect(layout, field.rows, field.cols, blockSize, blockRow, blockCol);
+                if (block.width <= 0.0f || block.height <= 0.0f) continue;
+                Config::Color color = Config::COLOR_HEATMAP_NEVER;
+                if (hottest >= 0.0f) {
+                    const Config::Color& cold = Config::COLOR_HEATMAP_COLD; const Config::Color& hot = Config::COLOR_HEATMAP_HOT;
+                    color = { cold.r + (hot.r - cold.r) * hottest, cold.g + (hot.g - cold.g) * hottest, cold.b + (hot.b - cold.b) * hottest };
                 }
-                
-                
-                float xpos = currentX + ch.bearingX * scale;
-                // La position Y est la ligne de base + (espaceY - hauteur_glyphe) * échelle
-                // car bearingY est la distance de la ligne de base au sommet du glyphe,
-                // et le quad est dessiné depuis son coin inférieur gauche.
-                float ypos = currentY + (ch.bearingY - ch.sizeY) * scale; 
-                float w = ch.sizeX * scale; 
-                float h = ch.sizeY * scale;
-                
-                glBindTexture(GL_TEXTURE_2D, ch.textureID);
-                glBegin(GL_QUADS);
-                // Attention : les coordonnées de texture Y sont souvent inversées par rapport à OpenGL.
-                // FreeType rend avec Y=0 en haut du glyphe. Si on charge avec stbi_set_flip_vertically_on_load(true)
-                // pour les textures normales, ici il faut être cohérent.
-                // Les glyphes FreeType sont généralement générés avec l'origine en bas à gauche du bitmap.
-                // Ici, le quad est défini avec (xpos, ypos) comme coin inférieur gauche.
-                glTexCoord2f(0.0f, 0.0f); glVertex2f(xpos, ypos + h);
-                glTexCoord2f(1.0f, 0.0f); glVertex2f(xpos + w, ypos + h);
-                glTexCoord2f(1.0f, 1.0f); glVertex2f(xpos + w, ypos);
-                glTexCoord2f(0.0f, 1.0f); glVertex2f(xpos, ypos);
-                glEnd();
-                
-                currentX += (ch.advance >> 6) * scale; // Avance pour le prochain caractère
+                queue.atlasQuad(block, solidUV, atlas, color, Config::HEATMAP_ALPHA, RenderLayer::WORLD);
+            }
+        }
+    }
+
+    /**
+     * @brief Enregistre le dessin des cellules modifiées de l'éditeur (mise à jour partielle de la couche statique).
+     * @param queue Tampon de commandes de rendu.
+     * @param field Valeurs de score de la grille.
+     * @param layout Position et dimensions de la grille.
+     * @param changedCells Index des cellules modifiées.
+     * @note Lorsque les cellules sont regroupées en blocs, chaque bloc touché est recalculé une seule fois.
+     */
+    static void renderEditorCells(RenderQueue& queue, const BrickField& field, const GridLayout& layout, const std::vector<int>& changedCells) {
+        int blockSize = editorBlockSize(layout);
+        int blockCols = (field.cols + blockSize - 1) / blockSize;
+        std::vector<int> blocks;
+        blocks.reserve(changedCells.size());
+        for (int cell : changedCells) blocks.push_back((cell / field.cols / blockSize) * blockCols + (cell % field.cols) / blockSize);
+        std::sort(blocks.begin(), blocks.end());
+        blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+        for (int block : blocks) renderEditorBlock(queue, field, layout, blockSize, block / blockCols, block % blockCols, true);
+    }
+
+    /**
+     * @brief Gère la sélection d'une cellule par clic gauche en mode éditeur.
+     * @param mouseX Coordonnée X de la souris.
+     * @param mouseY Coordonnée Y de la souris.
+     * @return 1 si la sélection a changé (nouvelle cellule sélectionnée ou désélection), 0 sinon.
+     * @note La cellule est trouvée en O(1) à partir de la disposition zoomée ; un clic hors de la zone visible désélectionne.
+     * @note Met à jour `m_editorSelectedRow` et `m_editorSelectedCol`. La sélection précédente devient l'ancre
+     *       (`m_editorAnchorRow`, `m_editorAnchorCol`) : deux clics délimitent un rectangle ou un segment.
+     */
+    int handleEditorLeftClickSelection(float mouseX, float mouseY) {
+        if (mouseX < m_gridStartX || mouseX > m_gridStartX + m_gridTotalWidth ||
+            mouseY < m_gridStartY || mouseY > m_gridStartY + m_gridTotalHeight ||
+            mouseX < m_gridView.x || mouseX > m_gridView.x + m_gridView.width ||
+            mouseY < m_gridView.y || mouseY > m_gridView.y + m_gridView.height) {
+             if (m_editorSelectedRow != -1 || m_editorSelectedCol != -1) {
+                 m_editorSelectedRow = -1;
+                 m_editorSelectedCol = -1;
+                 return 1;
+             }
+             return 0;
+        }
+
+        float cellWidthWithSpacing = m_cellWidth + m_cellSpacing;
+        float cellHeightWithSpacing = m_cellHeight + m_cellSpacing;
+
+        int visualCol = static_cast<int>((mouseX - m_gridStartX) / cellWidthWithSpacing);
+        int visualRow = static_cast<int>((mouseY - m_gridStartY) / cellHeightWithSpacing);
+
+        visualCol = std::clamp(visualCol, 0, m_cols - 1);
+        visualRow = std::clamp(visualRow, 0, m_rows - 1);
+
+        // Convertit la rangée visuelle (0=bas) en rangée logique (0=haut) pour `m_gridState`
+        int logicalRow = m_rows - 1 - visualRow;
+        int logicalCol = visualCol; 
+
+        float brickX = m_gridStartX + logicalCol * cellWidthWithSpacing;
+        float brickY = m_gridStartY + visualRow * cellHeightWithSpacing;
+
+        if (mouseX >= brickX && mouseX <= brickX + m_cellWidth &&
+            mouseY >= brickY && mouseY <= brickY + m_cellHeight)
+        {
+            if (m_editorSelectedRow != logicalRow || m_editorSelectedCol != logicalCol) {
+                // La sélection précédente devient l'ancre des outils de zone
+                m_editorAnchorRow = hasEditorSelection() ? m_editorSelectedRow : logicalRow;
+                m_editorAnchorCol = hasEditorSelection() ? m_editorSelectedCol : logicalCol;
+                m_editorSelectedRow = logicalRow;
+                m_editorSelectedCol = logicalCol;
+                return 1;
+            }
+            return 0;
+        } else {
+            if (m_editorSelectedRow != -1 || m_editorSelectedCol != -1) {
+                m_editorSelectedRow = -1;
+                m_editorSelectedCol = -1;
+                return 1;
+            }
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Applique un outil de l'éditeur à la sélection (clic droit, ou Suppr avec le pinceau vide).
+     * @param tool Outil : cellule sélectionnée, rectangle ou segment entre l'ancre et la sélection, remplissage de zone.
+     * @param brush Valeur de score posée, ou `BRUSH_BY_ROW` pour la couleur de la rangée (comme le placement d'une brique).
+     * @return Le nombre de cellules modifiées (0 sans sélection ou si rien ne change).
+     * @note L'opération forme un seul groupe de l'historique d'annulation. Le rectangle et le remplissage écrivent
+     *       la grille par segments de rangée (`std::fill`) : remplir un million de cellules est instantané.
+     */
+    size_t applyEditorTool(EditorTool tool, int brush) {
+        if (!hasEditorSelection() || (brush != BRUSH_BY_ROW && !Config::isValidScore(brush))) return 0;
+        if (!hasEditorAnchor()) {
+            m_editorAnchorRow = m_editorSelectedRow;
+            m_editorAnchorCol = m_editorSelectedCol;
+        }
+        m_history.beginGroup();
+        switch (tool) {
+            case EditorTool::PLACE: setCell(m_editorSelectedRow, m_editorSelectedCol, brushValue(brush, m_editorSelectedRow)); break;
+            case EditorTool::RECTANGLE: fillRect(brush); break;
+            case EditorTool::LINE: drawLine(brush); break;
+            case EditorTool::FILL: floodFill(brush); break;
+        }
+        size_t changedCount = m_history.openGroupCellCount();
+        m_history.endGroup();
+        return changedCount;
+    }
+
+    /**
+     * @brief Copie le rectangle entre l'ancre et la sélection dans le presse-papiers de l'éditeur.
+     * @return Le nombre de cellules copiées (0 sans sélection).
+     */
+    size_t copySelection() {
+        if (!hasEditorSelection()) return 0;
+        if (!hasEditorAnchor()) {
+            m_editorAnchorRow = m_editorSelectedRow;
+            m_editorAnchorCol = m_editorSelectedCol;
+        }
+        int top = std::min(m_editorAnchorRow, m_editorSelectedRow), left = std::min(m_editorAnchorCol, m_editorSelectedCol);
+        m_clipboardRows = std::abs(m_editorAnchorRow - m_editorSelectedRow) + 1;
+        m_clipboardCols = std::abs(m_editorAnchorCol - m_editorSelectedCol) + 1;
+        m_clipboard.resize(static_cast<size_t>(m_clipboardRows) * m_clipboardCols);
+        for (int r = 0; r < m_clipboardRows; ++r) {
+            const int8_t* source = m_gridState.data() + static_cast<size_t>(top + r) * m_cols + left;
+            std::copy(source, source + m_clipboardCols, m_clipboard.data() + static_cast<size_t>(r) * m_clipboardCols);
+        }
+        return m_clipboard.size();
+    }
+
+    /**
+     * @brief Colle le presse-papiers avec son coin supérieur gauche sur la cellule sélectionnée (tampon de motif).
+     * @return Le nombre de cellules modifiées. Le motif est tronqué aux bords de la grille.
+     */
+    size_t pasteClipboard() {
+        if (!hasEditorSelection() || m_clipboard.empty()) return 0;
+        int rows = std::min(m_clipboardRows, m_rows - m_editorSelectedRow);
+        int cols = std::min(m_clipboardCols, m_cols - m_editorSelectedCol);
+        m_history.beginGroup();
+        for (int r = 0; r < rows; ++r) {
+            copySpan(m_editorSelectedRow + r, m_editorSelectedCol, cols, m_clipboard.data() + static_cast<size_t>(r) * m_clipboardCols);
+        }
+        size_t changedCount = m_history.openGroupCellCount();
+        m_history.endGroup();
+        return changedCount;
+    }
+
+    /** @brief Indique si le presse-papiers de l'éditeur contient un motif. */
+    bool hasClipboard() const { return !m_clipboard.empty(); }
+
+    /**
+     * @brief Annule la dernière opération de l'éditeur.
+     * @return Le nombre de cellules restaurées (0 si l'historique est vide).
+     */
+    size_t undo() { return applyHistory(true); }
+
+    /**
+     * @brief Rétablit la dernière opération annulée de l'éditeur.
+     * @return Le nombre de cellules modifiées (0 s'il n'y a rien à rétablir).
+     */
+    size_t redo() { return applyHistory(false); }
+
+    /** @brief Indique si une opération de l'éditeur peut être annulée. */
+    bool canUndo() const { return m_history.canUndo(); }
+
+    /** @brief Indique si une opération annulée peut être rétablie. */
+    bool canRedo() const { return m_history.canRedo(); }
+
+    /** @brief Vérifie s'il y a une cellule sélectionnée en mode éditeur. */
+    bool hasEditorSelection() const {
+        return m_editorSelectedRow >= 0 && m_editorSelectedRow < m_rows &&
+               m_editorSelectedCol >= 0 && m_editorSelectedCol < m_cols;
+    }
+
+    /**
+     * @brief Enregistre un contour de surbrillance autour de la cellule sélectionnée en mode éditeur.
+     * @param queue Tampon de commandes de rendu.
+     * @param layout Position et dimensions de la grille.
+     * @param rows Nombre de rangées de la grille.
+     * @param row Rangée logique sélectionnée (-1 si aucune sélection).
+     * @param col Colonne logique sélectionnée (-1 si aucune sélection).
+     */
+    static void highlightEditorCell(RenderQueue& queue, const GridLayout& layout, int rows, int row, int col) {
+        if (row < 0 || col < 0) return;
+        Rect cell = cellRect(layout, rows, row, col);
+        Rect visible = clipToView(cell, layout);
+        if (visible.width <= 0.0f || visible.height <= 0.0f) return;
+        float outlinePadding = 2.0f;
+        Rect outline = { cell.x - outlinePadding, cell.y - outlinePadding,
+                         cell.width + 2.0f * outlinePadding, cell.height + 2.0f * outlinePadding };
+        queue.lineLoop(outline, 2.5f, Config::COLOR_EDITOR_SELECT);
+    }
+
+    /**
+     * @brief Enregistre le contour du rectangle entre l'ancre et la sélection (zone des outils Rectangle, Ligne et Copier).
+     * @param queue Tampon de commandes de rendu.
+     * @param layout Position et dimensions de la grille.
+     * @param rows Nombre de rangées de la grille.
+     * @param anchorRow Rangée logique de l'ancre (-1 si aucune).
+     * @param anchorCol Colonne logique de l'ancre (-1 si aucune).
+     * @param row Rangée logique sélectionnée (-1 si aucune sélection).
+     * @param col Colonne logique sélectionnée (-1 si aucune sélection).
+     * @note Rien n'est dessiné si l'ancre est la cellule sélectionnée.
+     */
+    static void highlightEditorRegion(RenderQueue& queue, const GridLayout& layout, int rows, int anchorRow, int anchorCol, int row, int col) {
+        if (anchorRow < 0 || anchorCol < 0 || row < 0 || col < 0 || (anchorRow == row && anchorCol == col)) return;
+        // Rangée logique la plus basse = coin inférieur gauche à l'écran (rangée visuelle 0 en bas)
+        Rect first = cellRect(layout, rows, std::max(anchorRow, row), std::min(anchorCol, col));
+        Rect last = cellRect(layout, rows, std::min(anchorRow, row), std::max(anchorCol, col));
+        float outlinePadding = 4.0f;
+        Rect outline = { first.x - outlinePadding, first.y - outlinePadding,
+                         last.x + last.width - first.x + 2.0f * outlinePadding, last.y + last.height - first.y + 2.0f * outlinePadding };
+        queue.lineLoop(outline, 1.5f, Config::COLOR_EDITOR_ANCHOR);
+    }
+
+    /** @brief Obtient la version actuelle du niveau (incrémentée à chaque modification). */
+    uint64_t getVersion() const { return m_version; }
+
+    /** @brief Retourne le nombre de tests balle/brique effectués depuis l'appel précédent et remet le compteur à zéro. */
+    uint32_t takeCollisionTests() { uint32_t tests = m_collisionTests; m_collisionTests = 0; return tests; }
+
+    /** @brief Obtient la position et les dimensions de la grille à l'écran. */
+    GridLayout getLayout() const {
+        return { m_gridStartX, m_gridStartY, m_gridTotalWidth, m_gridTotalHeight, m_cellWidth, m_cellHeight, m_cellSpacing, m_gridView };
+    }
+
+    /** @brief Obtient le nombre de rangées de la grille. */
+    int getRows() const { return m_rows; }
+
+    /** @brief Obtient le nombre de colonnes de la grille. */
+    int getCols() const { return m_cols; }
+
+    /** @brief Obtient les valeurs de score de la grille, rangée par rangée. */
+    const std::vector<int8_t>& getCells() const { return m_gridState; }
+
+    /**
+     * @brief Valeur de score par défaut d'une rangée : rouge, orange, vert puis jaune, chaque couleur occupant un quart de la grille.
+     * @param row Rangée logique (0 en haut).
+     * @param rows Nombre de rangées de la grille.
+     */
+    static int defaultScoreForRow(int row, int rows) {
+        switch (row * 4 / std::max(1, rows)) {
+            case 0:  return Config::SCORE_RED;
+            case 1:  return Config::SCORE_ORANGE;
+            case 2:  return Config::SCORE_GREEN;
+            default: return Config::SCORE_YELLOW;
+        }
+    }
+
+    /**
+     * @brief Remplace la grille par des cellules déjà lues et vérifiées, sans copie (rechargement à chaud).
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score valides, rangée par rangée (le tampon est repris).
+     * @note La sélection de l'éditeur est conservée si elle reste dans la grille. Les briques doivent être recréées
+     *       (`setupBricks`) avant de reprendre une partie. L'historique d'annulation est vidé.
+     */
+    void replaceCells(int rows, int cols, std::vector<int8_t>&& cells) {
+        m_rows = rows;
+        m_cols = cols;
+        m_gridState = std::move(cells);
+        m_bricks.clear();
+        m_history.clear();
+        if (m_editorSelectedRow >= m_rows || m_editorSelectedCol >= m_cols) {
+            m_editorSelectedRow = -1;
+            m_editorSelectedCol = -1;
+        }
+        markAllChanged();
+    }
+
+    /**
+     * @brief Copie les valeurs de score de la grille dans un `BrickField`.
+     * @param out Grille de destination.
+     * @param editorView `true` pour copier la grille de l'éditeur (`m_gridState`), `false` pour copier les briques encore actives en jeu.
+     */
+    void copyBrickField(BrickField& out, bool editorView) const {
+        out.rows = m_rows;
+        out.cols = m_cols;
+        out.version = m_version;
+        if (editorView) { out.cells.assign(m_gridState.begin(), m_gridState.end()); return; }
+        out.cells.resize(m_gridState.size());
+        bool bricksReady = m_bricks.size() == m_gridState.size();
+        for (size_t i = 0; i < m_gridState.size(); ++i) {
+            out.cells[i] = static_cast<int8_t>((bricksReady && m_bricks[i].isActive()) ? m_bricks[i].getScoreValue() : 0);
+        }
+    }
+
+    /**
+     * @brief Récupère et réinitialise la liste des cellules modifiées depuis le dernier appel.
+     * @param outCells Index des cellules modifiées (vide si `outAll` vaut `true`).
+     * @param outAll `true` si toute la grille doit être considérée comme modifiée.
+     */
+    void takeChanges(std::vector<int>& outCells, bool& outAll) {
+        outAll = m_allChanged;
+        outCells.clear();
+        if (!m_allChanged) outCells.swap(m_changedCells);
+        m_changedCells.clear();
+        m_allChanged = false;
+    }
+
+    /** @brief Obtient le nombre de briques destructibles actives. */
+    int getActiveBrickCount() const { return m_activeBrickCount; }
+
+    /** @brief Obtient les briques de la partie (une par cellule, ligne par ligne, y compris les cellules vides). */
+    const std::vector<Brick>& getBricks() const { return m_bricks; }
+
+    /** @brief Vérifie si toutes les briques destructibles ont été éliminées. */
+    bool areAllBricksCleared() const { return m_activeBrickCount <= 0; }
+
+    /** @brief Obtient la valeur de score de la brique actuellement sélectionnée dans l'éditeur. */
+    int getSelectedBrickScore() const {
+        if (hasEditorSelection()) return cell(m_editorSelectedRow, m_editorSelectedCol);
+        return 0;
+    }
+
+    /** @brief Obtient l'index de la ligne (logique) de la brique sélectionnée dans l'éditeur. */
+    int getSelectedRow() const { return m_editorSelectedRow; }
+    
+    /** @brief Obtient l'index de la colonne (logique) de la brique sélectionnée dans l'éditeur. */
+    int getSelectedCol() const { return m_editorSelectedCol; }
+
+    /** @brief Obtient la rangée de l'ancre de l'éditeur (-1 si aucune). */
+    int getAnchorRow() const { return hasEditorAnchor() ? m_editorAnchorRow : -1; }
+
+    /** @brief Obtient la colonne de l'ancre de l'éditeur (-1 si aucune). */
+    int getAnchorCol() const { return hasEditorAnchor() ? m_editorAnchorCol : -1; }
+    
+    /**
+      * @brief Modifie directement l'état d'une cellule dans la grille `m_gridState`.
+      * @param row Index de la rangée logique (0 en haut).
+      * @param col Index de la colonne logique (0 à gauche).
+      * @param scoreValue La nouvelle valeur de score pour la cellule. Doit être valide.
+      */
+    void setGridState(int row, int col, int scoreValue) {
+        if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
+            if (Config::isValidScore(scoreValue)) {
+               cell(row, col) = static_cast<int8_t>(scoreValue);
+            } else {
+                std::cerr << "Warning: Attempted to set invalid score " << scoreValue << " at [" << row << "," << col << "]" << std::endl;
+                cell(row, col) = 0;
             }
-            currentY -= lineHeight; // Déplace la ligne de base vers le bas pour la ligne suivante
+            markCellChanged(row, col);
         }
-        glBindTexture(GL_TEXTURE_2D, 0); glDisable(GL_TEXTURE_2D); glDisable(GL_BLEND);
     }
 };
 
 /**
-* @class Paddle
-* @brief Représente la raquette contrôlée par le joueur.
-* @param m_rect Rectangle définissant la position et la taille de la raquette.
-* @param m_color Couleur de la raquette.
-*/
-class Paddle {
-private:
-    Rect m_rect; 
-    Config::Color m_color;
+ * @class LevelPack
+ * @brief Archive de niveaux : un index de taille fixe par niveau, lisible sans lire les grilles, et des grilles chargées à la demande.
+ *
+ * Disposition du fichier (petit-boutiste) :
+ * - un en-tête (`Header`) qui pointe vers le premier bloc d'index ;
+ * - des blocs d'index chaînés (`IndexBlock`), chacun de `ENTRIES_PER_BLOCK` entrées de taille fixe (`Entry`) :
+ *   nom, dimensions, position et taille de la grille, somme de contrôle, nombre de briques destructibles et vignette ;
+ * - les grilles elles-mêmes, au format des cellules de `LevelFile` (un octet signé par cellule).
+ *
+ * Un ajout écrit la grille (et, si le dernier bloc est plein, un nouveau bloc d'index) à la fin du fichier, remplit
+ * l'entrée libre suivante, puis seulement incrémente le compteur du bloc : le reste de l'archive n'est jamais réécrit,
+ * et une écriture interrompue laisse l'index dans son état précédent.
+ *
+ * @param m_file Archive projetée en mémoire (les grilles ne sont lues qu'au chargement d'un niveau).
+ * @param m_filename Chemin de l'archive ouverte.
+ * @param m_entries Copie de l'index, dans l'ordre des ajouts.
+ */
+class LevelPack {
 public:
-    Paddle() : m_color(Config::COLOR_PADDLE) { m_rect.width = Config::PADDLE_WIDTH; m_rect.height = Config::PADDLE_HEIGHT; }
-    
-    /** @brief Initialise la position de la raquette. */
-    void init(float windowWidth, float windowHeight) { 
-        m_rect.x = (windowWidth - m_rect.width) / 2.0f; 
-        m_rect.y = windowHeight * 0.1f; 
-    }
+    static constexpr char MAGIC[4] = { 'B', 'R', 'K', 'P' };
+    static constexpr char INDEX_MAGIC[4] = { 'B', 'R', 'K', 'I' };
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t ENTRIES_PER_BLOCK = 256;
+    static constexpr int THUMBNAIL_ROWS = 8;
+    static constexpr int THUMBNAIL_COLS = 16;
+
+    /** @brief En-tête de l'archive. */
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t entriesPerBlock;
+        uint32_t entrySize;
+        uint64_t firstIndexBlock;
+        uint64_t reserved;
+    };
+    static_assert(sizeof(Header) == 32, "LevelPack::Header must stay 32 bytes");
 
-    /** @brief Réinitialise la position horizontale de la raquette au centre. */
-    void resetPosition(float windowWidth) { 
-        m_rect.x = (windowWidth - m_rect.width) / 2.0f; 
-    }
+    /** @brief En-tête d'un bloc d'index, suivi de `entriesPerBlock` entrées. */
+    struct IndexBlock {
+        char magic[4];
+        uint32_t count;
+        uint64_t next;
+    };
+    static_assert(sizeof(IndexBlock) == 16, "LevelPack::IndexBlock must stay 16 bytes");
+
+    /** @brief Entrée d'index d'un niveau. La vignette contient une valeur de score par zone de la grille (la plus fréquente). */
+    struct Entry {
+        char name[64];
+        uint32_t rows;
+        uint32_t cols;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t checksum;
+        uint32_t destructibleCount;
+        uint32_t reserved;
+        int8_t thumbnail[THUMBNAIL_ROWS * THUMBNAIL_COLS];
+        uint8_t padding[24];
+
+        /** @brief Obtient le nom du niveau. */
+        std::string getName() const { return std::string(name, strnlen(name, sizeof(name))); }
+    };
+    static_assert(sizeof(Entry) == 256, "LevelPack::Entry must stay 256 bytes");
 
-    /** @brief Met à jour la position de la raquette en fonction des entrées et des limites de la fenêtre. */
-    void update(float dt, const InputManager& input, float windowWidth) {
-        float mouseX = input.getMouseX(); m_rect.x = mouseX - m_rect.width / 2.0f;
-        m_rect.x = std::clamp(m_rect.x, 0.0f, windowWidth - m_rect.width);
-    }
+private:
+    MappedFile m_file;
+    std::string m_filename;
+    std::vector<Entry> m_entries;
 
-    /** @brief Dessine la raquette. */
-    void render() const { Utils::drawRect(m_rect, m_color); }
+    /** @brief Taille d'un bloc d'index complet en octets. */
+    static constexpr size_t blockSize() { return sizeof(IndexBlock) + ENTRIES_PER_BLOCK * sizeof(Entry); }
 
-    /** @brief Obtient la coordonnée X de la raquette. */
-    float getX() const { return m_rect.x; } 
-    
-    /** @brief Obtient la coordonnée Y de la raquette. */
-    float getY() const { return m_rect.y; }
-    
-    /** @brief Obtient la largeur de la raquette. */
-    float getWidth() const { return m_rect.width; } 
-    
-    /** @breif Obtient la hauteur de la raquette. */
-    float getHeight() const { return m_rect.height; }
-    
-    /** @brief Obtient le rectangle de la raquette. */
-    const Rect& getRect() const { return m_rect; }
-    
-    /** @brief Définit la position de la raquette. */
-    void setPosition(float x, float y) { m_rect.x = x; m_rect.y = y; } 
-    
-    /** @brief Définit la couleur de la raquette. */
-    void setColor(const Config::Color& color) { m_color = color; }
-};
+    /**
+     * @brief Construit l'entrée d'index d'une grille.
+     * @note La vignette et le nombre de briques destructibles sont calculés en un seul passage sur les cellules.
+     */
+    static Entry makeEntry(const std::string& name, int rows, int cols, const int8_t* cells, uint64_t offset) {
+        Entry entry{};
+        std::strncpy(entry.name, name.c_str(), sizeof(entry.name) - 1);
+        entry.rows = static_cast<uint32_t>(rows);
+        entry.cols = static_cast<uint32_t>(cols);
+        entry.offset = offset;
+        entry.size = static_cast<uint64_t>(rows) * cols;
+        entry.checksum = LevelFile::checksum(reinterpret_cast<const uint8_t*>(cells), entry.size);
+
+        // Histogramme des valeurs de score par zone de la vignette (index = score + 1, de -1 à 7)
+        constexpr int SCORE_SLOTS = Config::SCORE_RED + 2;
+        std::vector<std::array<uint32_t, SCORE_SLOTS>> histograms(THUMBNAIL_ROWS * THUMBNAIL_COLS);
+        for (int r = 0; r < rows; ++r) {
+            const int8_t* row = cells + static_cast<size_t>(r) * cols;
+            std::array<uint32_t, SCORE_SLOTS>* histogramRow = histograms.data() + (r * THUMBNAIL_ROWS / rows) * THUMBNAIL_COLS;
+            for (int c = 0; c < cols; ++c) {
+                int score = Config::isValidScore(row[c]) ? row[c] : 0;
+                if (score > 0) ++entry.destructibleCount;
+                histogramRow[c * THUMBNAIL_COLS / cols][score + 1]++;
+            }
+        }
+        for (int i = 0; i < THUMBNAIL_ROWS * THUMBNAIL_COLS; ++i) {
+            const auto& histogram = histograms[i];
+            int best = static_cast<int>(std::max_element(histogram.begin(), histogram.end()) - histogram.begin());
+            if (histogram[best] > 0) {
+                entry.thumbnail[i] = static_cast<int8_t>(best - 1);
+            } else { // Grille plus petite que la vignette : la zone ne couvre aucune cellule, on échantillonne
+                int8_t score = cells[static_cast<size_t>(i / THUMBNAIL_COLS * rows / THUMBNAIL_ROWS) * cols + (i % THUMBNAIL_COLS) * cols / THUMBNAIL_COLS];
+                entry.thumbnail[i] = Config::isValidScore(score) ? score : 0;
+            }
+        }
+        return entry;
+    }
 
-/**
-* @class Ball
-* @brief Représente la balle du jeu.
-* @param m_pos Position actuelle du centre de la balle.
-* @param m_velocity Vitesse actuelle de la balle (déplacement par seconde).
-* @param m_preservedvelocity Vitesse de la balle conservée après la perte d'une vie, pour le prochain lancement.
-* @param m_nextCollisionPos Position du centre de la balle au moment de la prochaine collision anticipée.
-* @param m_hasPendingCollision Booléen indiquant si une collision avec une brique est anticipée.
-* @param m_radius Rayon de la balle.
-* @param m_color Couleur de la balle.
-* @param m_pendingCollisionNormal Normale de la surface de collision pour la prochaine collision anticipée.
-* @param m_pendingHitBrickIndex Index de la brique qui sera touchée lors de la prochaine collision anticipée.
-*/
-class Ball {
-    private:
-        Vec2 m_pos; 
-        Vec2 m_velocity;
-        Vec2 m_preservedvelocity;
-        Vec2 m_nextCollisionPos;
-        bool m_hasPendingCollision = false;
-        float m_radius; 
-        Config::Color m_color;
-        Vec2 m_pendingCollisionNormal; 
-        int m_pendingHitBrickIndex = -1; 
-    public:
-        Ball() : m_radius(Config::BALL_RADIUS), m_color(Config::COLOR_BALL) {}
-        
-        /** 
-         * @brief Initialise la position et la vitesse de la balle.
-         * @param startX Position X initiale.
-         * @param startY Position Y initiale.
-         * @param initialVelX Composante X de la vitesse initiale.
-         * @param initialVelY Composante Y de la vitesse initiale.
-         */
-        void init(float startX, float startY, float initialVelX, float initialVelY) { 
-            m_pos = {startX, startY}; 
-            m_velocity = {initialVelX, initialVelY}; 
-            clearPendingCollision(); // Reset collision state
+public:
+    /**
+     * @brief Ouvre une archive et lit son index (aucune grille n'est lue).
+     * @param filename Chemin de l'archive.
+     * @return `true` si l'archive a pu être ouverte. Les entrées incohérentes avec la taille du fichier sont ignorées.
+     */
+    bool open(const std::string& filename) {
+        PROFILE_ZONE("LevelPack::open");
+        m_entries.clear();
+        m_filename = filename;
+        if (!m_file.open(filename)) {
+            std::cerr << "Error: Could not open level pack " << filename << "." << std::endl;
+            return false;
+        }
+        const uint8_t* data = m_file.data();
+        size_t size = m_file.size();
+        Header header;
+        if (size < sizeof(Header) || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+            std::cerr << "Error: " << filename << " is not a level pack." << std::endl;
+            m_file.close();
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(Header));
+        if (header.version == 0 || header.version > VERSION || header.entriesPerBlock != ENTRIES_PER_BLOCK || header.entrySize != sizeof(Entry)) {
+            std::cerr << "Error: Unsupported level pack version or layout in " << filename << "." << std::endl;
+            m_file.close();
+            return false;
         }
 
-        /** 
-         * @brief Réinitialise la balle à une position et vitesse données.
-         * @param startX Position X de départ.
-         * @param startY Position Y de départ.
-         * @param initialVelX Composante X de la vitesse initiale.
-         * @param initialVelY Composante Y de la vitesse initiale.
-         */
-        void reset(float startX, float startY, float initialVelX, float initialVelY) { 
-            init(startX, startY, initialVelX, initialVelY); 
+        uint64_t blockOffset = header.firstIndexBlock;
+        size_t maxBlocks = size / blockSize();
+        for (size_t blocks = 0; blockOffset != 0 && blocks < maxBlocks; ++blocks) {
+            if (blockOffset > size - blockSize()) { std::cerr << "Warning: Truncated index block in " << filename << "." << std::endl; break; }
+            IndexBlock block;
+            std::memcpy(&block, data + blockOffset, sizeof(IndexBlock));
+            if (std::memcmp(block.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || block.count > ENTRIES_PER_BLOCK) {
+                std::cerr << "Warning: Corrupt index block in " << filename << "." << std::endl;
+                break;
+            }
+            const uint8_t* entries = data + blockOffset + sizeof(IndexBlock);
+            for (uint32_t i = 0; i < block.count; ++i) {
+                Entry entry;
+                std::memcpy(&entry, entries + i * sizeof(Entry), sizeof(Entry));
+                bool valid = entry.rows > 0 && entry.cols > 0 && entry.rows <= static_cast<uint32_t>(Config::LEVEL_MAX_DIMENSION) &&
+                             entry.cols <= static_cast<uint32_t>(Config::LEVEL_MAX_DIMENSION) &&
+                             entry.size == static_cast<uint64_t>(entry.rows) * entry.cols &&
+                             entry.offset <= size && entry.size <= size - entry.offset;
+                if (valid) m_entries.push_back(entry);
+                else std::cerr << "Warning: Skipping invalid entry '" << entry.getName() << "' in " << filename << "." << std::endl;
+            }
+            blockOffset = block.next;
         }
-    
-        /**
-         * @brief Met à jour la position de la balle et gère les collisions avec les murs et les briques (via le mécanisme de collision en attente).
-         * @param dt Delta-temps, temps écoulé depuis la dernière trame.
-         * @param windowWidth Largeur de la fenêtre de jeu.
-         * @param windowHeight Hauteur de la fenêtre de jeu.
-         * @param gridMinX Coordonnée X minimale de la zone de jeu (bord gauche de la grille de briques).
-         * @param gridMaxX Coordonnée X maximale de la zone de jeu (bord droit de la grille de briques).
-         * @return L'index de la brique touchée si une collision en attente a été résolue, sinon -1.
-         */
-        int update(float dt, float windowWidth, float windowHeight, float gridMinX, float gridMaxX) {
-            int brickHitThisFrame = -1;
-            Vec2 oldPos = m_pos;
+        return true;
+    }
 
-            m_pos.x += m_velocity.x * dt;
-            m_pos.y += m_velocity.y * dt;
-            
-            // Si une collision est en attente
-            if (m_hasPendingCollision) {
-                Vec2 travelVec = {m_pos.x - oldPos.x, m_pos.y - oldPos.y};
-                Vec2 targetVec = {m_nextCollisionPos.x - oldPos.x, m_nextCollisionPos.y - oldPos.y};
-                float travelLenSq = travelVec.x*travelVec.x + travelVec.y*travelVec.y;
-                float targetLenSq = targetVec.x*targetVec.x + targetVec.y*targetVec.y;
+    /** @brief Obtient le nombre de niveaux de l'archive. */
+    int size() const { return static_cast<int>(m_entries.size()); }
 
-                // Petite tolérance pour les comparaisons flottantes
-                float epsilonSq = 0.01f * 0.01f;
-                // Vérifie si la distance parcourue est suffisante pour atteindre ou dépasser le point de collision 
-                bool reachedTargetDistance = (travelLenSq >= targetLenSq - epsilonSq && targetLenSq > epsilonSq);
-                
-                Vec2 vecFromNewPosToCollisionPoint = {m_nextCollisionPos.x - m_pos.x, m_nextCollisionPos.y - m_pos.y};
-                float dotWithVelocity = vecFromNewPosToCollisionPoint.x * m_velocity.x + vecFromNewPosToCollisionPoint.y * m_velocity.y;
-                bool passedTargetPlane = (dotWithVelocity <= 0 && targetLenSq > epsilonSq);
+    /** @brief Obtient l'entrée d'index d'un niveau. */
+    const Entry& entry(int index) const { return m_entries[index]; }
 
-                if (reachedTargetDistance || passedTargetPlane) {
-                    m_pos = m_nextCollisionPos;
+    /** @brief Obtient le chemin de l'archive ouverte. */
+    const std::string& getFilename() const { return m_filename; }
 
-                    brickHitThisFrame = m_pendingHitBrickIndex;
-                
-                    float dot_product = m_velocity.x * m_pendingCollisionNormal.x + m_velocity.y * m_pendingCollisionNormal.y;
-                    m_velocity.x -= 2 * dot_product * m_pendingCollisionNormal.x;
-                    m_velocity.y -= 2 * dot_product * m_pendingCollisionNormal.y;
- 
-                    float safetyOffset = 0.01f;
-                    m_pos.x += m_pendingCollisionNormal.x * safetyOffset;
-                    m_pos.y += m_pendingCollisionNormal.y * safetyOffset;
+    /** @brief Obtient les cellules d'un niveau, dans la projection de l'archive (non vérifiées). */
+    const int8_t* cells(int index) const { return reinterpret_cast<const int8_t*>(m_file.data() + m_entries[index].offset); }
 
-                    clearPendingCollision();
-                }
-            }
-        
-            if (m_pos.y + m_radius > windowHeight) {
-                m_pos.y = windowHeight - m_radius;
-                if (m_velocity.y > 0) {
-                    m_velocity.y *= -1.0f;
-                    clearPendingCollision();
-                }
-            }
-            if (m_pos.x - m_radius < gridMinX) {
-                m_pos.x = gridMinX + m_radius;
-                if (m_velocity.x < 0) {
-                    m_velocity.x *= -1.0f;
-                    clearPendingCollision();
-                }
-            } else if (m_pos.x + m_radius > gridMaxX) {
-                m_pos.x = gridMaxX - m_radius;
-                if (m_velocity.x > 0) {
-                    m_velocity.x *= -1.0f;
-                    clearPendingCollision();
-                }
-            }
-            return brickHitThisFrame;
+    /**
+     * @brief Charge un niveau de l'archive dans `level`, directement depuis la projection en mémoire.
+     * @param index Index du niveau.
+     * @param level Niveau de destination (inchangé si la somme de contrôle ne correspond pas).
+     * @return `true` si le niveau a été chargé sans erreur.
+     */
+    bool load(int index, Level& level) const {
+        PROFILE_ZONE("LevelPack::load");
+        if (index < 0 || index >= size()) return false;
+        const Entry& levelEntry = m_entries[index];
+        return level.loadCells(static_cast<int>(levelEntry.rows), static_cast<int>(levelEntry.cols),
+                               reinterpret_cast<const int8_t*>(m_file.data() + levelEntry.offset), levelEntry.checksum,
+                               m_filename + ":" + levelEntry.getName());
+    }
+
+    /**
+     * @brief Ajoute un niveau à la fin d'une archive, en la créant si elle n'existe pas.
+     * @param filename Chemin de l'archive.
+     * @param name Nom du niveau (tronqué à 63 caractères).
+     * @param level Niveau à ajouter.
+     * @return `true` si l'ajout a réussi.
+     * @note Seuls la fin du fichier, l'entrée ajoutée et le compteur (ou le chaînage) du dernier bloc sont écrits.
+     *       Une archive ouverte par `open` ne voit pas l'ajout avant d'être rouverte.
+     * @note Le fichier est synchronisé sur le disque (`fsync`) avant l'écriture du chaînage et avant celle du compteur :
+     *       même après une coupure de courant, l'index ne désigne que des données entièrement écrites.
+     */
+    static bool append(const std::string& filename, const std::string& name, const Level& level) {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            std::ofstream created(filename, std::ios::binary);
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.headerSize = sizeof(Header);
+            header.entriesPerBlock = ENTRIES_PER_BLOCK;
+            header.entrySize = sizeof(Entry);
+            header.firstIndexBlock = sizeof(Header);
+            IndexBlock block{};
+            std::memcpy(block.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+            std::vector<char> emptyEntries(ENTRIES_PER_BLOCK * sizeof(Entry), 0);
+            created.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            created.write(reinterpret_cast<const char*>(&block), sizeof(block));
+            created.write(emptyEntries.data(), static_cast<std::streamsize>(emptyEntries.size()));
+            created.close();
+            if (!created) { std::cerr << "Error: Could not create level pack " << filename << "." << std::endl; return false; }
+            file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+            if (!file.is_open()) return false;
         }
-    
-        /**
-         * @brief Définit les informations pour la prochaine collision anticipée avec une brique.
-         * @param collisionPos Position du centre de la balle au moment de l'impact.
-         * @param normal Normale de la surface de la brique au point d'impact.
-         * @param brickIndex Index de la brique concernée par la collision.
-         */
-        void setNextCollision(const Vec2& collisionPos, const Vec2& normal, int brickIndex) {
-            m_nextCollisionPos = collisionPos;
-            m_pendingCollisionNormal = normal;
-            m_pendingHitBrickIndex = brickIndex;
-            m_hasPendingCollision = true;
+
+        Header header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header.entriesPerBlock != ENTRIES_PER_BLOCK || header.entrySize != sizeof(Entry)) {
+            std::cerr << "Error: " << filename << " is not a compatible level pack." << std::endl;
+            return false;
         }
-    
-        /**
-         * @brief Efface l'état de collision en attente.
-         */
-        void clearPendingCollision() {
-            m_hasPendingCollision = false;
-            m_pendingHitBrickIndex = -1;
+
+        // Dernier bloc de la chaîne
+        uint64_t blockOffset = header.firstIndexBlock;
+        IndexBlock block;
+        for (;;) {
+            file.seekg(static_cast<std::streamoff>(blockOffset));
+            if (!file.read(reinterpret_cast<char*>(&block), sizeof(block)) || std::memcmp(block.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+                std::cerr << "Error: Corrupt index in level pack " << filename << "." << std::endl;
+                return false;
+            }
+            if (block.next == 0) break;
+            blockOffset = block.next;
         }
 
-        /**
-         * @brief Vérifie et gère la collision entre la balle et la raquette.
-         * @param paddle La raquette avec laquelle vérifier la collision.
-         * @param dt Delta-temps, utilisé pour prédire la position de la balle.
-         * @return `true` si une collision avec la raquette s'est produite, `false` sinon.
-         */
-        bool checkCollisionPaddle(const Paddle& paddle, float dt) {
-            const Rect& paddleRect = paddle.getRect();
-            float paddleTopY = paddleRect.y + paddleRect.height;
-            float paddleBottomY = paddleRect.y;
+        // Vide le tampon du flux puis synchronise le fichier : les écritures précédentes sont sur le disque avant les suivantes
+        auto syncToDisk = [&] {
+            file.flush();
+            int fd = ::open(filename.c_str(), O_RDWR | O_CLOEXEC);
+            bool synced = fd >= 0 && fsync(fd) == 0;
+            if (fd >= 0) ::close(fd);
+            if (!synced || !file) std::cerr << "Error: Could not write to level pack " << filename << "." << std::endl;
+            return synced && file;
+        };
+
+        // Grille (puis nouveau bloc d'index si nécessaire) à la fin du fichier
+        const std::vector<int8_t>& cells = level.getCells();
+        file.seekp(0, std::ios::end);
+        uint64_t cellsOffset = static_cast<uint64_t>(file.tellp());
+        file.write(reinterpret_cast<const char*>(cells.data()), static_cast<std::streamsize>(cells.size()));
+        if (block.count >= ENTRIES_PER_BLOCK) {
+            uint64_t newBlockOffset = static_cast<uint64_t>(file.tellp());
+            IndexBlock newBlock{};
+            std::memcpy(newBlock.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+            std::vector<char> emptyEntries(ENTRIES_PER_BLOCK * sizeof(Entry), 0);
+            file.write(reinterpret_cast<const char*>(&newBlock), sizeof(newBlock));
+            file.write(emptyEntries.data(), static_cast<std::streamsize>(emptyEntries.size()));
+            if (!syncToDisk()) return false;
+            file.seekp(static_cast<std::streamoff>(blockOffset + offsetof(IndexBlock, next)));
+            file.write(reinterpret_cast<const char*>(&newBlockOffset), sizeof(newBlockOffset));
+            blockOffset = newBlockOffset;
+            block = newBlock;
+        }
 
-            float ballCurrentBottomY = m_pos.y - m_radius;
-            float ballCurrentTopY = m_pos.y + m_radius;
-            // Prédit la position du bas de la balle après le dt actuel
-            float ballNextBottomY = (m_pos.y + m_velocity.y * dt) - m_radius;
+        // Entrée, puis compteur : l'entrée n'est visible qu'une fois entièrement écrite
+        Entry entry = makeEntry(name, level.getRows(), level.getCols(), cells.data(), cellsOffset);
+        file.seekp(static_cast<std::streamoff>(blockOffset + sizeof(IndexBlock) + block.count * sizeof(Entry)));
+        file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        if (!syncToDisk()) return false;
+        uint32_t count = block.count + 1;
+        file.seekp(static_cast<std::streamoff>(blockOffset + offsetof(IndexBlock, count)));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        return syncToDisk();
+    }
+};
 
-            bool isMovingDown = m_velocity.y < 0;
-           // Vérifie le chevauchement horizontal entre la balle et la raquette
-            bool horizontalOverlap = (m_pos.x + m_radius > paddleRect.x && m_pos.x - m_radius < paddleRect.x + paddleRect.width);
+/**
+ * @class LevelLinter
+ * @brief Vérification d'un niveau sans le charger dans le jeu : erreurs de format, niveau sans brique destructible
+ *        (gagné dès le lancement par `areAllBricksCleared`), briques inaccessibles et pièges probables pour la balle.
+ * @note Les vérifications travaillent sur la grille des cellules : une cellule non indestructible laisse passer la balle
+ *       (une brique destructible finit par céder), les côtés de la grille sont des murs et la balle arrive par la dernière rangée.
+ * @note Toutes les fonctions sont sans état partagé : plusieurs threads peuvent vérifier des niveaux en parallèle.
+ */
+class LevelLinter {
+public:
+    enum class Severity { WARNING, ERROR };
 
-            if (isMovingDown && horizontalOverlap) {
-                bool collisionDetected = false;
+    /**
+     * @brief Problème détecté.
+     * @param severity Gravité (les erreurs font échouer la vérification).
+     * @param check Nom court et stable de la vérification (`format`, `checksum`, `no-destructible`, `unreachable`, `ball-trap`).
+     * @param line Ligne du fichier texte (1 = première), -1 si sans objet.
+     * @param column Colonne du fichier texte (1 = première), -1 si sans objet.
+     * @param row Rangée de la cellule concernée, -1 si sans objet.
+     * @param col Colonne de la cellule concernée, -1 si sans objet.
+     * @param message Description lisible.
+     */
+    struct Finding {
+        Severity severity = Severity::ERROR;
+        const char* check = "";
+        int line = -1;
+        int column = -1;
+        int row = -1;
+        int col = -1;
+        std::string message;
+    };
 
-                // Cas 1: La balle était au-dessus ou au niveau du haut de la raquette et va la croiser ou la toucher dans cette trame
-                if (ballCurrentBottomY >= paddleTopY && ballNextBottomY < paddleTopY) {
-                    collisionDetected = true;
-                }
-                // Cas 2: Le bas de la balle intersecte déjà l'épaisseur de la raquette par le haut
-                else if (ballCurrentBottomY < paddleTopY && ballCurrentBottomY >= paddleBottomY && ballCurrentTopY > paddleTopY) {
-                    collisionDetected = true;
+    /**
+     * @brief Résultat de la vérification d'un niveau.
+     * @param source Fichier, ou `archive:nom` pour un niveau d'archive.
+     * @param rows Nombre de rangées (0 si la grille n'a pas pu être lue).
+     * @param cols Nombre de colonnes.
+     * @param destructible Nombre de briques destructibles.
+     * @param findings Problèmes détectés, au plus `MAX_FINDINGS`.
+     * @param errorCount Nombre total d'erreurs, y compris celles qui ne sont pas dans `findings`.
+     * @param warningCount Nombre total d'avertissements, y compris ceux qui ne sont pas dans `findings`.
+     */
+    struct Report {
+        std::string source;
+        int rows = 0;
+        int cols = 0;
+        uint64_t destructible = 0;
+        std::vector<Finding> findings;
+        size_t errorCount = 0;
+        size_t warningCount = 0;
+    };
+
+    /** @brief Nombre maximal de problèmes conservés par niveau. */
+    static constexpr size_t MAX_FINDINGS = 32;
+
+    /**
+     * @brief Vérifie un fichier de niveau, binaire ou texte (reconnu à son contenu).
+     * @param path Chemin du fichier.
+     * @param report Résultat (`source` est rempli avec `path`).
+     */
+    static void lintFile(const std::string& path, Report& report) {
+        report.source = path;
+        MappedFile file;
+        if (!file.open(path)) { add(report, Severity::ERROR, "format", -1, -1, "cannot open file"); return; }
+        if (!LevelFile::hasMagic(file.data(), file.size())) {
+            LevelTextParser::Result parsed = LevelTextParser::parse(reinterpret_cast<const char*>(file.data()), file.size());
+            for (const LevelTextParser::Diagnostic& diagnostic : parsed.diagnostics) {
+                Finding finding;
+                finding.check = "format";
+                finding.line = diagnostic.line;
+                finding.column = diagnostic.column;
+                finding.message = diagnostic.message;
+                add(report, std::move(finding));
+            }
+            report.errorCount += parsed.errorCount - parsed.diagnostics.size();
+            if (parsed.rows == 0) { add(report, Severity::ERROR, "format", -1, -1, "empty level"); return; }
+            lintCells(parsed.rows, parsed.cols, parsed.cells.data(), report);
+            return;
+        }
+
+        LevelFile::Header header;
+        std::string error;
+        if (!LevelFile::readHeader(file.data(), file.size(), header, error)) { add(report, Severity::ERROR, "format", -1, -1, error); return; }
+        const int8_t* cells = reinterpret_cast<const int8_t*>(file.data() + header.headerSize);
+        size_t cellCount = static_cast<size_t>(header.rows) * header.cols;
+        if (LevelFile::checksum(reinterpret_cast<const uint8_t*>(cells), cellCount) != header.checksum) {
+            add(report, Severity::ERROR, "checksum", -1, -1, "checksum mismatch");
+        }
+        lintCells(static_cast<int>(header.rows), static_cast<int>(header.cols), cells, report);
+    }
+
+    /**
+     * @brief Vérifie un niveau d'archive, directement dans la projection de l'archive.
+     * @param pack Archive ouverte.
+     * @param index Index du niveau.
+     * @param report Résultat (`source` est rempli avec `archive:nom`).
+     */
+    static void lintPackEntry(const LevelPack& pack, int index, Report& report) {
+        const LevelPack::Entry& entry = pack.entry(index);
+        report.source = pack.getFilename() + ":" + entry.getName();
+        const int8_t* cells = pack.cells(index);
+        if (LevelFile::checksum(reinterpret_cast<const uint8_t*>(cells), entry.size) != entry.checksum) {
+            add(report, Severity::ERROR, "checksum", -1, -1, "checksum mismatch");
+        }
+        lintCells(static_cast<int>(entry.rows), static_cast<int>(entry.cols), cells, report);
+    }
+
+    /**
+     * @brief Vérifie le contenu d'une grille : valeurs de score, briques destructibles, accessibilité et pièges.
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score, rangée par rangée (la rangée 0 est la plus éloignée de la raquette).
+     * @param report Résultat complété.
+     * @note Une valeur invalide est signalée puis traitée comme une cellule vide, comme au chargement.
+     * @note Accessibilité : remplissage par segments depuis la dernière rangée à travers les cellules non indestructibles.
+     *       Une brique destructible non atteinte est enfermée par des briques indestructibles.
+     * @note Piège : suite de cellules vides accessibles, avec une brique indestructible juste au-dessus et juste en dessous
+     *       de chacune. Une balle qui y entre de biais rebondit entre les deux rangées sans revenir vers la raquette ni
+     *       toucher de brique destructible.
+     */
+    static void lintCells(int rows, int cols, const int8_t* cells, Report& report) {
+        PROFILE_ZONE("LevelLinter::lintCells");
+        report.rows = rows;
+        report.cols = cols;
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        std::vector<uint8_t> kinds(cellCount); // EMPTY, DESTRUCTIBLE ou WALL
+        size_t invalidCount = 0;
+        for (size_t i = 0; i < cellCount; ++i) {
+            int8_t score = cells[i];
+            if (!Config::isValidScore(score)) {
+                if (invalidCount++ == 0) {
+                    add(report, Severity::ERROR, "format", static_cast<int>(i / cols), static_cast<int>(i % cols),
+                        "invalid score " + std::to_string(score));
                 }
+                score = 0;
+            }
+            kinds[i] = (score == Config::SCORE_INDESTRUCTIBLE) ? WALL : (score > 0 ? DESTRUCTIBLE : EMPTY);
+            report.destructible += (kinds[i] == DESTRUCTIBLE);
+        }
+        if (invalidCount > 1) report.errorCount += invalidCount - 1;
+        if (report.destructible == 0) {
+            add(report, Severity::ERROR, "no-destructible", -1, -1, "no destructible brick: the level is won as soon as it starts");
+        }
 
-                if (collisionDetected) {
-                    // Ajuste la position de la balle pour qu'elle soit juste au-dessus de la raquette
-                    m_pos.y = paddleTopY + m_radius; 
-
-                    float hitCenterOffset = m_pos.x - (paddleRect.x + paddleRect.width / 2.0f);
-                    float normalizedOffset = std::clamp(hitCenterOffset / (paddleRect.width / 2.0f), -1.0f, 1.0f);
-                    float speed = std::sqrt(m_velocity.x * m_velocity.x + m_velocity.y * m_velocity.y);
-                    
-                    float minSpeed = static_cast<float>(Config::WINDOW_WIDTH) / 4.0f; 
-                    if (speed < minSpeed) speed = minSpeed;
-                    
-                    float maxAngleRad = Config::PADDLE_MAX_BOUNCE_ANGLE_DEG * (M_PI / 180.0f);
-                    float bounceAngle = normalizedOffset * maxAngleRad;
-                    m_velocity.x = speed * std::sin(bounceAngle);
-                    m_velocity.y = speed * std::cos(bounceAngle);
-                    m_velocity.y = std::abs(m_velocity.y); // Ensure velocity is upwards
-                    
-                    clearPendingCollision(); // Paddle hit overrides any pending brick collision
-                    return true;
-                }
+        std::vector<uint8_t> reached = reachableCells(rows, cols, kinds);
+        size_t unreachable = 0;
+        for (size_t i = 0; i < cellCount; ++i) {
+            if (kinds[i] != DESTRUCTIBLE || reached[i]) continue;
+            if (unreachable++ < MAX_FINDINGS) {
+                add(report, Severity::ERROR, "unreachable", static_cast<int>(i / cols), static_cast<int>(i % cols),
+                    "destructible brick enclosed by indestructible bricks");
+            } else {
+                ++report.errorCount;
             }
-            return false;
         }
-        
-    /** @brief Arrête la balle (vitesse nulle). */
-    void stop() { m_velocity.x = 0.0f; m_velocity.y = 0.0f; }
-    
-    /** @brief Dessine la balle. */
-    void render() const { Utils::drawCircle(m_pos.x, m_pos.y, m_radius, 20, m_color); }
-    
-    /** @brief Obtient la coordonnée X de la balle. */
-    float getX() const { return m_pos.x; } 
-    
-    /** @brief Obtient la coordonnée Y de la balle. */
-    float getY() const { return m_pos.y; }
-    
-    /** @brief Obtient la position de la balle. */
-    const Vec2& getPosition() const { return m_pos; } 
-    
-    /** @brief Obtient le rayon de la balle. */
-    float getRadius() const { return m_radius; }
-    
-    /** @brief Obtient la composante X de la vitesse de la balle. */
-    float getDx() const { return m_velocity.x; } 
-    
-    /** @brief Obtient la composante Y de la vitesse de la balle. */
-    float getDy() const { return m_velocity.y; }
-    
-    /** @brief Obtient le vecteur vitesse de la balle. */
-    const Vec2& getVelocity() const { return m_velocity; } 
-    
-    /** @brief Obtient le vecteur vitesse sauvegardé de la balle (utilisé après une perte de vie). */
-    const Vec2& getPreservedVelocity() const { return m_preservedvelocity; }
-    
-    /** @brief Définit la vitesse sauvegardée de la balle. */
-    void setPreservedVelocity(float dx, float dy) { m_preservedvelocity.x = dx; m_preservedvelocity.y = dy; }
-    
-    /** @brief Vérifie si la balle est en mouvement. */
-    bool isMoving() const { return m_velocity.x != 0.0f || m_velocity.y != 0.0f; }
-    
-    /** @brief Définit la position de la balle. */
-    void setPosition(float x, float y) { m_pos.x = x; m_pos.y = y; } 
-    
-    /** @brief Définit la vitesse de la balle. */
-    void setVelocity(float dx, float dy) { m_velocity.x = dx; m_velocity.y = dy; }
-    
-    /** @brief Définit le rayon de la balle. */
-    void setRadius(float r) { m_radius = r; } 
-    
-    /** @brief Définit la couleur de la balle. */
-    void setColor(const Config::Color& color) { m_color = color; }
-};
 
-/**
-* @class Brick
-* @brief Représente une brique individuelle dans le jeu.
-* @param m_rect Rectangle définissant la position et la taille de la brique.
-* @param m_color Couleur de la brique, déterminée par sa valeur de score.
-* @param m_active Indicateur booléen de l'état actif de la brique (visible et destructible).
-* @param m_scoreValue Valeur du score de la brique. Peut être `Config::SCORE_INDESTRUCTIBLE`.
-*/
-class Brick {
+        for (int r = 1; r + 1 < rows; ++r) {
+            const uint8_t* above = kinds.data() + static_cast<size_t>(r - 1) * cols;
+            const uint8_t* row = above + cols;
+            const uint8_t* below = row + cols;
+            const uint8_t* rowReached = reached.data() + static_cast<size_t>(r) * cols;
+            for (int c = 0; c < cols;) {
+                auto trapped = [&](int col) { return row[col] == EMPTY && rowReached[col] && above[col] == WALL && below[col] == WALL; };
+                if (!trapped(c)) { ++c; continue; }
+                int start = c;
+                while (c < cols && trapped(c)) ++c;
+                add(report, Severity::WARNING, "ball-trap", r, start,
+                    "ball trap: " + std::to_string(c - start) + " empty cells between indestructible bricks above and below");
+            }
+        }
+    }
+
+    /**
+     * @brief Ajoute le résultat d'une vérification à `out`, sous la forme d'un objet JSON sur une ligne.
+     * @note Champs : `source`, `rows`, `cols`, `destructible`, `errors`, `warnings`, `findings` (tableau d'objets
+     *       `severity`, `check`, `message`, et `line`/`column` ou `row`/`col` quand ils s'appliquent).
+     */
+    static void appendJson(std::string& out, const Report& report) {
+        out += "{\"source\":";
+        appendJsonString(out, report.source);
+        out += ",\"rows\":" + std::to_string(report.rows) + ",\"cols\":" + std::to_string(report.cols) +
+               ",\"destructible\":" + std::to_string(report.destructible) + ",\"errors\":" + std::to_string(report.errorCount) +
+               ",\"warnings\":" + std::to_string(report.warningCount) + ",\"findings\":[";
+        for (size_t i = 0; i < report.findings.size(); ++i) {
+            const Finding& finding = report.findings[i];
+            out += (i == 0) ? "{" : ",{";
+            out += (finding.severity == Severity::ERROR) ? "\"severity\":\"error\"" : "\"severity\":\"warning\"";
+            out += ",\"check\":\"";
+            out += finding.check;
+            out += "\"";
+            if (finding.line >= 0) out += ",\"line\":" + std::to_string(finding.line) + ",\"column\":" + std::to_string(finding.column);
+            if (finding.row >= 0) out += ",\"row\":" + std::to_string(finding.row) + ",\"col\":" + std::to_string(finding.col);
+            out += ",\"message\":";
+            appendJsonString(out, finding.message);
+            out += "}";
+        }
+        out += "]}\n";
+    }
+
 private:
-    Rect m_rect;
-    Config::Color m_color;
-    bool m_active;
-    int m_scoreValue;
+    enum : uint8_t { EMPTY, DESTRUCTIBLE, WALL };
 
-    /** @brief Met à jour la couleur de la brique en fonction de son état actif et de sa valeur de score. */
-    void updateColor() {
-        m_color = (m_active) ? Config::getBrickColorByScore(m_scoreValue) : Config::COLOR_BRICK_EMPTY;
+    /** @brief Ajoute un problème au résultat (compté, mais pas conservé au-delà de `MAX_FINDINGS`). */
+    static void add(Report& report, Finding finding) {
+        if (finding.severity == Severity::ERROR) ++report.errorCount;
+        else ++report.warningCount;
+        if (report.findings.size() < MAX_FINDINGS) report.findings.push_back(std::move(finding));
     }
 
-public:
-    Brick() : m_active(false), m_scoreValue(0) {
-        m_rect.width = Config::BRICK_WIDTH;
-        m_rect.height = Config::BRICK_HEIGHT;
-        updateColor();
+    static void add(Report& report, Severity severity, const char* check, int row, int col, std::string message) {
+        Finding finding;
+        finding.severity = severity;
+        finding.check = check;
+        finding.row = row;
+        finding.col = col;
+        finding.message = std::move(message);
+        add(report, std::move(finding));
     }
 
     /**
-     * @brief Initialise une brique avec une position et une valeur de score.
-     * @param x Position X du coin supérieur gauche de la brique.
-     * @param y Position Y du coin supérieur gauche de la brique.
-     * @param scoreValue Valeur du score de la brique. Si 0, la brique est inactive (vide).
+     * @brief Marque les cellules que la balle peut atteindre depuis la dernière rangée (remplissage par segments).
+     * @note La pile ne contient qu'un segment par rangée parcourue : la mémoire reste faible sur les grandes grilles.
      */
-    void init(float x, float y, int scoreValue) {
-        m_rect.x = x; m_rect.y = y;
-        m_scoreValue = scoreValue;
-        m_active = (m_scoreValue != 0);
-        updateColor();
+    static std::vector<uint8_t> reachableCells(int rows, int cols, const std::vector<uint8_t>& kinds) {
+        std::vector<uint8_t> reached(kinds.size(), 0);
+        std::vector<std::pair<int, int>> seeds; // (rangée, colonne)
+        auto open = [&](int r, int c) { size_t i = static_cast<size_t>(r) * cols + c; return kinds[i] != WALL && !reached[i]; };
+        for (int c = 0; c < cols; ++c) {
+            if (open(rows - 1, c) && (c == 0 || !open(rows - 1, c - 1))) seeds.emplace_back(rows - 1, c);
+        }
+        while (!seeds.empty()) {
+            auto [r, c] = seeds.back();
+            seeds.pop_back();
+            if (!open(r, c)) continue;
+            int left = c, right = c;
+            while (left > 0 && open(r, left - 1)) --left;
+            while (right + 1 < cols && open(r, right + 1)) ++right;
+            std::fill(reached.begin() + static_cast<size_t>(r) * cols + left, reached.begin() + static_cast<size_t>(r) * cols + right + 1, 1);
+            for (int neighbour : { r - 1, r + 1 }) {
+                if (neighbour < 0 || neighbour >= rows) continue;
+                for (int x = left; x <= right; ++x) {
+                    if (open(neighbour, x) && (x == left || !open(neighbour, x - 1))) seeds.emplace_back(neighbour, x);
+                }
+            }
+        }
+        return reached;
     }
 
-    /** @brief Dessine la brique si elle est active. */
-    void render() const {
-        if (m_active) {
-            Utils::drawRect(m_rect, m_color);
+    /** @brief Ajoute une chaîne JSON entre guillemets, en échappant les guillemets, barres obliques inverses et caractères de contrôle. */
+    static void appendJsonString(std::string& out, const std::string& text) {
+        out += '"';
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') { out += '\\'; out += ch; }
+            else if (static_cast<unsigned char>(ch) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(ch));
+                out += escaped;
+            }
+            else out += ch;
         }
+        out += '"';
     }
+};
+
+/**
+ * @class Playthrough
+ * @brief Partie simulée sans affichage par un joueur automatique, avec la physique du jeu (`Ball`, `Paddle`, `Level`,
+ *        `SpeedBoosts`) au pas fixe de la simulation, dans une fenêtre de `Config::DEFAULT_WINDOW_WIDTH` x `Config::DEFAULT_WINDOW_HEIGHT`.
+ * @note Le joueur automatique suit la balle avec une vitesse de raquette limitée (`Config::PLAYTHROUGH_BOT_SPEED`) et vise
+ *       un point de la raquette tiré au hasard à chaque renvoi : il perd des vies lorsque la balle accélère.
+ * @note Une partie ne dépend que de ses paramètres (générateur aléatoire local, aucune lecture de la taille de la fenêtre réelle) :
+ *       plusieurs threads peuvent en jouer en parallèle, et une même grille et une même graine donnent le même résultat
+ *       dans `--generate` et dans la carte de chaleur de l'éditeur.
+ */
+class Playthrough {
+public:
+    /**
+     * @brief Résultat d'une partie simulée.
+     * @param cleared Indique si toutes les briques destructibles ont été détruites.
+     * @param livesLost Nombre de vies perdues.
+     * @param seconds Durée de jeu simulée.
+     * @param destructible Nombre de briques destructibles au début de la partie.
+     * @param bricksDestroyed Nombre de briques détruites.
+     * @param score Score obtenu.
+     */
+    struct Result {
+        bool cleared = false;
+        int livesLost = 0;
+        float seconds = 0.0f;
+        int destructible = 0;
+        int bricksDestroyed = 0;
+        int score = 0;
+    };
 
     /**
-     * @brief Gère la collision avec la brique. La désactive si elle n'est pas indestructible.
-     * @return Le score obtenu en touchant la brique. Retourne 0 si la brique est indestructible ou déjà inactive.
+     * @brief Relevé des touches d'une partie, cellule par cellule (carte de chaleur de l'éditeur).
+     * @param hits Nombre de touches de chaque cellule (remis à zéro par `run`).
+     * @param firstHitSeconds Instant de la première touche de chaque cellule, -1 si elle n'a pas été touchée.
+     * @param generation Compteur surveillé pendant la partie (peut être nul) : la partie est abandonnée dès qu'il ne vaut plus
+     *        `expectedGeneration` (grille modifiée pendant la simulation).
+     * @param expectedGeneration Valeur attendue de `generation`.
      */
-    int hit() {
-        if (!m_active) return 0;
+    struct Trace {
+        std::vector<uint32_t> hits;
+        std::vector<float> firstHitSeconds;
+        const std::atomic<uint64_t>* generation = nullptr;
+        uint64_t expectedGeneration = 0;
+    };
 
-        if (m_scoreValue == Config::SCORE_INDESTRUCTIBLE) {
-            return 0;
+    /**
+     * @brief Joue une partie.
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score valides, rangée par rangée.
+     * @param seed Graine du joueur automatique (direction de lancement, visée).
+     * @param maxSeconds Durée de jeu simulée au-delà de laquelle la partie est abandonnée.
+     * @param trace Relevé des touches par cellule (optionnel).
+     */
+    static Result run(int rows, int cols, const int8_t* cells, uint64_t seed, float maxSeconds, Trace* trace = nullptr) {
+        PROFILE_ZONE("Playthrough::run");
+        const float width = static_cast<float>(Config::DEFAULT_WINDOW_WIDTH);
+        const float height = static_cast<float>(Config::DEFAULT_WINDOW_HEIGHT);
+        const float dt = static_cast<float>(1.0 / Config::SIMULATION_HZ);
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<float> aim(-0.35f, 0.35f);
+
+        Level level;
+        level.replaceCells(rows, cols, std::vector<int8_t>(cells, cells + static_cast<size_t>(rows) * cols));
+        level.setupBricks(width, height);
+        const GridLayout grid = level.getLayout();
+        Paddle paddle;
+        paddle.init(width, height);
+        Ball ball;
+        SpeedBoosts boosts;
+        Result result;
+        result.destructible = level.getActiveBrickCount();
+        if (trace) {
+            trace->hits.assign(static_cast<size_t>(rows) * cols, 0);
+            trace->firstHitSeconds.assign(static_cast<size_t>(rows) * cols, -1.0f);
         }
 
-        int scoreAwarded = m_scoreValue;
-        m_active = false;
-        m_scoreValue = 0;
-        updateColor();
-        return scoreAwarded;
+        // Lancement depuis la raquette : vitesse initiale, ou vitesse conservée sous un angle aléatoire après une vie perdue (comme `Game`)
+        auto launch = [&](float preservedSpeed) {
+            paddle.resetPosition(width);
+            float velX = width * Config::BALL_INITIAL_SPEED_X_FACTOR * ((rng() & 1) ? 1.0f : -1.0f);
+            float velY = height * Config::BALL_INITIAL_SPEED_Y_FACTOR;
+            if (preservedSpeed > width * Config::BALL_INITIAL_SPEED_X_FACTOR * 0.8f) {
+                float angleRadians = (30.0f + static_cast<float>(rng() % 121)) * static_cast<float>(M_PI / 180.0);
+                velX = preservedSpeed * std::cos(angleRadians);
+                velY = preservedSpeed * std::sin(angleRadians);
+            }
+            ball.reset(paddle.getX() + paddle.getWidth() / 2.0f, paddle.getY() + paddle.getHeight() + ball.getRadius() + 5.0f, velX, std::abs(velY));
+        };
+        launch(0.0f);
+
+        float aimOffset = aim(rng) * paddle.getWidth();
+        const float maxMove = Config::PLAYTHROUGH_BOT_SPEED * width * dt;
+        const int maxSteps = static_cast<int>(maxSeconds * Config::SIMULATION_HZ);
+        int lives = Config::PLAYER_STARTING_LIVES;
+        int step = 0;
+        for (; step < maxSteps && lives > 0 && !level.areAllBricksCleared(); ++step) {
+            if (trace && trace->generation && (step & 255) == 0 &&
+                trace->generation->load(std::memory_order_relaxed) != trace->expectedGeneration) break;
+            float paddleCenter = paddle.getX() + paddle.getWidth() / 2.0f;
+            paddle.beginPath();
+            paddle.followCursor(paddleCenter + std::clamp(ball.getX() + aimOffset - paddleCenter, -maxMove, maxMove), width);
+            paddle.endPath();
+
+            float previousDy = ball.getDy();
+            level.checkCollisions(ball);
+            bool paddleHit = ball.checkCollisionPaddle(paddle, dt, width);
+            int hitBrickIndex = ball.update(dt, height, grid.startX, grid.startX + grid.totalWidth);
+            if (paddleHit || (previousDy < 0.0f && ball.getDy() > 0.0f && ball.getY() < height * 0.25f)) aimOffset = aim(rng) * paddle.getWidth();
+            if (hitBrickIndex != -1) {
+                int score = level.processBrickHit(hitBrickIndex);
+                if (score > 0) {
+                    result.score += score;
+                    boosts.onBrickHit(ball, score);
+                }
+                if (trace) {
+                    // Les briques sont rangées comme les cellules : l'index de la brique est celui de la cellule
+                    ++trace->hits[hitBrickIndex];
+                    float& firstHit = trace->firstHitSeconds[hitBrickIndex];
+                    if (firstHit < 0.0f) firstHit = static_cast<float>(step / Config::SIMULATION_HZ);
+                }
+            }
+            if (ball.getY() - ball.getRadius() < 0) {
+                ++result.livesLost;
+                if (--lives > 0) {
+                    Vec2 velocity = ball.getVelocity();
+                    launch(std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y));
+                }
+            }
+        }
+        result.cleared = level.areAllBricksCleared();
+        result.bricksDestroyed = result.destructible - level.getActiveBrickCount();
+        result.seconds = static_cast<float>(step / Config::SIMULATION_HZ);
+        return result;
     }
 
-    /** @brief Vérifie si la brique est active. */
-    bool isActive() const { return m_active; }
-    
-    /** @brief Vérifie si la brique est indestructible. */
-    bool isIndestructible() const { return m_scoreValue == Config::SCORE_INDESTRUCTIBLE; }
-   
-    /** @brief Obtient le rectangle de la brique. */
-    const Rect& getRect() const { return m_rect; }
-    
-    /** @brief Obtient la coordonnée X de la brique. */
-    float getX() const { return m_rect.x; }
-    
-    /** @brief Obtient la coordonnée Y de la brique. */
-    float getY() const { return m_rect.y; }
-    
-    /** @brief Obtient la largeur de la brique. */
-    float getWidth() const { return m_rect.width; }
-    
-    /** @brief Obtient la hauteur de la brique. */
-    float getHeight() const { return m_rect.height; }
-    
-    /** @brief Obtient la valeur du score de la brique. */
-    int getScoreValue() const { return m_scoreValue; }
+    /**
+     * @brief Difficulté d'un niveau, entre 0 et 1, moyennée sur plusieurs parties simulées : 1 - p x (w + (1 - w) x v), où p est
+     *        la part des briques détruites, v la part des vies restantes et w `Config::PLAYTHROUGH_PROGRESS_WEIGHT`.
+     * @note Un niveau terminé sans perdre de vie vaut 0 et une partie sans aucune brique détruite vaut 1. Une partie perdue
+     *       vaut 1 - w x p : elle reste départagée par sa progression (perdue à 95 % des briques, elle vaut environ 0,29).
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score valides, rangée par rangée.
+     * @param seed Graine de la première partie (les suivantes utilisent les graines suivantes).
+     * @param runs Nombre de parties.
+     * @param maxSeconds Durée maximale d'une partie.
+     */
+    static float difficulty(int rows, int cols, const int8_t* cells, uint64_t seed, int runs, float maxSeconds) {
+        float total = 0.0f;
+        for (int i = 0; i < runs; ++i) {
+            Result result = run(rows, cols, cells, seed + static_cast<uint64_t>(i), maxSeconds);
+            float progress = result.destructible > 0 ? static_cast<float>(result.bricksDestroyed) / result.destructible : 1.0f;
+            float livesLeft = 1.0f - static_cast<float>(result.livesLost) / Config::PLAYER_STARTING_LIVES;
+            total += 1.0f - progress * (Config::PLAYTHROUGH_PROGRESS_WEIGHT + (1.0f - Config::PLAYTHROUGH_PROGRESS_WEIGHT) * livesLeft);
+        }
+        return runs > 0 ? total / runs : 0.0f;
+    }
+};
+
+/**
+ * @class LevelGenerator
+ * @brief Génération procédurale de niveaux sous contraintes : symétrie, nombre de briques, résolubilité (`LevelLinter`)
+ *        et difficulté mesurée par des parties simulées (`Playthrough`).
+ * @note Un candidat est entièrement déterminé par sa graine : les threads de recherche se partagent les graines et
+ *       un niveau accepté peut être régénéré à l'identique.
+ * @note La disposition est faite de rectangles de briques posés (et parfois creusés) dans le domaine fondamental de la
+ *       symétrie, puis de courts segments indestructibles. Les couleurs suivent le schéma du jeu : rouge, orange, vert puis
+ *       jaune par quart de la grille en partant du haut (`Level::defaultScoreForRow`).
+ */
+class LevelGenerator {
+public:
+    enum class Symmetry { NONE, MIRROR, QUAD };
+    enum class Rejection { NONE, BRICK_COUNT, UNSOLVABLE, DIFFICULTY };
 
     /**
-     * @brief Définit l'état actif de la brique et son type (normal/indestructible).
-     * @param active `true` pour activer la brique, `false` pour la désactiver.
-     * @param indestructible `true` si la brique activée doit être indestructible.
+     * @brief Contraintes de génération.
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param symmetry Symétrie de la disposition : aucune, gauche/droite (MIRROR), ou gauche/droite et haut/bas (QUAD).
+     * @param targetBricks Nombre de briques visé (destructibles et indestructibles), -1 pour 60 % des cellules.
+     * @param brickTolerance Écart toléré sur le nombre de briques, en fraction de `targetBricks`.
+     * @param indestructibleRatio Part des briques rendues indestructibles.
+     * @param minDifficulty Difficulté minimale acceptée (voir `Playthrough::difficulty`).
+     * @param maxDifficulty Difficulté maximale acceptée.
+     * @param playthroughs Nombre de parties simulées par candidat (0 : difficulté non mesurée).
+     * @param maxPlaySeconds Durée maximale d'une partie simulée.
      */
-    void setActive(bool active, bool indestructible = false) {
-         if (active && !m_active) {
-             m_scoreValue = indestructible ? Config::SCORE_INDESTRUCTIBLE : 0;
-             m_active = (m_scoreValue != 0);
-         } else if (!active && m_active) {
-             m_scoreValue = 0;
-             m_active = false;
-         }
-         updateColor();
+    struct Constraints {
+        int rows = Config::GRID_ROWS;
+        int cols = Config::GRID_COLS;
+        Symmetry symmetry = Symmetry::MIRROR;
+        int targetBricks = -1;
+        float brickTolerance = 0.1f;
+        float indestructibleRatio = 0.08f;
+        float minDifficulty = 0.0f;
+        float maxDifficulty = 1.0f;
+        int playthroughs = 2;
+        float maxPlaySeconds = Config::PLAYTHROUGH_MAX_SECONDS;
+    };
+
+    /**
+     * @brief Niveau candidat.
+     * @param seed Graine du candidat.
+     * @param cells Valeurs de score, rangée par rangée.
+     * @param bricks Nombre de briques (destructibles et indestructibles).
+     * @param difficulty Difficulté mesurée, -1 si elle n'a pas été mesurée.
+     */
+    struct Candidate {
+        uint64_t seed = 0;
+        std::vector<int8_t> cells;
+        int bricks = 0;
+        float difficulty = -1.0f;
+    };
+
+    /** @brief Lit un nom de symétrie (`none`, `mirror`, `quad`). @return `false` si le nom est inconnu. */
+    static bool parseSymmetry(std::string_view name, Symmetry& out) {
+        if (name == "none") out = Symmetry::NONE;
+        else if (name == "mirror") out = Symmetry::MIRROR;
+        else if (name == "quad") out = Symmetry::QUAD;
+        else return false;
+        return true;
     }
 
     /**
-     * @brief Définit la valeur de score de la brique. Met à jour son état actif et sa couleur.
-     * @param score La nouvelle valeur de score. Doit être une des valeurs prédéfinies dans `Config` ou 0.
+     * @brief Génère et évalue un candidat. Les vérifications les moins coûteuses passent en premier.
+     * @param constraints Contraintes.
+     * @param seed Graine du candidat.
+     * @param out Candidat généré (rempli même s'il est rejeté).
+     * @return `Rejection::NONE` si le candidat respecte toutes les contraintes, sinon la première contrainte violée.
      */
-    void setScoreValue(int score) {
-         bool validScore = false;
-         if (score == 0 || score == Config::SCORE_INDESTRUCTIBLE) validScore = true;
-         else if (score == Config::SCORE_YELLOW || score == Config::SCORE_GREEN ||
-                  score == Config::SCORE_ORANGE || score == Config::SCORE_RED) {
-             validScore = true;
-         }
+    static Rejection generate(const Constraints& constraints, uint64_t seed, Candidate& out) {
+        PROFILE_ZONE("LevelGenerator::generate");
+        const int rows = constraints.rows;
+        const int cols = constraints.cols;
+        const int target = constraints.targetBricks >= 0 ? constraints.targetBricks : rows * cols * 6 / 10;
+        std::mt19937_64 rng(seed);
+        out.seed = seed;
+        out.difficulty = -1.0f;
+        out.cells.assign(static_cast<size_t>(rows) * cols, 0);
+
+        // Domaine fondamental : la moitié gauche (et haute en QUAD), recopiée par symétrie
+        const int domainCols = (constraints.symmetry == Symmetry::NONE) ? cols : (cols + 1) / 2;
+        const int domainRows = (constraints.symmetry == Symmetry::QUAD) ? (rows + 1) / 2 : rows;
+        std::vector<uint8_t> domain(static_cast<size_t>(domainRows) * domainCols, EMPTY);
+        auto count = [&] {
+            int bricks = 0;
+            for (int r = 0; r < rows; ++r) {
+                for (int c = 0; c < cols; ++c) bricks += domain[domainIndex(r, c, rows, cols, domainRows, domainCols)] != EMPTY;
+            }
+            return bricks;
+        };
+        auto randomInt = [&](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+        auto stamp = [&](uint8_t value, int maxHeight, int maxWidth, bool overwriteOnly) {
+            int height = randomInt(1, std::max(1, std::min(maxHeight, domainRows)));
+            int width = randomInt(1, std::max(1, std::min(maxWidth, domainCols)));
+            int top = randomInt(0, domainRows - height);
+            int left = randomInt(0, domainCols - width);
+            for (int r = top; r < top + height; ++r) {
+                for (int c = left; c < left + width; ++c) {
+                    uint8_t& cellKind = domain[static_cast<size_t>(r) * domainCols + c];
+                    if (!overwriteOnly || cellKind != EMPTY) cellKind = value;
+                }
+            }
+        };
 
-         if (validScore) {
-             m_scoreValue = score;
-             m_active = (m_scoreValue != 0);
-             updateColor();
-         } else {
-             std::cerr << "Warning: Attempted to set invalid score value: " << score << std::endl;
-         }
+        int bricks = 0;
+        for (int attempts = 0; attempts < 256 && bricks < target; ++attempts) {
+            bool carve = bricks > target / 2 && randomInt(0, 3) == 0;
+            stamp(carve ? EMPTY : BRICK, std::max(1, domainRows / 3), std::max(1, domainCols * 2 / 3), false);
+            bricks = count();
+        }
+        int walls = 0;
+        int wallTarget = static_cast<int>(bricks * constraints.indestructibleRatio);
+        for (int attempts = 0; attempts < 256 && walls < wallTarget; ++attempts) {
+            stamp(WALL, 1, 3, true);
+            walls = 0;
+            for (int r = 0; r < rows; ++r) {
+                for (int c = 0; c < cols; ++c) walls += domain[domainIndex(r, c, rows, cols, domainRows, domainCols)] == WALL;
+            }
+        }
+
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                uint8_t kind = domain[domainIndex(r, c, rows, cols, domainRows, domainCols)];
+                out.cells[static_cast<size_t>(r) * cols + c] = static_cast<int8_t>(
+                    kind == WALL ? Config::SCORE_INDESTRUCTIBLE : (kind == BRICK ? Level::defaultScoreForRow(r, rows) : 0));
+            }
+        }
+        out.bricks = bricks;
+        if (std::abs(bricks - target) > std::max(1, static_cast<int>(target * constraints.brickTolerance))) return Rejection::BRICK_COUNT;
+
+        LevelLinter::Report report;
+        LevelLinter::lintCells(rows, cols, out.cells.data(), report);
+        if (report.errorCount > 0 || report.warningCount > 0) return Rejection::UNSOLVABLE;
+
+        if (constraints.playthroughs <= 0) return Rejection::NONE;
+        out.difficulty = Playthrough::difficulty(rows, cols, out.cells.data(), seed, constraints.playthroughs, constraints.maxPlaySeconds);
+        if (out.difficulty < constraints.minDifficulty || out.difficulty > constraints.maxDifficulty) return Rejection::DIFFICULTY;
+        return Rejection::NONE;
+    }
+
+private:
+    enum : uint8_t { EMPTY, BRICK, WALL };
+
+    /** @brief Index dans le domaine fondamental de la cellule (r, c) de la grille complète. */
+    static size_t domainIndex(int r, int c, int rows, int cols, int domainRows, int domainCols) {
+        if (c >= domainCols) c = cols - 1 - c;
+        if (r >= domainRows) r = rows - 1 - r;
+        return static_cast<size_t>(r) * domainCols + c;
     }
 };
 
 /**
-* @class Level
-* @brief Gère la grille de briques, le chargement et la sauvegarde des niveaux.
-* @param m_bricks Vecteur d'objets Brick constituant le niveau.
-* @param m_gridState Tableau 2D représentant l'état de la grille (valeurs de score des briques).
-* @param m_activeBrickCount Nombre de briques actives (destructibles) dans le niveau.
-* @param m_editorSelectedRow Ligne sélectionnée en mode éditeur (logique, 0 en haut).
-* @param m_editorSelectedCol Colonne sélectionnée en mode éditeur (logique, 0 à gauche).
-* @param m_gridTotalWidth Largeur totale de la grille de briques (avec espacements).
-* @param m_gridTotalHeight Hauteur totale de la grille de briques (avec espacements).
-* @param m_gridStartX Position X de départ (coin supérieur gauche) de la grille.
-* @param m_gridStartY Position Y de départ (coin supérieur gauche) de la grille.
-*/
-class Level {
+ * @class HeatmapSampler
+ * @brief Parties simulées (`Playthrough`) de la grille de l'éditeur sur des threads de fond, dont les touches par cellule sont
+ *        accumulées progressivement dans une carte de chaleur (`HitHeatmap`).
+ * @note Chaque grille est simulée sur `Config::HEATMAP_GAMES` parties, de graines 0, 1, 2... Une nouvelle grille (`start`)
+ *       ou une pause abandonne les parties en cours : elles surveillent `m_generation` et s'arrêtent dès qu'il change.
+ *       Les graines des parties abandonnées par une pause sont rejouées à la reprise, avant les suivantes.
+ * @note Les résultats partiels sont signalés au plus toutes les `Config::HEATMAP_REFRESH_SECONDS`, et à la dernière partie.
+ * @note Les parties se jouent dans la zone fixe de `Playthrough`, sans lire la taille de la fenêtre (`Config::WINDOW_WIDTH`,
+ *       modifiée par la simulation) : la carte ne dépend que de la grille, et les threads ne partagent rien d'autre que
+ *       l'état protégé par `m_mutex` et `m_generation`.
+ * @param m_resultSignal Signal notifié lorsque de nouveaux résultats sont disponibles (réveille la simulation inactive).
+ * @param m_mutex Verrou protégeant la grille simulée, la distribution des parties et les totaux.
+ * @param m_cv Variable de condition réveillant les threads (nouvelle grille, reprise, arrêt).
+ * @param m_threads Threads de simulation, démarrés au premier `start`.
+ * @param m_generation Incrémenté à chaque changement de grille ou pause : les parties commencées avant sont abandonnées.
+ * @param m_cells Grille simulée, partagée par les parties en cours.
+ * @param m_nextSeed Graine de la prochaine nouvelle partie.
+ * @param m_retrySeeds Graines des parties de la grille courante abandonnées par une pause, à rejouer.
+ * @param m_running Nombre de parties en cours.
+ * @param m_active Indique que des parties doivent être lancées (faux en pause).
+ * @param m_stopping Demande d'arrêt des threads.
+ * @param m_totals Touches accumulées sur les parties terminées.
+ * @param m_resultVersion Incrémenté à chaque modification de `m_totals`.
+ * @param m_lastNotify Instant du dernier signal de résultats partiels.
+ */
+class HeatmapSampler {
 private:
-    std::vector<Brick> m_bricks;
-    int m_gridState[Config::GRID_ROWS][Config::GRID_COLS];
-    int m_activeBrickCount = 0;
-    int m_editorSelectedRow = -1;
-    int m_editorSelectedCol = -1;
-
+    WakeSignal& m_resultSignal;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::thread> m_threads;
+    std::atomic<uint64_t> m_generation{0};
+    std::shared_ptr<const std::vector<int8_t>> m_cells;
+    uint64_t m_nextSeed = 0;
+    std::vector<uint64_t> m_retrySeeds;
+    int m_running = 0;
+    bool m_active = false;
+    bool m_stopping = false;
+    HitHeatmap m_totals;
+    uint64_t m_resultVersion = 0;
+    std::chrono::steady_clock::time_point m_lastNotify;
 
 public:
-    float m_gridTotalWidth = 0.0f;
-    float m_gridTotalHeight = 0.0f;
-    float m_gridStartX = 0.0f;
-    float m_gridStartY = 0.0f;
-    
-    Level() {
-        m_bricks.resize(Config::GRID_ROWS * Config::GRID_COLS);
-        for (int r = 0; r < Config::GRID_ROWS; ++r) {
-            for (int c = 0; c < Config::GRID_COLS; ++c) {
-                m_gridState[r][c] = 0;
-            }
-        }
+    explicit HeatmapSampler(WakeSignal& resultSignal) : m_resultSignal(resultSignal) {}
+    HeatmapSampler(const HeatmapSampler&) = delete;
+    HeatmapSampler& operator=(const HeatmapSampler&) = delete;
+
+    /** @brief Abandonne les parties en cours puis arrête les threads. */
+    ~HeatmapSampler() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_stopping = true; m_generation.fetch_add(1, std::memory_order_relaxed); }
+        m_cv.notify_all();
+        for (std::thread& thread : m_threads) thread.join();
     }
 
     /**
-     * @brief Charge la configuration du niveau depuis un fichier.
-     * @param filename Le nom du fichier de niveau.
-     * @return `true` si le chargement réussit ou si un niveau par défaut est créé, `false` si une erreur majeure se produit.
-     * @note Si le fichier n'existe pas, un niveau par défaut est créé et sauvegardé.
-     * @note Les valeurs de score lues sont validées. Les valeurs invalides sont remplacées par 0.
+     * @brief Simule une grille (copiée). Les résultats accumulés sont conservés si la grille est identique à la précédente
+     *        (reprise après une pause), sinon ils sont effacés et les parties en cours abandonnées.
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score, rangée par rangée.
+     * @param version Version du niveau, reportée dans les résultats.
      */
-    bool load(const std::string& filename) {
-        std::ifstream levelFile(filename);
-        if (!levelFile.is_open()) {
-            std::cerr << "Warning: Could not load level file: " << filename << ". Creating default layout." << std::endl;
-            for (int r = 0; r < Config::GRID_ROWS; ++r) {
-                for (int c = 0; c < Config::GRID_COLS; ++c) {
-                    if (r < 2) m_gridState[r][c] = Config::SCORE_RED;
-                    else if (r < 4) m_gridState[r][c] = Config::SCORE_ORANGE;
-                    else if (r < 6) m_gridState[r][c] = Config::SCORE_GREEN;
-                    else if (r < 8) m_gridState[r][c] = Config::SCORE_YELLOW;
-                    else m_gridState[r][c] = 0;
-                }
+    void start(int rows, int cols, const std::vector<int8_t>& cells, uint64_t version) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_cells || m_totals.rows != rows || m_totals.cols != cols || *m_cells != cells) {
+                m_generation.fetch_add(1, std::memory_order_relaxed);
+                m_cells = std::make_shared<const std::vector<int8_t>>(cells);
+                size_t count = cells.size();
+                m_totals = HitHeatmap();
+                m_totals.rows = rows;
+                m_totals.cols = cols;
+                m_totals.hits.assign(count, 0);
+                m_totals.hitGames.assign(count, 0);
+                m_totals.firstHitSeconds.assign(count, 0.0f);
+                for (int8_t cell : cells) m_totals.neverHit += cell != 0;
+                m_nextSeed = 0;
+                m_retrySeeds.clear();
+                m_lastNotify = {};
+            }
+            m_totals.version = version;
+            ++m_resultVersion;
+            m_active = true;
+            if (m_threads.empty()) {
+                unsigned int cores = std::thread::hardware_concurrency();
+                unsigned int threadCount = cores > 2 ? cores - 2 : 1; // Laisse un cœur aux threads de rendu et de simulation
+                for (unsigned int t = 0; t < threadCount; ++t) m_threads.emplace_back(&HeatmapSampler::workerLoop, this);
             }
-            save(filename);
-            return true;
         }
+        m_cv.notify_all();
+    }
 
-        std::cout << "Loading level from " << filename << std::endl;
-        int scoreValue;
-        bool success = true;
-        for (int r = 0; r < Config::GRID_ROWS; ++r) {
-            for (int c = 0; c < Config::GRID_COLS; ++c) {
-                if (!(levelFile >> scoreValue)) {
-                    std::cerr << "Warning: Error reading level file format at r" << r << ", c" << c << ". Setting score to 0." << std::endl;
-                    m_gridState[r][c] = 0;
-                    success = false;
-                } else {
-                    bool valid = false;
-                    if (scoreValue == 0 || scoreValue == Config::SCORE_INDESTRUCTIBLE ||
-                        scoreValue == Config::SCORE_YELLOW || scoreValue == Config::SCORE_GREEN ||
-                        scoreValue == Config::SCORE_ORANGE || scoreValue == Config::SCORE_RED) {
-                        valid = true;
-                    }
-                    m_gridState[r][c] = valid ? scoreValue : 0;
-                    if (!valid && scoreValue != 0) {
-                         std::cerr << "Warning: Invalid score " << scoreValue << " read at r" << r << ", c" << c << ". Setting to 0." << std::endl;
-                         success = false;
-                    }
-                }
+    /** @brief Suspend la simulation (parties en cours abandonnées, résultats conservés pour une reprise par `start`). */
+    void pause() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_active) return;
+        m_active = false;
+        m_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copie les résultats s'ils ont changé depuis le dernier appel.
+     * @param seenVersion Version des résultats déjà lus, mise à jour.
+     * @param out Copie partagée des résultats.
+     * @return `true` si `out` a été remplacé.
+     */
+    bool takeResult(uint64_t& seenVersion, std::shared_ptr<const HitHeatmap>& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (seenVersion == m_resultVersion) return false;
+        seenVersion = m_resultVersion;
+        out = std::make_shared<const HitHeatmap>(m_totals);
+        return true;
+    }
+
+private:
+    /** @brief Boucle d'un thread de simulation : joue des parties tant que la grille courante n'en a pas assez. */
+    void workerLoop() {
+        PROFILE_THREAD("Heatmap");
+        Playthrough::Trace trace;
+        trace.generation = &m_generation;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this] { return m_stopping || (m_active && m_totals.games + m_running < Config::HEATMAP_GAMES); });
+            if (m_stopping) return;
+            std::shared_ptr<const std::vector<int8_t>> cells = m_cells;
+            int rows = m_totals.rows, cols = m_totals.cols;
+            uint64_t seed;
+            if (m_retrySeeds.empty()) seed = m_nextSeed++;
+            else {
+                auto lowest = std::min_element(m_retrySeeds.begin(), m_retrySeeds.end());
+                seed = *lowest;
+                m_retrySeeds.erase(lowest);
+            }
+            trace.expectedGeneration = m_generation.load(std::memory_order_relaxed);
+            ++m_running;
+            lock.unlock();
+            Playthrough::run(rows, cols, cells->data(), seed, Config::HEATMAP_MAX_SECONDS, &trace);
+            lock.lock();
+            --m_running;
+            if (m_generation.load(std::memory_order_relaxed) != trace.expectedGeneration) {
+                if (cells == m_cells) m_retrySeeds.push_back(seed); // Pause : la même grille rejouera cette graine
+                m_cv.notify_all(); // La place libérée peut être reprise par une partie de la nouvelle grille
+                continue;
+            }
+            accumulate(trace, *cells);
+            auto now = std::chrono::steady_clock::now();
+            if (m_totals.games == Config::HEATMAP_GAMES || now - m_lastNotify >= std::chrono::duration<double>(Config::HEATMAP_REFRESH_SECONDS)) {
+                m_lastNotify = now;
+                m_resultSignal.notify();
             }
         }
-        levelFile.close();
-        m_editorSelectedRow = -1; 
-        m_editorSelectedCol = -1;
-        return success;
     }
 
-    /**
-     * @brief Sauvegarde la configuration actuelle du niveau (les valeurs de score de `m_gridState`) dans un fichier.
-     * @param filename Le nom du fichier de niveau.
-     * @return `true` si la sauvegarde réussit, `false` sinon.
-     * @note Le fichier est écrasé s'il existe déjà.
-     * @note Les valeurs de score sont écrites dans le même format que celui utilisé pour le chargement.
-     * @note Les briques indestructibles sont représentées par `Config::SCORE_INDESTRUCTIBLE`.
-     * @note Les briques vides/inactives sont représentées par 0.
-     * @note Les briques actives sont représentées par leurs valeurs de score respectives.
-     */
-    bool save(const std::string& filename) const {
-        std::ofstream levelFile(filename);
-        if (!levelFile.is_open()) {
-            std::cerr << "Error: Could not open level file for saving: " << filename << std::endl;
-            return false;
-        }
-        std::cout << "Saving level (score values) to " << filename << std::endl;
-        for (int r = 0; r < Config::GRID_ROWS; ++r) {
-            for (int c = 0; c < Config::GRID_COLS; ++c) {
-                levelFile << m_gridState[r][c] << (c == Config::GRID_COLS - 1 ? "" : " ");
+    /** @brief Ajoute le relevé d'une partie terminée aux totaux (verrou tenu). */
+    void accumulate(const Playthrough::Trace& trace, const std::vector<int8_t>& cells) {
+        HitHeatmap& totals = m_totals;
+        ++totals.games;
+        totals.neverHit = 0;
+        totals.maxFirstHitSeconds = 0.0f;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (trace.hits[i] > 0) {
+                totals.hits[i] += trace.hits[i];
+                ++totals.hitGames[i];
+                totals.firstHitSeconds[i] += trace.firstHitSeconds[i];
             }
-            levelFile << "\n";
+            if (cells[i] == Config::SCORE_INDESTRUCTIBLE) totals.maxIndestructibleHits = std::max(totals.maxIndestructibleHits, totals.hits[i]);
+            if (cells[i] != 0 && totals.hitGames[i] == 0) ++totals.neverHit;
+            totals.maxFirstHitSeconds = std::max(totals.maxFirstHitSeconds, totals.averageFirstHit(i));
         }
-        levelFile.close();
-        return true;
+        ++m_resultVersion;
+    }
+};
+
+/**
+ * @class LevelSaver
+ * @brief Sauvegarde des niveaux sur un thread dédié : l'éditeur confie une copie de la grille et reste réactif
+ *        pendant l'écriture, la synchronisation et le renommage atomique du fichier (`LevelFile::write`).
+ * @param m_completionSignal Signal notifié à la fin de chaque sauvegarde (réveille la simulation inactive).
+ * @param m_mutex Verrou protégeant la demande en attente, l'état du thread et le résultat.
+ * @param m_cv Variable de condition réveillant le thread de sauvegarde (nouvelle demande, arrêt) et `waitUntilIdle`.
+ * @param m_thread Thread de sauvegarde, démarré à la première demande.
+ * @param m_pending Demande en attente : une nouvelle demande remplace celle qui n'a pas encore commencé.
+ * @param m_active Demande en cours d'écriture (thread de sauvegarde). Son tampon est réutilisé par la demande suivante.
+ * @param m_hasPending Indique qu'une demande attend le thread de sauvegarde.
+ * @param m_busy Indique qu'une sauvegarde est en cours.
+ * @param m_stopping Demande d'arrêt du thread (les demandes en attente sont d'abord écrites).
+ * @param m_result Résultat de la dernière sauvegarde terminée.
+ * @param m_hasResult Indique que `m_result` n'a pas encore été lu.
+ */
+class LevelSaver {
+public:
+    /** @brief Résultat d'une sauvegarde terminée. */
+    struct Result {
+        std::string filename;
+        bool success = false;
+        uint64_t checksum = 0;
+        float ms = 0.0f;
+    };
+
+private:
+    struct Job {
+        std::string filename;
+        int rows = 0;
+        int cols = 0;
+        std::vector<int8_t> cells;
+    };
+
+    WakeSignal& m_completionSignal;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+    Job m_pending;
+    Job m_active;
+    bool m_hasPending = false;
+    bool m_busy = false;
+    bool m_stopping = false;
+    Result m_result;
+    bool m_hasResult = false;
+
+public:
+    explicit LevelSaver(WakeSignal& completionSignal) : m_completionSignal(completionSignal) {}
+    LevelSaver(const LevelSaver&) = delete;
+    LevelSaver& operator=(const LevelSaver&) = delete;
+
+    /** @brief Termine les sauvegardes en attente puis arrête le thread. */
+    ~LevelSaver() {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_stopping = true; }
+        m_cv.notify_all();
+        if (m_thread.joinable()) m_thread.join();
     }
 
     /**
-     * @brief Calcule les dimensions et la position de départ de la grille de briques.
-     * @param windowWidth Largeur de la fenêtre.
-     * @param windowHeight Hauteur de la fenêtre.
-     * @note La grille est centrée horizontalement. Sa position Y est calculée pour être en haut de l'écran,
-     *       mais pas trop bas pour laisser de la place pour la raquette et la zone de jeu.
+     * @brief Demande la sauvegarde d'une grille. La grille est copiée : l'appelant peut la modifier aussitôt.
+     * @param filename Fichier de destination (format binaire).
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score, rangée par rangée.
      */
-    void calculateGridDimensions(float windowWidth, float windowHeight) {
-        m_gridTotalWidth = Config::GRID_COLS * (Config::BRICK_WIDTH + Config::BRICK_SPACING) - Config::BRICK_SPACING;
-        m_gridTotalHeight = Config::GRID_ROWS * (Config::BRICK_HEIGHT + Config::BRICK_SPACING) - Config::BRICK_SPACING;
-        m_gridStartX = (windowWidth - m_gridTotalWidth) / 2.0f;
-        m_gridStartY = windowHeight * 0.90f - m_gridTotalHeight;
-        if (m_gridStartY < windowHeight * 0.25f) {
-            m_gridStartY = windowHeight * 0.25f;
+    void request(const std::string& filename, int rows, int cols, const std::vector<int8_t>& cells) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.filename = filename;
+            m_pending.rows = rows;
+            m_pending.cols = cols;
+            m_pending.cells.assign(cells.begin(), cells.end());
+            m_hasPending = true;
+            if (!m_thread.joinable()) m_thread = std::thread(&LevelSaver::workerLoop, this);
         }
+        m_cv.notify_all();
     }
 
     /**
-     * @brief Crée/Met à jour les objets Brick basés sur `m_gridState`.
-     * @param windowWidth Largeur de la fenêtre.
-     * @param windowHeight Hauteur de la fenêtre.
-     * @note Cette fonction doit être appelée après `load()` et `calculateGridDimensions()`.
-     *       Elle initialise chaque brique avec sa position et son type/score.
+     * @brief Récupère le résultat de la dernière sauvegarde terminée, s'il n'a pas encore été lu.
+     * @return `true` si `out` a été rempli.
      */
-    void setupBricks(float windowWidth, float windowHeight) {
-        calculateGridDimensions(windowWidth, windowHeight);
-        m_activeBrickCount = 0;
-        int brickIndex = 0;
-        for (int r = 0; r < Config::GRID_ROWS; ++r) {
-            for (int c = 0; c < Config::GRID_COLS; ++c) {
-                Brick& brick = m_bricks[brickIndex];
-                int scoreValue = m_gridState[r][c];
+    bool takeResult(Result& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_hasResult) return false;
+        out = m_result;
+        m_hasResult = false;
+        return true;
+    }
 
-                 int visualRow = Config::GRID_ROWS - 1 - r;
-                 float brickX = m_gridStartX + c * (Config::BRICK_WIDTH + Config::BRICK_SPACING);
-                 float brickY = m_gridStartY + visualRow * (Config::BRICK_HEIGHT + Config::BRICK_SPACING);
+    /** @brief Indique si une sauvegarde est en attente ou en cours. */
+    bool isBusy() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hasPending || m_busy;
+    }
 
-                brick.init(brickX, brickY, scoreValue);
-                if (brick.isActive() && !brick.isIndestructible()) {
-                    m_activeBrickCount++;
-                }
-                brickIndex++;
+    /** @brief Attend la fin des sauvegardes en attente ou en cours (avant de relire le fichier). */
+    void waitUntilIdle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return !m_hasPending && !m_busy; });
+    }
+
+private:
+    /** @brief Boucle du thread de sauvegarde. */
+    void workerLoop() {
+        PROFILE_THREAD("Level saver");
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this] { return m_hasPending || m_stopping; });
+            if (!m_hasPending) return;
+            std::swap(m_active, m_pending);
+            m_hasPending = false;
+            m_busy = true;
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            bool success;
+            uint64_t checksum = 0;
+            {
+                PROFILE_ZONE("LevelSaver::write");
+                success = LevelFile::write(m_active.filename, m_active.rows, m_active.cols, m_active.cells.data(), &checksum);
             }
+            float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            lock.lock();
+            m_busy = false;
+            m_result.filename = m_active.filename;
+            m_result.success = success;
+            m_result.checksum = checksum;
+            m_result.ms = ms;
+            m_hasResult = true;
+            m_cv.notify_all();
+            m_completionSignal.notify();
         }
-        std::cout << "Level setup complete. Active destructible bricks: " << m_activeBrickCount << std::endl;
     }
+};
+
+/**
+ * @class LevelFileWatcher
+ * @brief Rechargement à chaud des fichiers de niveau : un thread surveille leurs répertoires (inotify), attend que les
+ *        écritures cessent, puis lit et analyse le fichier modifié. La simulation n'a plus qu'à échanger la grille.
+ * @param m_reloadSignal Signal notifié lorsqu'un niveau rechargé est disponible (réveille la simulation inactive).
+ * @param m_filenames Fichiers surveillés.
+ * @param m_inotifyFd Descripteur inotify, -1 si la surveillance n'est pas active.
+ * @param m_stopPipe Tube réveillant le thread de surveillance à l'arrêt.
+ * @param m_thread Thread de surveillance.
+ * @param m_mutex Verrou protégeant `m_reloads`.
+ * @param m_reloads Niveaux rechargés pas encore repris, au plus un par fichier (le plus récent).
+ * @note Ce sont les répertoires qui sont surveillés, pas les fichiers : un éditeur (ou `AtomicFileWriter`) qui remplace
+ *       le fichier par un renommage est suivi comme une écriture sur place.
+ */
+class LevelFileWatcher {
+public:
+    /**
+     * @brief Niveau relu après une modification du fichier.
+     * @param filename Fichier relu (tel que passé à `start`).
+     * @param rows Nombre de rangées.
+     * @param cols Nombre de colonnes.
+     * @param cells Valeurs de score, rangée par rangée (les valeurs invalides sont remplacées par 0).
+     * @param checksum Somme de contrôle des cellules (`LevelFile::checksum`).
+     * @param problemCount Nombre d'anomalies signalées par l'analyse.
+     */
+    struct Reload {
+        std::string filename;
+        int rows = 0;
+        int cols = 0;
+        std::vector<int8_t> cells;
+        uint64_t checksum = 0;
+        size_t problemCount = 0;
+    };
 
+private:
+    WakeSignal& m_reloadSignal;
+    std::vector<std::string> m_filenames;
+    int m_inotifyFd = -1;
+    int m_stopPipe[2] = { -1, -1 };
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::vector<Reload> m_reloads;
+
+public:
+    explicit LevelFileWatcher(WakeSignal& reloadSignal) : m_reloadSignal(reloadSignal) {}
+    LevelFileWatcher(const LevelFileWatcher&) = delete;
+    LevelFileWatcher& operator=(const LevelFileWatcher&) = delete;
+    ~LevelFileWatcher() { stop(); }
 
     /**
-     * @brief Vérifie les collisions entre la balle et les briques du niveau en utilisant une méthode de balayage (swept collision).
-     *        Si une collision est détectée comme la plus proche dans la trajectoire actuelle de la balle,
-     *        elle informe la balle de cette collision imminente (position, normale, index de la brique).
-     * @param ball La balle à vérifier.
-     * @note Cette méthode ne modifie pas l'état des briques ni de la balle directement, elle prépare la balle à gérer la collision dans son propre `update()`.
+     * @brief Commence la surveillance de fichiers de niveau.
+     * @param filenames Fichiers à surveiller (binaires ou texte, ils n'ont pas besoin d'exister).
+     * @return `true` si la surveillance a démarré.
      */
-    void checkCollisions(Ball& ball) {
-        Vec2 ballPos = ball.getPosition();
-        float ballR = ball.getRadius();
-        Vec2 ballVel = ball.getVelocity();
-    
-        float closestTime = 1.0f; 
-        int closestBrickIndex = -1;
-        Vec2 closestNormal = {0.0f, 0.0f};
-        Vec2 collisionPos = {0.0f, 0.0f}; 
-    
-        for (size_t i = 0; i < m_bricks.size(); ++i) {
-            Brick& brick = m_bricks[i];
-            if (!brick.isActive()) continue;
-            const Rect& bRect = brick.getRect();
-    
-            float left = bRect.x - ballR;
-            float right = bRect.x + bRect.width + ballR;
-            float bottom = bRect.y - ballR; 
-            float top = bRect.y + bRect.height + ballR;
-    
-            float txMin = 0.0f, txMax = 1.0f;
-            if (std::abs(ballVel.x) > 0.0001f) {
-                float invVelX = 1.0f / ballVel.x;
-                txMin = (left - ballPos.x) * invVelX;
-                txMax = (right - ballPos.x) * invVelX;
-                if (txMin > txMax) std::swap(txMin, txMax);
-            } else if (ballPos.x < left || ballPos.x > right) {
-                continue;
-            }
-    
-            float tyMin = 0.0f, tyMax = 1.0f;
-            if (std::abs(ballVel.y) > 0.0001f) {
-                float invVelY = 1.0f / ballVel.y;
-                tyMin = (bottom - ballPos.y) * invVelY; 
-                tyMax = (top - ballPos.y) * invVelY;   
-                if (tyMin > tyMax) std::swap(tyMin, tyMax);
-            } else if (ballPos.y < bottom || ballPos.y > top) {
-                continue;
-            }
-    
-            float tMin = std::max(txMin, tyMin);
-            float tMax = std::min(txMax, tyMax);
-    
-            if (tMin > tMax || tMax < 0.0f || tMin > 1.0f) {
-                continue;
-            }
-    
-            if (tMin < closestTime) {
-                closestTime = tMin;
-                closestBrickIndex = i;
-    
-                collisionPos = {
-                    ballPos.x + ballVel.x * tMin,
-                    ballPos.y + ballVel.y * tMin
-                };
-    
-                if (txMin > tyMin) {
-                    closestNormal = {(ballVel.x > 0.0f) ? -1.0f : 1.0f, 0.0f};
-                } else {
-                    closestNormal = {0.0f, (ballVel.y > 0.0f) ? -1.0f : 1.0f};
-                }
-            }
+    bool start(const std::vector<std::string>& filenames) {
+        stop();
+        m_filenames = filenames;
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0 || pipe2(m_stopPipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+            std::cerr << "Warning: Level hot reload unavailable (inotify: " << std::strerror(errno) << ")." << std::endl;
+            stop();
+            return false;
         }
-    
-        if (closestBrickIndex >= 0) {
-            ball.setNextCollision(collisionPos, closestNormal, closestBrickIndex);
+        for (const std::string& filename : m_filenames) {
+            if (inotify_add_watch(m_inotifyFd, directoryOf(filename).c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY) < 0) {
+                std::cerr << "Warning: Cannot watch " << filename << " for changes: " << std::strerror(errno) << std::endl;
+            }
         }
+        m_thread = std::thread(&LevelFileWatcher::watchLoop, this);
+        return true;
     }
 
-    /**
-     * @brief Traite l'impact confirmé avec une brique (après que la balle a géré la collision).
-     * @param brickIndex L'index de la brique qui a été touchée.
-     * @return Le score obtenu de la brique. 0 si la brique est invalide, inactive ou indestructible.
-     * @note Met à jour `m_activeBrickCount`.
-     */
-    int processBrickHit(int brickIndex) {
-        if (brickIndex < 0 || static_cast<size_t>(brickIndex) >= m_bricks.size()) {
-            return 0;
+    /** @brief Arrête la surveillance. */
+    void stop() {
+        if (m_thread.joinable()) {
+            char byte = 0;
+            [[maybe_unused]] ssize_t written = ::write(m_stopPipe[1], &byte, 1); // Le tube non vide réveille `poll`
+            m_thread.join();
         }
-        Brick& brick = m_bricks[brickIndex];
-        if (!brick.isActive()) {
-            return 0;
+        for (int* fd : { &m_inotifyFd, &m_stopPipe[0], &m_stopPipe[1] }) {
+            if (*fd >= 0) ::close(*fd);
+            *fd = -1;
         }
+    }
 
-        int scoreAwarded = brick.hit(); // This deactivates the brick and returns its score value
+    /**
+     * @brief Reprend un niveau rechargé, s'il y en a un.
+     * @return `true` si `out` a été rempli.
+     */
+    bool takeReload(Reload& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_reloads.empty()) return false;
+        out = std::move(m_reloads.front());
+        m_reloads.erase(m_reloads.begin());
+        return true;
+    }
 
-        if (scoreAwarded > 0 && !brick.isIndestructible()) { // Check if it was a destructible brick that gave score
-            m_activeBrickCount = std::max(0, m_activeBrickCount - 1);
-        }
-        return scoreAwarded;
+private:
+    /** @brief Répertoire contenant un fichier (`.` pour un chemin relatif sans répertoire). */
+    static std::string directoryOf(const std::string& filename) {
+        size_t slash = filename.find_last_of('/');
+        return (slash == std::string::npos) ? "." : (slash == 0 ? "/" : filename.substr(0, slash));
     }
 
-    /** @brief Dessine toutes les briques actives du niveau. */
-    void render() const {
-        for (const Brick& brick : m_bricks) {
-            brick.render();
-        }
+    /** @brief Nom d'un fichier sans son répertoire, tel que le rapporte inotify. */
+    static std::string baseName(const std::string& filename) {
+        size_t slash = filename.find_last_of('/');
+        return (slash == std::string::npos) ? filename : filename.substr(slash + 1);
     }
 
     /**
-     * @brief Dessine la grille de l'éditeur, montrant l'état de chaque cellule.
-     * @param windowWidth Largeur de la fenêtre (non utilisée directement, mais implicite via m_gridStartX/Y).
-     * @param windowHeight Hauteur de la fenêtre (non utilisée directement).
-     * @note Utilise `m_gridState` pour déterminer la couleur de chaque cellule.
+     * @brief Boucle du thread de surveillance.
+     * @note Chaque événement sur un fichier surveillé repousse sa relecture de `Config::LEVEL_RELOAD_DEBOUNCE` secondes :
+     *       une rafale d'écritures ne provoque qu'une relecture, une fois le fichier stable.
      */
-    void renderEditorGrid(float windowWidth, float windowHeight) const {
-        for (int r = 0; r < Config::GRID_ROWS; ++r) {
-            for (int c = 0; c < Config::GRID_COLS; ++c) {
-                 int visualRow = Config::GRID_ROWS - 1 - r;
-                 float cellX = m_gridStartX + c * (Config::BRICK_WIDTH + Config::BRICK_SPACING);
-                 float cellY = m_gridStartY + visualRow * (Config::BRICK_HEIGHT + Config::BRICK_SPACING);
-                 int scoreValue = m_gridState[r][c];
-                 Config::Color color = Config::getBrickColorByScore(scoreValue);
-                 Utils::drawRect(cellX, cellY, Config::BRICK_WIDTH, Config::BRICK_HEIGHT, color);
+    void watchLoop() {
+        PROFILE_THREAD("Level watcher");
+        using Clock = std::chrono::steady_clock;
+        const Clock::duration debounce = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Config::LEVEL_RELOAD_DEBOUNCE));
+        std::vector<Clock::time_point> deadlines(m_filenames.size());
+        std::vector<bool> dirty(m_filenames.size(), false);
+        std::vector<std::string> baseNames;
+        for (const std::string& filename : m_filenames) baseNames.push_back(baseName(filename));
+        alignas(inotify_event) char buffer[4096];
+
+        while (true) {
+            int timeoutMs = -1;
+            Clock::time_point now = Clock::now();
+            for (size_t i = 0; i < dirty.size(); ++i) {
+                if (!dirty[i]) continue;
+                int remainingMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadlines[i] - now).count()) + 1;
+                timeoutMs = (timeoutMs < 0) ? std::max(0, remainingMs) : std::min(timeoutMs, std::max(0, remainingMs));
+            }
+            pollfd fds[2] = { { m_inotifyFd, POLLIN, 0 }, { m_stopPipe[0], POLLIN, 0 } };
+            int ready = poll(fds, 2, timeoutMs);
+            if (ready < 0 && errno != EINTR) return;
+            if (fds[1].revents) return;
+
+            if (ready > 0 && fds[0].revents) {
+                ssize_t length;
+                while ((length = read(m_inotifyFd, buffer, sizeof(buffer))) > 0) {
+                    for (ssize_t offset = 0; offset < length;) {
+                        const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                        if (event->len == 0) continue;
+                        for (size_t i = 0; i < baseNames.size(); ++i) {
+                            if (baseNames[i] != event->name) continue;
+                            dirty[i] = true;
+                            deadlines[i] = Clock::now() + debounce;
+                        }
+                    }
+                }
+            }
+
+            now = Clock::now();
+            for (size_t i = 0; i < dirty.size(); ++i) {
+                if (!dirty[i] || now < deadlines[i]) continue;
+                dirty[i] = false;
+                Reload reload;
+                if (!readLevel(m_filenames[i], reload)) continue;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto previous = std::find_if(m_reloads.begin(), m_reloads.end(), [&](const Reload& r) { return r.filename == reload.filename; });
+                    if (previous != m_reloads.end()) m_reloads.erase(previous);
+                    m_reloads.push_back(std::move(reload));
+                }
+                m_reloadSignal.notify();
             }
         }
     }
 
     /**
-     * @brief Gère la sélection d'une cellule par clic gauche en mode éditeur.
-     * @param mouseX Coordonnée X de la souris.
-     * @param mouseY Coordonnée Y de la souris.
-     * @return 1 si la sélection a changé (nouvelle cellule sélectionnée ou désélection), 0 sinon.
-     * @note Met à jour `m_editorSelectedRow` et `m_editorSelectedCol`.
+     * @brief Lit et analyse un fichier de niveau, binaire ou texte (reconnu à son contenu).
+     * @return `true` si une grille a pu être lue. Un fichier binaire corrompu ou un fichier vide est ignoré.
      */
-    int handleEditorLeftClickSelection(float mouseX, float mouseY) {
-        if (mouseX < m_gridStartX || mouseX > m_gridStartX + m_gridTotalWidth ||
-            mouseY < m_gridStartY || mouseY > m_gridStartY + m_gridTotalHeight) {
-             if (m_editorSelectedRow != -1 || m_editorSelectedCol != -1) {
-                 m_editorSelectedRow = -1;
-                 m_editorSelectedCol = -1;
-                 return 1;
-             }
-             return 0;
+    static bool readLevel(const std::string& filename, Reload& out) {
+        PROFILE_ZONE("LevelFileWatcher::readLevel");
+        MappedFile file;
+        if (!file.open(filename)) return false; // Fichier supprimé ou renommé depuis l'événement
+        out.filename = filename;
+        if (LevelFile::hasMagic(file.data(), file.size())) {
+            LevelFile::Header header;
+            std::string error;
+            if (!LevelFile::readHeader(file.data(), file.size(), header, error)) {
+                std::cerr << "Warning: Ignoring change to " << filename << ": " << error << "." << std::endl;
+                return false;
+            }
+            const int8_t* cells = reinterpret_cast<const int8_t*>(file.data() + header.headerSize);
+            size_t cellCount = static_cast<size_t>(header.rows) * header.cols;
+            if (LevelFile::checksum(reinterpret_cast<const uint8_t*>(cells), cellCount) != header.checksum) {
+                std::cerr << "Warning: Ignoring change to " << filename << ": checksum mismatch." << std::endl;
+                return false;
+            }
+            out.rows = static_cast<int>(header.rows);
+            out.cols = static_cast<int>(header.cols);
+            out.cells.assign(cells, cells + cellCount);
+            for (int8_t& score : out.cells) {
+                if (!Config::isValidScore(score)) { score = 0; ++out.problemCount; }
+            }
+        } else {
+            LevelTextParser::Result parsed = LevelTextParser::parse(reinterpret_cast<const char*>(file.data()), file.size());
+            for (const LevelTextParser::Diagnostic& diagnostic : parsed.diagnostics) {
+                std::cerr << "Warning: " << filename << ":" << diagnostic.line << ":" << diagnostic.column << ": " << diagnostic.message << std::endl;
+            }
+            if (parsed.rows == 0) {
+                std::cerr << "Warning: Ignoring change to " << filename << ": empty level." << std::endl;
+                return false;
+            }
+            out.rows = parsed.rows;
+            out.cols = parsed.cols;
+            out.cells = std::move(parsed.cells);
+            out.problemCount = parsed.errorCount;
         }
+        out.checksum = LevelFile::checksum(reinterpret_cast<const uint8_t*>(out.cells.data()), out.cells.size());
+        return true;
+    }
+};
 
-        float cellWidthWithSpacing = Config::BRICK_WIDTH + Config::BRICK_SPACING;
-        float cellHeightWithSpacing = Config::BRICK_HEIGHT + Config::BRICK_SPACING;
+/**
+ * @struct CursorSample
+ * @brief Position du curseur relue juste avant le rendu (mode `--late-latch`), transmise du thread principal à la simulation.
+ * @param x Position X du curseur.
+ * @param time Instant de la lecture (`glfwGetTime`), 0 si aucune lecture.
+ */
+struct CursorSample {
+    float x = 0.0f;
+    double time = 0.0;
+};
 
-        int visualCol = static_cast<int>((mouseX - m_gridStartX) / cellWidthWithSpacing);
-        int visualRow = static_cast<int>((mouseY - m_gridStartY) / cellHeightWithSpacing);
+/**
+ * @enum UiButton
+ * @brief Boutons du menu principal et de l'éditeur, indices dans `UiLayout::buttons`.
+ */
+enum class UiButton : uint8_t { PLAY, EDITOR, QUIT, SAVE, BACK, PLAYTEST, COUNT };
 
-        visualCol = std::clamp(visualCol, 0, Config::GRID_COLS - 1);
-        visualRow = std::clamp(visualRow, 0, Config::GRID_ROWS - 1);
+/**
+ * @struct UiLayout
+ * @brief Disposition des boutons du menu et de l'éditeur, calculée une fois par taille de fenêtre.
+ *
+ * La simulation la reconstruit lorsque la taille du framebuffer change, s'en sert pour tester les clics et la publie
+ * dans `FrameSnapshot::ui` : le rendu dessine exactement les rectangles testés, sans refaire la mise en page ni
+ * mesurer les libellés à chaque trame.
+ *
+ * @param width Largeur de la fenêtre pour laquelle la disposition a été calculée.
+ * @param height Hauteur de la fenêtre pour laquelle la disposition a été calculée.
+ * @param buttons Boutons, indexés par `UiButton`.
+ * @param levelBrowser Zone du nom du niveau choisi dans le menu (navigateur de l'option `--pack=`).
+ */
+struct UiLayout {
+    /**
+     * @struct Button
+     * @brief Géométrie et apparence d'un bouton.
+     * @param rect Rectangle du bouton (zone de clic).
+     * @param label Libellé.
+     * @param color Couleur de fond.
+     * @param textColor Couleur du libellé.
+     * @param textScale Échelle du libellé.
+     * @param textBaselineY Ligne de base du libellé (centré horizontalement dans le bouton).
+     */
+    struct Button {
+        Rect rect;
+        const char* label = "";
+        Config::Color color = Config::COLOR_TEXT_DEFAULT;
+        Config::Color textColor = Config::COLOR_TEXT_DEFAULT;
+        float textScale = 1.0f;
+        float textBaselineY = 0.0f;
+
+        /** @brief Indique si un point (origine en bas à gauche) est dans le bouton. */
+        bool contains(float x, float y) const { return x >= rect.x && x <= rect.x + rect.width && y >= rect.y && y <= rect.y + rect.height; }
+    };
 
-        // Convertit la rangée visuelle (0=bas) en rangée logique (0=haut) pour `m_gridState`
-        int logicalRow = Config::GRID_ROWS - 1 - visualRow;
-        int logicalCol = visualCol; 
+    static constexpr std::array<UiButton, 3> MENU_BUTTONS = { UiButton::PLAY, UiButton::EDITOR, UiButton::QUIT };
+    static constexpr std::array<UiButton, 3> EDITOR_BUTTONS = { UiButton::SAVE, UiButton::BACK, UiButton::PLAYTEST };
 
-        float brickX = m_gridStartX + logicalCol * cellWidthWithSpacing;
-        float brickY = m_gridStartY + visualRow * cellHeightWithSpacing;
+    int width = 0;
+    int height = 0;
+    std::array<Button, static_cast<size_t>(UiButton::COUNT)> buttons;
+    Rect levelBrowser;
 
-        if (mouseX >= brickX && mouseX <= brickX + Config::BRICK_WIDTH &&
-            mouseY >= brickY && mouseY <= brickY + Config::BRICK_HEIGHT)
-        {
-            if (m_editorSelectedRow != logicalRow || m_editorSelectedCol != logicalCol) {
-                m_editorSelectedRow = logicalRow;
-                m_editorSelectedCol = logicalCol;
-                return 1;
-            }
-            return 0;
-        } else {
-            if (m_editorSelectedRow != -1 || m_editorSelectedCol != -1) {
-                m_editorSelectedRow = -1;
-                m_editorSelectedCol = -1;
-                return 1;
-            }
-            return 0;
-        }
-    }
+    /** @brief Obtient un bouton. */
+    const Button& button(UiButton id) const { return buttons[static_cast<size_t>(id)]; }
 
     /**
-     * @brief Gère le placement d'une brique par clic droit en mode éditeur sur la cellule sélectionnée.
-     * @param isShiftDown `true` si la touche Maj est enfoncée (pour placer une brique indestructible).
-     * @return `true` si une brique a été placée (s'il y avait une sélection), `false` sinon.
-     * @note Modifie `m_gridState` pour la cellule sélectionnée.
+     * @brief Calcule la disposition pour une taille de fenêtre.
+     * @param text Moteur de rendu du texte (mesure des libellés de l'éditeur).
+     * @param width Largeur de la fenêtre.
+     * @param height Hauteur de la fenêtre.
+     * @note Menu : trois boutons centrés sous le navigateur de niveaux. Éditeur : trois boutons centrés en bas, à la taille de leur libellé.
      */
-    bool handleEditorRightClickPlace(bool isShiftDown) {
-        if (!hasEditorSelection()) {
-            return false;
+    static UiLayout build(const TextRenderer& text, int width, int height) {
+        UiLayout ui;
+        ui.width = width;
+        ui.height = height;
+        float widthScale = static_cast<float>(width) / Config::DEFAULT_WINDOW_WIDTH;
+
+        float buttonW = width * 0.3f; float buttonH = height * 0.08f;
+        float spacingY = height * 0.04f; float centerX = width / 2.0f;
+        float topButtonY = height * 0.6f;
+        float textScale = 0.9f * widthScale;
+        float textYOffset = (buttonH - text.getTextHeight(textScale)) / 2.0f;
+        Rect playRect = { centerX - buttonW / 2.0f, topButtonY, buttonW, buttonH };
+        Rect editorRect = { centerX - buttonW / 2.0f, topButtonY - buttonH - spacingY, buttonW, buttonH };
+        Rect quitRect = { centerX - buttonW / 2.0f, editorRect.y - buttonH - spacingY, buttonW, buttonH };
+        ui.buttons[static_cast<size_t>(UiButton::PLAY)] = { playRect, "Play Game", Config::COLOR_BUTTON_PLAY, Config::COLOR_TEXT_DEFAULT, textScale, playRect.y - textYOffset };
+        ui.buttons[static_cast<size_t>(UiButton::EDITOR)] = { editorRect, "Level Editor", Config::COLOR_BUTTON_EDITOR, {0.1f, 0.1f, 0.1f}, textScale, editorRect.y - textYOffset };
+        ui.buttons[static_cast<size_t>(UiButton::QUIT)] = { quitRect, "Quit", Config::COLOR_BUTTON_QUIT, Config::COLOR_TEXT_DEFAULT, textScale, quitRect.y - textYOffset };
+        ui.levelBrowser = { centerX - buttonW / 2.0f, topButtonY + buttonH + spacingY * 0.5f, buttonW, buttonH * 0.6f };
+
+        float buttonPaddingX = 30.0f; float editorButtonH = height * 0.07f;
+        float buttonY = height * 0.05f; float buttonSpacingX = width * 0.05f;
+        float editorTextScale = 0.7f * widthScale;
+        float editorTextYOffset = (editorButtonH - text.getTextHeight(editorTextScale)) / 2.0f;
+        const char* backText = "Back to Menu (M)"; const char* saveText = "Save Level"; const char* playtestText = "Playtest (P)";
+        float backButtonW = text.getTextWidth(backText, editorTextScale) + buttonPaddingX;
+        float saveButtonW = text.getTextWidth(saveText, editorTextScale) + buttonPaddingX;
+        float playtestButtonW = text.getTextWidth(playtestText, editorTextScale) + buttonPaddingX;
+        float backButtonX = (width - (backButtonW + saveButtonW + playtestButtonW + 2.0f * buttonSpacingX)) / 2.0f;
+        Rect backRect = { backButtonX, buttonY, backButtonW, editorButtonH };
+        Rect saveRect = { backRect.x + backButtonW + buttonSpacingX, buttonY, saveButtonW, editorButtonH };
+        Rect playtestRect = { saveRect.x + saveButtonW + buttonSpacingX, buttonY, playtestButtonW, editorButtonH };
+        ui.buttons[static_cast<size_t>(UiButton::SAVE)] = { saveRect, saveText, Config::COLOR_BUTTON_SAVE, Config::COLOR_TEXT_DEFAULT, editorTextScale, saveRect.y - editorTextYOffset };
+        ui.buttons[static_cast<size_t>(UiButton::BACK)] = { backRect, backText, Config::COLOR_BUTTON_BACK, Config::COLOR_TEXT_DEFAULT, editorTextScale, backRect.y - editorTextYOffset };
+        ui.buttons[static_cast<size_t>(UiButton::PLAYTEST)] = { playtestRect, playtestText, Config::COLOR_BUTTON_PLAY, Config::COLOR_TEXT_DEFAULT, editorTextScale, playtestRect.y - editorTextYOffset };
+        return ui;
+    }
+
+    /** @brief Enregistre le dessin d'une liste de boutons à partir de la géométrie calculée. */
+    template <size_t N>
+    void renderButtons(RenderQueue& queue, const std::array<UiButton, N>& ids) const {
+        for (UiButton id : ids) {
+            const Button& b = button(id);
+            queue.rect(b.rect, b.color, RenderLayer::UI);
+            queue.text(b.label, b.rect.x + b.rect.width / 2.0f, b.textBaselineY, b.textScale, b.textColor);
         }
+    }
+};
 
-        int row = m_editorSelectedRow;
-        int col = m_editorSelectedCol;
-        int scoreValue;
+/**
+ * @struct FrameSnapshot
+ * @brief État immuable publié par le thread de simulation et consommé par le thread de rendu.
+ * @param sequence Numéro de l'état publié (incrémenté à chaque pas de simulation).
+ * @param state État du jeu (Menu, Jeu, Éditeur, Sortie).
+ * @param windowWidth Largeur du framebuffer utilisée par la simulation.
+ * @param windowHeight Hauteur du framebuffer utilisée par la simulation.
+ * @param paddle Copie de la raquette.
+ * @param ball Copie de la balle.
+ * @param grid Position et dimensions de la grille de briques.
+ * @param bricks Grille de briques partagée (remplacée uniquement quand le niveau change).
+ * @param editorSelectedRow Rangée sélectionnée dans l'éditeur (-1 si aucune).
+ * @param editorSelectedCol Colonne sélectionnée dans l'éditeur (-1 si aucune).
+ * @param editorAnchorRow Rangée de l'ancre des outils de zone de l'éditeur (-1 si aucune).
+ * @param editorAnchorCol Colonne de l'ancre des outils de zone de l'éditeur (-1 si aucune).
+ * @param score Score du joueur.
+ * @param lives Vies restantes.
+ * @param allBricksCleared Indique si toutes les briques destructibles ont été éliminées.
+ * @param statusMessage Message d'état affiché à l'écran.
+ * @param simStepMs Durée du dernier pas de simulation en millisecondes.
+ * @param collisionTests Nombre de tests balle/brique depuis l'état publié précédent.
+ * @param paddleFollowsCursor Indique que la raquette suit le curseur dans cet état (elle peut alors être relue tardivement).
+ * @param inputEventTime Instant (`glfwGetTime`) du plus ancien déplacement du curseur appliqué à la raquette depuis l'état
+ *        publié précédent, 0 si aucun. Sert à mesurer la latence d'entrée jusqu'à l'échange des tampons.
+ * @param packLevel Niveau de l'archive choisi dans le menu (-1 pour `Config::LEVEL_FILENAME`).
+ * @param ui Disposition des boutons partagée (remplacée uniquement quand la taille de la fenêtre change).
+ * @param playtest Indique que la partie en cours teste la grille de l'éditeur (M ramène à l'éditeur).
+ * @param heatmap Carte de chaleur de l'éditeur partagée (nulle si elle est masquée).
+ * @param heatmapMode Affichage de la carte de chaleur.
+ * @param effects Entités visuelles de la partie (éclats des briques détruites), vide hors du mode Jeu.
+ */
+struct FrameSnapshot {
+    uint64_t sequence = 0;
+    GameState state = GameState::MENU;
+    int windowWidth = Config::DEFAULT_WINDOW_WIDTH;
+    int windowHeight = Config::DEFAULT_WINDOW_HEIGHT;
+    Paddle paddle;
+    Ball ball;
+    GridLayout grid;
+    std::shared_ptr<const BrickField> bricks;
+    int editorSelectedRow = -1;
+    int editorSelectedCol = -1;
+    int editorAnchorRow = -1;
+    int editorAnchorCol = -1;
+    int score = 0;
+    int lives = 0;
+    bool allBricksCleared = false;
+    std::string statusMessage;
+    float simStepMs = 0.0f;
+    uint32_t collisionTests = 0;
+    bool paddleFollowsCursor = false;
+    double inputEventTime = 0.0;
+    int packLevel = -1;
+    std::shared_ptr<const UiLayout> ui;
+    bool playtest = false;
+    std::shared_ptr<const HitHeatmap> heatmap;
+    HeatmapMode heatmapMode = HeatmapMode::OFF;
+    EntityWorld effects;
+};
 
-        if (isShiftDown) {
-            scoreValue = Config::SCORE_INDESTRUCTIBLE;
-        } else {
-            // Détermine le score en fonction de la rangée logique (0=haut à 7=bas)
-            if (row < 2) scoreValue = Config::SCORE_RED;      // Rows 0, 1
-            else if (row < 4) scoreValue = Config::SCORE_ORANGE;  // Rows 2, 3
-            else if (row < 6) scoreValue = Config::SCORE_GREEN; // Rows 4, 5
-            else scoreValue = Config::SCORE_YELLOW;                 // Rows 6, 7
-        }
+/**
+* @class StaticLayerCache
+* @brief Suit, côté thread de rendu, le contenu de la couche statique (bordures et briques) conservée par le backend.
+*
+* La couche n'est reconstruite entièrement que lorsque l'état du jeu, la taille du framebuffer ou la position de la grille
+* changent, ou lorsque la grille publiée ne fait pas directement suite à celle en cache. Sinon, seules les cellules listées
+* dans `BrickField::changedCells` (brique touchée, modification dans l'éditeur) sont redessinées.
+*
+* @param m_field Grille actuellement dessinée dans la couche.
+* @param m_grid Position de la grille dans la couche.
+* @param m_width Largeur de la couche.
+* @param m_height Hauteur de la couche.
+* @param m_state État du jeu pour lequel la couche a été dessinée (jeu ou éditeur).
+* @param m_valid Indique si la couche contient un contenu utilisable.
+*/
+class StaticLayerCache {
+public:
+    /** @brief Type de mise à jour nécessaire pour afficher un état. */
+    enum class Update { NONE, PARTIAL, FULL };
 
-        m_gridState[row][col] = scoreValue;
-        return true;
-    }
+private:
+    std::shared_ptr<const BrickField> m_field;
+    GridLayout m_grid;
+    int m_width = 0;
+    int m_height = 0;
+    GameState m_state = GameState::MENU;
+    bool m_valid = false;
 
-    /** @brief Efface la brique sélectionnée en mode éditeur (met sa valeur de score à 0 dans `m_gridState`). */
-    void clearSelectedBrick() {
-         if (hasEditorSelection()) {
-             m_gridState[m_editorSelectedRow][m_editorSelectedCol] = 0;
-         }
+public:
+    /** @brief Détermine la mise à jour nécessaire pour que la couche corresponde à l'état `snap`. */
+    Update compare(const FrameSnapshot& snap) const {
+        if (!m_valid || !m_field || !snap.bricks || snap.state != m_state ||
+            snap.windowWidth != m_width || snap.windowHeight != m_height ||
+            snap.grid.startX != m_grid.startX || snap.grid.startY != m_grid.startY ||
+            snap.grid.totalWidth != m_grid.totalWidth || snap.grid.totalHeight != m_grid.totalHeight) {
+            return Update::FULL;
+        }
+        if (snap.bricks == m_field) return Update::NONE;
+        if (snap.bricks->fullChange || snap.bricks->baseVersion != m_field->version) return Update::FULL;
+        return Update::PARTIAL;
     }
 
-    /** @brief Vérifie s'il y a une cellule sélectionnée en mode éditeur. */
-    bool hasEditorSelection() const {
-        return m_editorSelectedRow >= 0 && m_editorSelectedRow < Config::GRID_ROWS &&
-               m_editorSelectedCol >= 0 && m_editorSelectedCol < Config::GRID_COLS;
+    /** @brief Enregistre que la couche correspond désormais à l'état `snap`. */
+    void accept(const FrameSnapshot& snap) {
+        m_field = snap.bricks; m_grid = snap.grid;
+        m_width = snap.windowWidth; m_height = snap.windowHeight;
+        m_state = snap.state; m_valid = true;
     }
 
+    /** @brief Force une reconstruction complète à la prochaine trame. */
+    void invalidate() { m_valid = false; m_field.reset(); }
+};
+
+/**
+* @class PerfOverlay
+* @brief Overlay de performances (F3), tenu par le thread de rendu : temps de trame courant, moyen et p99,
+*        répartition simulation/rendu, latence d'entrée, appels de dessin, tests de collision, allocations et graphe glissant des temps de trame.
+* @note Fond, graphe et texte sont enregistrés uniquement en quads de l'atlas de glyphes dans la couche `DEBUG_OVERLAY` :
+*       le backend dessine tout l'overlay en un seul appel, pour ne pas fausser les mesures qu'il affiche.
+* @param m_frameMs Temps de trame des dernières trames en millisecondes (tampon circulaire).
+* @param m_renderMs Temps de rendu CPU (enregistrement et soumission) des dernières trames.
+* @param m_next Prochaine position d'écriture dans les tampons.
+* @param m_count Nombre de trames mémorisées.
+* @param m_sorted Tampon de tri pour le calcul du p99 (capacité réservée, sans allocation par trame).
+*/
+class PerfOverlay {
+public:
     /**
-     * @brief Dessine un contour de surbrillance autour de la cellule sélectionnée en mode éditeur.
-     * @param windowWidth Largeur de la fenêtre (non utilisée).
-     * @param windowHeight Hauteur de la fenêtre (non utilisée).
+     * @struct Counters
+     * @brief Compteurs de la trame affichés par l'overlay.
      */
-    void highlightEditorCell(float windowWidth, float windowHeight) const {
-        if (!hasEditorSelection()) return;
-        float cellWidthWithSpacing = Config::BRICK_WIDTH + Config::BRICK_SPACING;
-        float cellHeightWithSpacing = Config::BRICK_HEIGHT + Config::BRICK_SPACING;
-        int visualRow = Config::GRID_ROWS - 1 - m_editorSelectedRow;
-        float cellX = m_gridStartX + m_editorSelectedCol * cellWidthWithSpacing;
-        float cellY = m_gridStartY + visualRow * cellHeightWithSpacing;
-        float outlinePadding = 2.0f;
-        glColor3f(Config::COLOR_EDITOR_SELECT.r, Config::COLOR_EDITOR_SELECT.g, Config::COLOR_EDITOR_SELECT.b);
-        glLineWidth(2.5f); glBegin(GL_LINE_LOOP);
-        glVertex2f(cellX - outlinePadding, cellY - outlinePadding);
-        glVertex2f(cellX + Config::BRICK_WIDTH + outlinePadding, cellY - outlinePadding);
-        glVertex2f(cellX + Config::BRICK_WIDTH + outlinePadding, cellY + Config::BRICK_HEIGHT + outlinePadding);
-        glVertex2f(cellX - outlinePadding, cellY + Config::BRICK_HEIGHT + outlinePadding);
-        glEnd(); glLineWidth(1.0f);
-    }
-
-    /** @brief Obtient le nombre de briques destructibles actives. */
-    int getActiveBrickCount() const { return m_activeBrickCount; }
-
-    /** @brief Vérifie si toutes les briques destructibles ont été éliminées. */
-    bool areAllBricksCleared() const { return m_activeBrickCount <= 0; }
+    struct Counters {
+        float updateMs;
+        float latencyP50Ms;
+        float latencyP99Ms;
+        int drawCalls;
+        uint32_t collisionTests;
+        uint64_t allocationsPerFrame;
+        uint64_t totalAllocations;
+    };
+private:
+    std::array<float, Config::PERF_GRAPH_SAMPLES> m_frameMs{};
+    std::array<float, Config::PERF_GRAPH_SAMPLES> m_renderMs{};
+    size_t m_next = 0;
+    size_t m_count = 0;
+    std::vector<float> m_sorted;
+public:
+    PerfOverlay() { m_sorted.reserve(Config::PERF_GRAPH_SAMPLES); }
 
-    /** @brief Obtient la valeur de score de la brique actuellement sélectionnée dans l'éditeur. */
-    int getSelectedBrickScore() const {
-        if (hasEditorSelection()) return m_gridState[m_editorSelectedRow][m_editorSelectedCol];
-        return 0;
+    /** @brief Mémorise le temps d'une trame et la part de rendu CPU, en millisecondes. */
+    void addFrame(float frameMs, float renderMs) {
+        m_frameMs[m_next] = frameMs; m_renderMs[m_next] = renderMs;
+        m_next = (m_next + 1) % Config::PERF_GRAPH_SAMPLES;
+        m_count = std::min(m_count + 1, Config::PERF_GRAPH_SAMPLES);
     }
 
-    /** @brief Obtient l'index de la ligne (logique) de la brique sélectionnée dans l'éditeur. */
-    int getSelectedRow() const { return m_editorSelectedRow; }
-    
-    /** @brief Obtient l'index de la colonne (logique) de la brique sélectionnée dans l'éditeur. */
-    int getSelectedCol() const { return m_editorSelectedCol; }
-    
     /**
-      * @brief Modifie directement l'état d'une cellule dans la grille `m_gridState`.
-      * @param row Index de la rangée logique (0 en haut).
-      * @param col Index de la colonne logique (0 à gauche).
-      * @param scoreValue La nouvelle valeur de score pour la cellule. Doit être valide.
-      */
-    void setGridState(int row, int col, int scoreValue) {
-        if (row >= 0 && row < Config::GRID_ROWS && col >= 0 && col < Config::GRID_COLS) {
-            bool validScore = false;
-            if (scoreValue == 0 || scoreValue == Config::SCORE_INDESTRUCTIBLE ||
-                scoreValue == Config::SCORE_YELLOW || scoreValue == Config::SCORE_GREEN ||
-                scoreValue == Config::SCORE_ORANGE || scoreValue == Config::SCORE_RED) {
-                validScore = true;
-            }
-            if (validScore) {
-               m_gridState[row][col] = scoreValue;
-            } else {
-                std::cerr << "Warning: Attempted to set invalid score " << scoreValue << " at [" << row << "," << col << "]" << std::endl;
-                m_gridState[row][col] = 0;
-            }
+     * @brief Enregistre l'overlay dans le coin supérieur gauche.
+     * @param queue Tampon de commandes de la trame.
+     * @param textRenderer Fournit l'atlas de glyphes.
+     * @param counters Compteurs de la trame.
+     * @param targetHz Fréquence cible (ligne de budget du graphe).
+     * @param windowHeight Hauteur du framebuffer.
+     */
+    void record(RenderQueue& queue, const TextRenderer& textRenderer, const Counters& counters, double targetHz, int windowHeight) {
+        GLuint atlas = textRenderer.getAtlasTexture();
+        if (atlas == 0) return;
+        const Rect solid = textRenderer.getAtlasSolidUV();
+        const float scale = Config::PERF_TEXT_SCALE;
+        const float lineHeight = textRenderer.getTextHeight(scale);
+        const float margin = 10.0f, padding = 8.0f, panelWidth = 380.0f, graphHeight = 60.0f;
+        const int lineCount = 5;
+        const float panelHeight = padding * 3.0f + lineHeight * lineCount + graphHeight;
+        const float top = static_cast<float>(windowHeight) - margin;
+
+        size_t newest = (m_next + Config::PERF_GRAPH_SAMPLES - 1) % Config::PERF_GRAPH_SAMPLES;
+        float currentMs = m_count ? m_frameMs[newest] : 0.0f;
+        float renderMs = m_count ? m_renderMs[newest] : 0.0f;
+        float averageMs = 0.0f, p99Ms = 0.0f;
+        if (m_count) {
+            m_sorted.assign(m_frameMs.begin(), m_frameMs.begin() + m_count);
+            for (float ms : m_sorted) averageMs += ms;
+            averageMs /= m_count;
+            size_t p99Index = std::min(m_count - 1, static_cast<size_t>(0.99 * (m_count - 1) + 0.5));
+            std::nth_element(m_sorted.begin(), m_sorted.begin() + p99Index, m_sorted.end());
+            p99Ms = m_sorted[p99Index];
+        }
+
+        queue.atlasQuad({ margin, top - panelHeight, panelWidth, panelHeight }, solid, atlas, {0.0f, 0.0f, 0.0f}, 0.65f);
+
+        char line[128];
+        const Config::Color textColor = {1.0f, 1.0f, 1.0f};
+        float baseline = top - padding - lineHeight * 0.75f;
+        float textX = margin + padding;
+        std::snprintf(line, sizeof(line), "Frame %.2f ms  avg %.2f  p99 %.2f", currentMs, averageMs, p99Ms);
+        textRenderer.recordAtlasText(queue, line, textX, baseline, scale, textColor); baseline -= lineHeight;
+        std::snprintf(line, sizeof(line), "Update %.2f ms  Render %.2f ms", counters.updateMs, renderMs);
+        textRenderer.recordAtlasText(queue, line, textX, baseline, scale, textColor); baseline -= lineHeight;
+        std::snprintf(line, sizeof(line), "Input latency p50 %.1f ms  p99 %.1f ms", counters.latencyP50Ms, counters.latencyP99Ms);
+        textRenderer.recordAtlasText(queue, line, textX, baseline, scale, textColor); baseline -= lineHeight;
+        std::snprintf(line, sizeof(line), "Draw calls %d  Collision tests %u", counters.drawCalls, counters.collisionTests);
+        textRenderer.recordAtlasText(queue, line, textX, baseline, scale, textColor); baseline -= lineHeight;
+        std::snprintf(line, sizeof(line), "Allocs/frame %llu  total %llu", static_cast<unsigned long long>(counters.allocationsPerFrame),
+                      static_cast<unsigned long long>(counters.totalAllocations));
+        textRenderer.recordAtlasText(queue, line, textX, baseline, scale, textColor);
+
+        // Graphe glissant : une barre par trame, de la plus ancienne (à gauche) à la plus récente
+        const float graphX = margin + padding, graphY = top - panelHeight + padding, graphWidth = panelWidth - 2.0f * padding;
+        const float barWidth = graphWidth / Config::PERF_GRAPH_SAMPLES;
+        const float budgetMs = targetHz > 0.0 ? static_cast<float>(1000.0 / targetHz) : 0.0f;
+        for (size_t i = 0; i < m_count; ++i) {
+            size_t index = (m_next + Config::PERF_GRAPH_SAMPLES - m_count + i) % Config::PERF_GRAPH_SAMPLES;
+            float ms = m_frameMs[index];
+            float barHeight = std::min(ms / Config::PERF_GRAPH_MAX_MS, 1.0f) * graphHeight;
+            Config::Color color = (ms <= budgetMs * 1.05f) ? Config::Color{0.2f, 0.9f, 0.2f}
+                                : (ms <= budgetMs * 2.0f) ? Config::Color{0.95f, 0.8f, 0.1f} : Config::Color{0.95f, 0.2f, 0.2f};
+            float x = graphX + (Config::PERF_GRAPH_SAMPLES - m_count + i) * barWidth;
+            queue.atlasQuad({ x, graphY, barWidth, barHeight }, solid, atlas, color, 0.9f);
+        }
+        if (budgetMs > 0.0f && budgetMs < Config::PERF_GRAPH_MAX_MS) {
+            queue.atlasQuad({ graphX, graphY + budgetMs / Config::PERF_GRAPH_MAX_MS * graphHeight, graphWidth, 1.0f }, solid, atlas, {1.0f, 1.0f, 1.0f}, 0.6f);
         }
     }
 };
@@ -1603,21 +6406,74 @@ public:
 * @param m_currentState État actuel du jeu (Menu, Jeu, Éditeur, Sortie).
 * @param m_inputManager Gestionnaire d'entrées.
 * @param m_textRenderer Moteur de rendu de texte.
+* @param m_renderQueue Tampon de commandes de rendu enregistré à chaque trame.
+* @param m_renderBackend Backend exécutant le tampon (OpenGL ou nul).
+* @param m_useNullRenderBackend Indique si le backend nul doit être utilisé (option `--null-render`).
+* @param m_framePacer Cadencement des trames du thread de rendu et mesure de leur durée.
+* @param m_requestedTargetHz Fréquence cible demandée (option `--target-hz=`), 0 pour la fréquence du moniteur.
+* @param m_traceExportRequested Export de la trace de profilage demandé par la touche F9 (thread principal).
+* @param m_traceAtExit Indique si la trace de profilage doit être exportée à la sortie (option `--trace`).
+* @param m_perfOverlay Overlay de performances (thread principal).
+* @param m_showPerfOverlay Indique si l'overlay de performances est affiché (bascule avec F3).
+* @param m_lastSceneDrawCalls Appels de dessin de la trame précédente, hors overlay.
+* @param m_lastAllocationCount Valeur de `g_allocationCount` au début de la trame précédente.
+* @param m_allocationsPerFrame Allocations (tous threads) pendant la trame précédente.
+* @param m_lastStepMs Durée du dernier pas de simulation en millisecondes (thread de simulation).
+* @param m_stepCursorEventTime Instant du plus ancien déplacement du curseur reçu pendant le pas en cours, 0 si aucun (thread de simulation).
+* @param m_pendingInputTime Instant du plus ancien déplacement du curseur appliqué à la raquette et pas encore publié (thread de simulation).
+* @param m_inputLatency Histogramme des latences d'entrée (thread principal).
+* @param m_lastLatencySequence Numéro du dernier état publié dont la latence a été mesurée (thread principal).
+* @param m_lateLatch Mode de lecture tardive du curseur (option `--late-latch`).
+* @param m_latchedCursor Dernière position du curseur relue au rendu, du thread principal vers la simulation.
+* @param m_stepTime Instant (`glfwGetTime`) du début du pas de simulation en cours.
+* @param m_prevStepTime Instant du début du pas précédent (les événements du pas en cours ont été reçus entre les deux).
+* @param m_oldestUndisplayedCursorTime Instant du plus ancien déplacement du curseur reçu par le thread principal et pas
+*        encore affiché par une raquette relue tardivement, 0 si aucun (mesure de latence en mode `--late-latch`).
+* @param m_paddleLatchedThisFrame Indique que la trame en cours affiche une raquette relue tardivement.
+* @param m_staticQueue Tampon des commandes de mise à jour de la couche statique (thread de rendu).
+* @param m_staticLayer Suivi du contenu de la couche statique (thread de rendu).
 * @param m_paddle Objet raquette.
 * @param m_ball Objet balle.
 * @param m_level Objet niveau, gérant les briques.
-* @param m_lastTime Temps de la dernière mise à jour, pour calculer le delta-temps.
+* @param m_editorTool Outil de l'éditeur appliqué par clic droit.
+* @param m_editorBrush Valeur de score posée par les outils de l'éditeur (`Level::BRUSH_BY_ROW` : couleur de la rangée).
+* @param m_playtesting Indique que la partie en cours teste la grille de l'éditeur (sélection, zoom et historique conservés).
+* @param m_editorDragging Indique que la vue de l'éditeur est déplacée avec le bouton du milieu.
+* @param m_editorDragX Position X du curseur au pas précédent du déplacement.
+* @param m_editorDragY Position Y du curseur au pas précédent du déplacement.
+* @param m_levelPack Archive de niveaux ouverte par l'option `--pack=` (index en lecture seule, partagé par les deux threads).
+* @param m_packLevel Niveau de l'archive choisi dans le menu, -1 pour `Config::LEVEL_FILENAME` (thread de simulation).
+* @param m_snapshots Triple tampon des états publiés par la simulation et lus par le rendu.
+* @param m_uiLayout Disposition des boutons pour la taille actuelle de la fenêtre (thread de simulation, publiée dans les états).
+* @param m_publishedBricks Dernière grille publiée, réutilisée tant que la version du niveau ne change pas.
+* @param m_publishedBricksEditorView Indique si `m_publishedBricks` est la vue éditeur de la grille.
+* @param m_snapshotSequence Numéro du dernier état publié.
+* @param m_simRunning Indique si le thread de simulation doit continuer à tourner.
+* @param m_quitRequested Demande de fermeture émise par la simulation (Échap, bouton Quitter).
+* @param m_inputSignal Réveille le thread de simulation inactif lorsque le thread principal a reçu des événements.
+* @param m_levelSaver Sauvegarde en arrière-plan des niveaux de l'éditeur (réveille la simulation par `m_inputSignal` une fois terminée).
+* @param m_savedLevelChecksum Somme de contrôle de la dernière grille écrite dans `Config::LEVEL_FILENAME` par le jeu
+*        (ses propres sauvegardes ne sont pas rechargées à chaud).
+* @param m_levelWatcher Surveillance de `Config::LEVEL_FILENAME` et `Config::LEVEL_TEXT_FILENAME` (réveille la simulation par `m_inputSignal`).
+* @param m_pendingReload Niveau rechargé en attente d'application : une partie en cours ne le reçoit qu'une fois la balle arrêtée.
+* @param m_hasPendingReload Indique que `m_pendingReload` attend d'être appliqué.
+* @param m_heatmapSampler Parties simulées de la grille de l'éditeur pour la carte de chaleur (réveille la simulation par `m_inputSignal`).
+* @param m_heatmapMode Affichage de la carte de chaleur dans l'éditeur (touche H).
+* @param m_heatmapActive Indique que `m_heatmapSampler` simule la grille (carte affichée dans l'éditeur).
+* @param m_heatmapLevelVersion Version du niveau confiée à `m_heatmapSampler`.
+* @param m_heatmapResultVersion Version des résultats de `m_heatmapSampler` déjà repris dans `m_heatmap`.
+* @param m_heatmap Dernière carte de chaleur reprise (nulle si la carte est masquée).
+* @param m_lastPublishedView Contenu visible du dernier état publié, pour ne publier en mode inactif que si l'affichage change.
+* @param m_redrawRequested Demande de redessin de la fenêtre (exposition, redimensionnement), thread principal.
+* @param m_renderedFrames Nombre de trames dessinées et affichées.
+* @param m_skippedFrames Nombre de trames non dessinées en mode inactif car identiques à la précédente.
 * @param m_statusMessage Message à afficher à l'écran (ex: "Game Over").
 * @param m_lives Nombre de vies restantes pour le joueur.
 * @param m_score Score actuel du joueur.
 * @param m_logoTextureID ID de la texture OpenGL pour le logo.
 * @param m_logoWidth Largeur de la texture du logo.
 * @param m_logoHeight Hauteur de la texture du logo.
-* @param m_bricksHitInCurrentGame Compteur de briques touchées dans la partie en cours (pour les bonus de vitesse).
-* @param m_firstOrangeBrickHit Indicateur si la première brique orange a été touchée (pour bonus de vitesse).
-* @param m_firstRedBrickHit Indicateur si la première brique rouge a été touchée (pour bonus de vitesse).
-* @param m_speedBoost4thBrickDone Indicateur si le bonus de vitesse pour la 4ème brique a été appliqué.
-* @param m_speedBoost12thBrickDone Indicateur si le bonus de vitesse pour la 12ème brique a été appliqué.
+* @param m_speedBoosts Accélérations de la balle déjà appliquées dans la partie en cours.
 */
 class Game {
 private:
@@ -1627,10 +6483,87 @@ private:
     GameState m_currentState = GameState::MENU;
     InputManager m_inputManager;
     TextRenderer m_textRenderer;
+    RenderQueue m_renderQueue;
+    std::unique_ptr<RenderBackend> m_renderBackend;
+    bool m_useNullRenderBackend = false;
+    FramePacer m_framePacer;
+    double m_requestedTargetHz = 0.0;
+    bool m_traceExportRequested = false;
+    bool m_traceAtExit = false;
+    PerfOverlay m_perfOverlay;
+    bool m_showPerfOverlay = false;
+    int m_lastSceneDrawCalls = 0;
+    uint64_t m_lastAllocationCount = 0;
+    uint64_t m_allocationsPerFrame = 0;
+    float m_lastStepMs = 0.0f;
+    double m_stepCursorEventTime = 0.0;
+    double m_pendingInputTime = 0.0;
+    LatencyHistogram m_inputLatency;
+    uint64_t m_lastLatencySequence = 0;
+    bool m_lateLatch = false;
+    TripleBuffer<CursorSample> m_latchedCursor;
+    double m_stepTime = 0.0;
+    double m_prevStepTime = 0.0;
+    double m_oldestUndisplayedCursorTime = 0.0;
+    bool m_paddleLatchedThisFrame = false;
+    RenderQueue m_staticQueue;
+    StaticLayerCache m_staticLayer;
     Paddle m_paddle;
     Ball m_ball;
     Level m_level;
-    double m_lastTime = 0.0;
+    EditorTool m_editorTool = EditorTool::PLACE;
+    int m_editorBrush = Level::BRUSH_BY_ROW;
+    bool m_playtesting = false;
+    bool m_editorDragging = false;
+    float m_editorDragX = 0.0f;
+    float m_editorDragY = 0.0f;
+    LevelPack m_levelPack;
+    int m_packLevel = -1;
+    TripleBuffer<FrameSnapshot> m_snapshots;
+    std::shared_ptr<const UiLayout> m_uiLayout;
+    std::shared_ptr<const BrickField> m_publishedBricks;
+    bool m_publishedBricksEditorView = false;
+    uint64_t m_snapshotSequence = 0;
+    std::atomic<bool> m_simRunning{false};
+    std::atomic<bool> m_quitRequested{false};
+    WakeSignal m_inputSignal;
+    LevelSaver m_levelSaver{m_inputSignal};
+    uint64_t m_savedLevelChecksum = 0;
+    LevelFileWatcher m_levelWatcher{m_inputSignal};
+    LevelFileWatcher::Reload m_pendingReload;
+    bool m_hasPendingReload = false;
+    HeatmapSampler m_heatmapSampler{m_inputSignal};
+    HeatmapMode m_heatmapMode = HeatmapMode::OFF;
+    bool m_heatmapActive = false;
+    uint64_t m_heatmapLevelVersion = 0;
+    uint64_t m_heatmapResultVersion = 0;
+    std::shared_ptr<const HitHeatmap> m_heatmap;
+    EntityWorld m_effects;
+    std::mt19937 m_effectsRng{std::random_device{}()};
+
+    /**
+     * @struct PublishedView
+     * @brief Éléments visibles d'un état publié dans les modes inactifs (Menu, Éditeur).
+     */
+    struct PublishedView {
+        GameState state = GameState::EXITING;
+        int windowWidth = 0;
+        int windowHeight = 0;
+        const BrickField* bricks = nullptr;
+        int selectedRow = -1;
+        int selectedCol = -1;
+        int anchorRow = -1;
+        int anchorCol = -1;
+        GridLayout grid;
+        std::string statusMessage;
+        int packLevel = -1;
+        const HitHeatmap* heatmap = nullptr;
+        HeatmapMode heatmapMode = HeatmapMode::OFF;
+    };
+    PublishedView m_lastPublishedView;
+    bool m_redrawRequested = true;
+    uint64_t m_renderedFrames = 0;
+    uint64_t m_skippedFrames = 0;
     std::string m_statusMessage = "";
     int m_lives = Config::PLAYER_STARTING_LIVES;
     int m_score = 0;
@@ -1639,18 +6572,45 @@ private:
     int m_logoWidth = 0;
     int m_logoHeight = 0;
 
-    int m_bricksHitInCurrentGame = 0; 
-    bool m_firstOrangeBrickHit = false;      
-    bool m_firstRedBrickHit = false;            
-    bool m_speedBoost4thBrickDone = false;
-    bool m_speedBoost12thBrickDone = false;
+    SpeedBoosts m_speedBoosts;
 
 public:
     Game() = default;
-    ~Game() { cleanup(); }
+    ~Game() { if (m_window) cleanup(); } // Les outils en ligne de commande quittent sans appeler init()
     Game(const Game&) = delete;
     Game& operator=(const Game&) = delete;
 
+    /** @brief Utilise le backend de rendu nul (à appeler avant `init()`). */
+    void useNullRenderBackend() { m_useNullRenderBackend = true; }
+
+    /**
+     * @brief Choisit la stratégie de cadencement des trames (à appeler avant `init`).
+     * @param mode Stratégie (`--pacing=`).
+     * @param targetHz Fréquence cible en Hz (`--target-hz=`), 0 pour utiliser la fréquence du moniteur.
+     */
+    void setFramePacing(PacingMode mode, double targetHz) { m_requestedTargetHz = targetHz; m_framePacer.configure(mode, targetHz); }
+
+    /** @brief Exporte la trace de profilage dans `Config::TRACE_FILENAME` à la fin de `run` (option `--trace`). */
+    void enableTraceAtExit() { m_traceAtExit = true; }
+
+    /**
+     * @brief Active la lecture tardive du curseur (option `--late-latch`) : la raquette est dessinée à la position
+     *        du curseur relue juste avant le rendu, et cette position est reprise par le pas de simulation suivant.
+     */
+    void enableLateLatch() { m_lateLatch = true; }
+
+    /**
+     * @brief Ouvre une archive de niveaux (option `--pack=`, à appeler avant `init`). Son premier niveau est choisi par défaut.
+     * @param filename Chemin de l'archive.
+     * @return `true` si l'archive a pu être ouverte.
+     */
+    bool openLevelPack(const std::string& filename) {
+        if (!m_levelPack.open(filename)) return false;
+        m_packLevel = m_levelPack.size() > 0 ? 0 : -1;
+        std::cout << "Level pack " << filename << ": " << m_levelPack.size() << " levels." << std::endl;
+        return true;
+    }
+
     /**
     * @brief Initialise le jeu.
     * @return `true` si l'initialisation est réussie, `false` sinon.
@@ -1686,18 +6646,30 @@ public:
              glfwSetWindowPos(m_window, xpos, ypos);
         }
         glfwMakeContextCurrent(m_window);
-        glfwSwapInterval(1); // V-Sync
+        double targetHz = m_requestedTargetHz;
+        if (targetHz <= 0.0) targetHz = (mode && mode->refreshRate > 0) ? mode->refreshRate : Config::TARGET_FPS;
+        m_framePacer.configure(m_framePacer.getMode(), targetHz);
+        glfwSwapInterval(m_framePacer.swapInterval()); // V-Sync uniquement en mode VSYNC : sinon les deux limiteurs se contrarient
+        std::cout << "Frame pacing: " << FramePacer::modeName(m_framePacer.getMode()) << " at " << m_framePacer.getTargetHz() << " Hz." << std::endl;
 
         glfwSetWindowUserPointer(m_window, this);
         glfwSetKeyCallback(m_window, Game::keyCallback_GLFW);
         glfwSetMouseButtonCallback(m_window, Game::mouseButtonCallback_GLFW);
         glfwSetCursorPosCallback(m_window, Game::cursorPosCallback_GLFW);
+        glfwSetScrollCallback(m_window, Game::scrollCallback_GLFW);
         glfwSetFramebufferSizeCallback(m_window, Game::framebufferSizeCallback_GLFW);
+        glfwSetWindowRefreshCallback(m_window, Game::windowRefreshCallback_GLFW);
         glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glDisable(GL_DEPTH_TEST);
         glClearColor(Config::COLOR_BG.r, Config::COLOR_BG.g, Config::COLOR_BG.b, 1.0f);
 
         if (!m_textRenderer.init(Config::FONT_PATH, Config::FONT_PIXEL_SIZE)) { cleanup(); return false; }
+        if (m_useNullRenderBackend) {
+            m_renderBackend = std::make_unique<NullRenderBackend>();
+            std::cout << "Using null render backend." << std::endl;
+        } else {
+            m_renderBackend = std::make_unique<GLRenderBackend>(m_textRenderer);
+        }
         m_logoTextureID = Utils::loadTexture(Config::LOGO_PATH, m_logoWidth, m_logoHeight);
         if (m_logoTextureID == 0) std::cerr << "Warning: Failed to load logo texture: " << Config::LOGO_PATH << ". Logo will not be displayed." << std::endl;
 
@@ -1707,69 +6679,477 @@ public:
         m_inputManager.setWindowHeight(m_windowHeight);
 
         m_currentState = GameState::MENU;
-        m_lastTime = glfwGetTime();
         std::cout << "Game initialized successfully." << std::endl;
         return true;
     }
 
     /**
     * @brief Exécute la boucle principale du jeu.
-    * @note Gère la temporisation des trames, les événements, la mise à jour et le rendu.
+    * @note Lance le thread de simulation puis exécute la boucle de rendu sur le thread principal :
+    *       traitement des événements GLFW (transmis à la simulation par la file de `m_inputManager`), rendu du dernier
+    *       état publié, échange des tampons et cadencement des trames (`FramePacer`). Une attente de la V-Sync dans
+    *       `glfwSwapBuffers` ne retarde donc plus la physique ni la lecture des entrées.
+    * @note Démarre aussi la surveillance des fichiers de niveau (`m_levelWatcher`) pour le rechargement à chaud.
     */
     void run() {
-        const double targetFrameTime = 1.0 / Config::TARGET_FPS;
-        while (m_currentState != GameState::EXITING && !glfwWindowShouldClose(m_window)) {
-            double frameStartTime = glfwGetTime();
-            double currentTime = glfwGetTime(); 
-            double deltaTime = currentTime - m_lastTime; 
-            m_lastTime = currentTime;
-            m_inputManager.nextFrame(); 
-            glfwPollEvents();
-            update(static_cast<float>(deltaTime));
-            render();
-            glfwSwapBuffers(m_window);
-            double frameEndTime = glfwGetTime(); 
-            double frameDuration = frameEndTime - frameStartTime;
-            if (frameDuration < targetFrameTime) {
-                std::chrono::duration<double> sleepDuration(targetFrameTime - frameDuration);
-                std::this_thread::sleep_for(sleepDuration);
-            }
-        }
-        if (m_currentState != GameState::EXITING) m_currentState = GameState::EXITING;
+        publishSnapshot();
+        m_levelWatcher.start({ Config::LEVEL_FILENAME, Config::LEVEL_TEXT_FILENAME });
+        m_simRunning.store(true, std::memory_order_release);
+        std::thread simulationThread(&Game::simulationLoop, this);
+
+        PROFILE_THREAD("Main (render)");
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point lastFrameStart = Clock::now();
+        m_framePacer.resetTiming();
+        while (!m_quitRequested.load(std::memory_order_acquire) && !glfwWindowShouldClose(m_window)) {
+            bool idle = isIdleState(m_snapshots.front().state);
+            if (idle) glfwWaitEventsTimeout(Config::IDLE_WAIT_TIMEOUT);
+            else { PROFILE_ZONE("glfwPollEvents"); glfwPollEvents(); }
+            m_inputSignal.notify();
+            if (m_traceExportRequested) { m_traceExportRequested = false; exportTrace(); }
+
+            bool freshSnapshot = m_snapshots.update();
+            if (idle && !freshSnapshot && !m_redrawRequested) {
+                ++m_skippedFrames; // Trame identique à celle affichée : ni rendu ni échange
+                continue;
+            }
+            m_redrawRequested = false;
+            if (idle) m_framePacer.resetTiming(); // L'attente des événements ne compte pas comme durée de trame
+            Clock::time_point frameStart = Clock::now();
+            uint64_t allocations = g_allocationCount.load(std::memory_order_relaxed);
+            m_allocationsPerFrame = allocations - m_lastAllocationCount;
+            m_lastAllocationCount = allocations;
+            render(m_snapshots.front());
+            float renderMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+            m_perfOverlay.addFrame(std::chrono::duration<float, std::milli>(frameStart - lastFrameStart).count(), renderMs);
+            lastFrameStart = frameStart;
+            { PROFILE_ZONE("glfwSwapBuffers"); glfwSwapBuffers(m_window); }
+            recordInputLatency(m_snapshots.front());
+            ++m_renderedFrames;
+            { PROFILE_ZONE("FramePacer::endFrame"); m_framePacer.endFrame(); }
+        }
+
+        m_simRunning.store(false, std::memory_order_release);
+        m_inputSignal.notify();
+        simulationThread.join();
+        m_levelWatcher.stop();
+        m_currentState = GameState::EXITING;
+        std::cout << "Frames rendered: " << m_renderedFrames << ", skipped while idle: " << m_skippedFrames << std::endl;
+        m_framePacer.report(std::cout);
+        m_inputLatency.report(std::cout);
+        if (m_traceAtExit) exportTrace();
     }
 private:
+    /** @brief Indique si un état du jeu est inactif (rien ne bouge sans action de l'utilisateur). */
+    static bool isIdleState(GameState state) { return state == GameState::MENU || state == GameState::EDITOR; }
+
+    /**
+     * @brief Boucle du thread de simulation, cadencée à `Config::SIMULATION_HZ`.
+     * @note À chaque pas : lecture des événements d'entrée, mise à jour avec un pas de temps fixe, publication d'un état.
+     * @note En mode inactif (Menu, Éditeur), un état n'est publié que si l'affichage change, et le thread attend
+     *       les événements suivants au lieu de se réveiller à chaque pas.
+     */
+    void simulationLoop() {
+        using Clock = std::chrono::steady_clock;
+        const double step = 1.0 / Config::SIMULATION_HZ;
+        const Clock::duration stepDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(step));
+        Clock::time_point nextStep = Clock::now();
+        PROFILE_THREAD("Simulation");
+        while (m_simRunning.load(std::memory_order_acquire)) {
+            {
+                PROFILE_ZONE("Game::simulationStep");
+                Clock::time_point stepStart = Clock::now();
+                processInputEvents();
+                update(static_cast<float>(step));
+                m_lastStepMs = std::chrono::duration<float, std::milli>(Clock::now() - stepStart).count();
+            }
+
+            if (!isIdleState(m_currentState)) {
+                publishSnapshot();
+                nextStep += stepDuration;
+                Clock::time_point now = Clock::now();
+                if (now - nextStep > std::chrono::milliseconds(250)) nextStep = now; // Trop de retard : on se resynchronise
+                std::this_thread::sleep_until(nextStep);
+                continue;
+            }
+
+            if (publishedViewChanged()) {
+                publishSnapshot();
+                glfwPostEmptyEvent(); // Réveille le thread principal bloqué dans glfwWaitEventsTimeout
+            }
+            m_inputSignal.waitFor(Config::IDLE_WAIT_TIMEOUT);
+            nextStep = Clock::now();
+        }
+    }
+
+    /**
+     * @brief Relit la position du curseur juste avant le rendu et retourne la raquette placée à cette position
+     *        (mode `--late-latch`, thread principal).
+     * @note La lecture est transmise à la simulation, qui l'applique au pas suivant (voir `applyLatchedCursor`).
+     */
+    Paddle latchPaddle(const FrameSnapshot& snap) {
+        double cursorX = 0.0, cursorY = 0.0;
+        glfwGetCursorPos(m_window, &cursorX, &cursorY);
+        CursorSample& sample = m_latchedCursor.back();
+        sample.x = static_cast<float>(cursorX);
+        sample.time = glfwGetTime();
+        m_latchedCursor.publish();
+        Paddle paddle = snap.paddle;
+        paddle.followCursor(sample.x, static_cast<float>(snap.windowWidth));
+        m_paddleLatchedThisFrame = true;
+        return paddle;
+    }
+
+    /**
+     * @brief Mesure la latence d'entrée d'un état qui vient d'être affiché (thread principal, après `glfwSwapBuffers`).
+     * @note Un état n'est mesuré qu'une fois, même s'il est réaffiché. Les états écrasés dans le triple tampon avant
+     *       d'avoir été affichés ne sont pas mesurés.
+     */
+    void recordInputLatency(const FrameSnapshot& snap) {
+        if (m_paddleLatchedThisFrame) {
+            // Raquette relue au rendu : le plus ancien déplacement reçu depuis l'affichage précédent est à l'écran
+            m_paddleLatchedThisFrame = false;
+            if (m_oldestUndisplayedCursorTime > 0.0) m_inputLatency.record(glfwGetTime() - m_oldestUndisplayedCursorTime);
+            m_oldestUndisplayedCursorTime = 0.0;
+            return;
+        }
+        m_oldestUndisplayedCursorTime = 0.0;
+        if (snap.inputEventTime <= 0.0 || snap.sequence == m_lastLatencySequence) return;
+        m_lastLatencySequence = snap.sequence;
+        m_inputLatency.record(glfwGetTime() - snap.inputEventTime);
+    }
+
+    /** @brief Exporte les zones de profilage dans `Config::TRACE_FILENAME` (thread principal). */
+    void exportTrace() {
+#if BREAKOUT_PROFILING
+        Profiler::instance().exportChromeTrace(Config::TRACE_FILENAME);
+#else
+        std::cerr << "Warning: Profiling is disabled in this build (BREAKOUT_PROFILING=0)." << std::endl;
+#endif
+    }
+
+    /** @brief Indique si la grille a été déplacée ou zoomée entre deux dispositions. */
+    static bool gridMoved(const GridLayout& a, const GridLayout& b) {
+        return a.startX != b.startX || a.startY != b.startY || a.cellWidth != b.cellWidth || a.cellHeight != b.cellHeight;
+    }
+
+    /** @brief Indique si le contenu visible a changé depuis le dernier état publié (thread de simulation). */
+    bool publishedViewChanged() const {
+        const PublishedView& last = m_lastPublishedView;
+        bool editorView = (m_currentState == GameState::EDITOR);
+        bool bricksChanged = !m_publishedBricks || m_publishedBricks->version != m_level.getVersion() || m_publishedBricksEditorView != editorView;
+        int selectedRow = m_level.hasEditorSelection() ? m_level.getSelectedRow() : -1;
+        int selectedCol = m_level.hasEditorSelection() ? m_level.getSelectedCol() : -1;
+        int anchorRow = m_level.hasEditorSelection() ? m_level.getAnchorRow() : -1;
+        int anchorCol = m_level.hasEditorSelection() ? m_level.getAnchorCol() : -1;
+        return bricksChanged || last.state != m_currentState || last.windowWidth != m_windowWidth || last.windowHeight != m_windowHeight ||
+               last.bricks != m_publishedBricks.get() || last.selectedRow != selectedRow || last.selectedCol != selectedCol ||
+               last.anchorRow != anchorRow || last.anchorCol != anchorCol || gridMoved(last.grid, m_level.getLayout()) ||
+               last.statusMessage != m_statusMessage || last.packLevel != m_packLevel ||
+               last.heatmap != m_heatmap.get() || last.heatmapMode != m_heatmapMode;
+    }
+
+    /**
+     * @brief Applique les événements reçus des callbacks GLFW depuis le dernier pas (thread de simulation).
+     * @note `InputManager::nextFrame()` met à jour l'état des touches et de la souris ; seuls les changements
+     *       de taille du framebuffer sont ensuite traités ici, dans leur ordre de réception.
+     */
+    void processInputEvents() {
+        PROFILE_ZONE("Game::processInputEvents");
+        m_prevStepTime = m_stepTime;
+        m_stepTime = glfwGetTime();
+        m_inputManager.nextFrame();
+        const InputManager::FrameEvents& events = m_inputManager.getFrameEvents();
+        m_stepCursorEventTime = 0.0;
+        for (size_t i = 0; i < m_inputManager.getFrameEventCount(); ++i) {
+            if (events[i].type == InputEventType::RESIZE) applyResize(events[i].code, events[i].action);
+            else if (events[i].type == InputEventType::CURSOR_POS && m_stepCursorEventTime == 0.0) m_stepCursorEventTime = events[i].time;
+        }
+    }
+
+    /**
+     * @brief Publie l'état courant de la simulation dans le triple tampon (thread de simulation).
+     * @note La grille de briques n'est recopiée que si la version du niveau ou la vue (jeu/éditeur) a changé.
+     *       Elle transporte alors la liste des cellules modifiées depuis la grille publiée précédemment.
+     */
+    void publishSnapshot() {
+        PROFILE_ZONE("Game::publishSnapshot");
+        bool editorView = (m_currentState == GameState::EDITOR);
+        if (!m_publishedBricks || m_publishedBricks->version != m_level.getVersion() || m_publishedBricksEditorView != editorView) {
+            auto field = std::make_shared<BrickField>();
+            m_level.copyBrickField(*field, editorView);
+            bool allChanged = true;
+            m_level.takeChanges(field->changedCells, allChanged);
+            field->fullChange = allChanged || !m_publishedBricks || m_publishedBricksEditorView != editorView;
+            field->baseVersion = m_publishedBricks ? m_publishedBricks->version : 0;
+            if (field->fullChange) field->changedCells.clear();
+            m_publishedBricks = std::move(field);
+            m_publishedBricksEditorView = editorView;
+        }
+
+        FrameSnapshot& snap = m_snapshots.back();
+        snap.sequence = ++m_snapshotSequence;
+        snap.state = m_currentState;
+        snap.windowWidth = m_windowWidth;
+        snap.windowHeight = m_windowHeight;
+        snap.paddle = m_paddle;
+        snap.ball = m_ball;
+        snap.grid = m_level.getLayout();
+        snap.bricks = m_publishedBricks;
+        snap.editorSelectedRow = m_level.hasEditorSelection() ? m_level.getSelectedRow() : -1;
+        snap.editorSelectedCol = m_level.hasEditorSelection() ? m_level.getSelectedCol() : -1;
+        snap.editorAnchorRow = m_level.hasEditorSelection() ? m_level.getAnchorRow() : -1;
+        snap.editorAnchorCol = m_level.hasEditorSelection() ? m_level.getAnchorCol() : -1;
+        snap.score = m_score;
+        snap.lives = m_lives;
+        snap.allBricksCleared = m_level.areAllBricksCleared();
+        snap.statusMessage = m_statusMessage;
+        snap.simStepMs = m_lastStepMs;
+        snap.collisionTests = m_level.takeCollisionTests();
+        snap.paddleFollowsCursor = paddleFollowsCursor();
+        snap.inputEventTime = m_pendingInputTime;
+        m_pendingInputTime = 0.0;
+        snap.packLevel = m_packLevel;
+        snap.ui = m_uiLayout;
+        snap.playtest = m_playtesting;
+        snap.heatmap = m_heatmap;
+        snap.heatmapMode = m_heatmapMode;
+        if (m_currentState == GameState::GAME) snap.effects = m_effects;
+        else snap.effects.clear();
+        m_snapshots.publish();
+
+        m_lastPublishedView.state = snap.state;
+        m_lastPublishedView.windowWidth = snap.windowWidth;
+        m_lastPublishedView.windowHeight = snap.windowHeight;
+        m_lastPublishedView.bricks = snap.bricks.get();
+        m_lastPublishedView.selectedRow = snap.editorSelectedRow;
+        m_lastPublishedView.selectedCol = snap.editorSelectedCol;
+        m_lastPublishedView.anchorRow = snap.editorAnchorRow;
+        m_lastPublishedView.anchorCol = snap.editorAnchorCol;
+        m_lastPublishedView.grid = snap.grid;
+        m_lastPublishedView.statusMessage = m_statusMessage;
+        m_lastPublishedView.packLevel = snap.packLevel;
+        m_lastPublishedView.heatmap = snap.heatmap.get();
+        m_lastPublishedView.heatmapMode = snap.heatmapMode;
+    }
+
+    /** @brief Indique si la raquette suit le curseur (partie en cours ou balle en jeu). */
+    bool paddleFollowsCursor() const {
+        return m_currentState == GameState::GAME && (m_ball.isMoving() || (m_lives > 0 && !m_level.areAllBricksCleared()));
+    }
+
+    /**
+     * @brief Déplace la raquette pour le pas en cours et construit sa trajectoire pendant le pas (thread de simulation).
+     * @note Les déplacements du curseur reçus depuis le pas précédent sont placés sur la trajectoire selon leur
+     *       horodatage, pour le test de collision balayé de `Ball::checkCollisionPaddle`. Leur résolution est celle
+     *       de la lecture des événements par le thread principal (`glfwPollEvents`).
+     */
+    void buildPaddlePath() {
+        const float windowWidth = static_cast<float>(m_windowWidth);
+        const double stepSpan = m_stepTime - m_prevStepTime;
+        m_paddle.beginPath();
+        const InputManager::FrameEvents& events = m_inputManager.getFrameEvents();
+        for (size_t i = 0; i < m_inputManager.getFrameEventCount(); ++i) {
+            if (events[i].type != InputEventType::CURSOR_POS) continue;
+            float fraction = stepSpan > 0.0 ? static_cast<float>((events[i].time - m_prevStepTime) / stepSpan) : 1.0f;
+            m_paddle.addPathSample(fraction, static_cast<float>(events[i].x), windowWidth);
+        }
+        if (!applyLatchedCursor()) m_paddle.update(m_inputManager, windowWidth);
+        m_paddle.endPath();
+    }
+
+    /**
+     * @brief Place la raquette à la position du curseur relue au rendu, si elle est plus récente que le dernier
+     *        déplacement reçu par la file d'entrées (mode `--late-latch`, thread de simulation).
+     * @return `true` si la position relue a été appliquée.
+     * @note Correction intra-pas : seule une lecture antérieure au début du pas est appliquée, pour que la physique
+     *       de ce pas (dont le test de collision avec la raquette) ne voie jamais une entrée postérieure à son instant.
+     */
+    bool applyLatchedCursor() {
+        if (!m_lateLatch) return false;
+        m_latchedCursor.update();
+        const CursorSample& sample = m_latchedCursor.front();
+        if (sample.time <= 0.0 || sample.time <= m_inputManager.getLastCursorTime() || sample.time > m_stepTime) return false;
+        m_paddle.followCursor(sample.x, static_cast<float>(m_windowWidth));
+        return true;
+    }
+
+    /**
+     * @brief Reprend le résultat d'une sauvegarde terminée par `m_levelSaver` (thread de simulation).
+     * @note Le message d'état n'est remplacé que si l'éditeur est toujours affiché.
+     */
+    void pollLevelSave() {
+        LevelSaver::Result result;
+        if (!m_levelSaver.takeResult(result)) return;
+        if (result.success) {
+            std::cout << "Level saved to " << result.filename << " in " << result.ms << " ms." << std::endl;
+            m_savedLevelChecksum = result.checksum;
+        }
+        else std::cerr << "Error: Could not save level file: " << result.filename << std::endl;
+        if (m_currentState == GameState::EDITOR) m_statusMessage = result.success ? "Level saved successfully!" : "ERROR: Could not save level!";
+    }
+
+    /**
+     * @brief Applique un niveau rechargé à chaud par `m_levelWatcher` (thread de simulation).
+     * @note Le fichier a déjà été lu et analysé par le thread de surveillance : il ne reste qu'à échanger la grille.
+     * @note Ignoré si un niveau d'archive est choisi, dans le menu (le niveau est relu en entrant en jeu ou dans l'éditeur)
+     *       et pour les écritures du jeu lui-même. En partie, il attend que la balle soit arrêtée (avant un lancement),
+     *       et pendant un test depuis l'éditeur, le retour dans l'éditeur.
+     * @note Une modification de `Config::LEVEL_TEXT_FILENAME` est aussi sauvegardée dans `Config::LEVEL_FILENAME`,
+     *       le fichier relu au lancement d'une partie.
+     */
+    void pollLevelReload() {
+        LevelFileWatcher::Reload reload;
+        if (m_levelWatcher.takeReload(reload)) {
+            bool ownWrite = reload.filename == Config::LEVEL_FILENAME && (m_levelSaver.isBusy() || reload.checksum == m_savedLevelChecksum);
+            if (!ownWrite && m_packLevel < 0) {
+                std::cout << "Level file " << reload.filename << " changed (" << reload.rows << "x" << reload.cols << ")." << std::endl;
+                if (reload.filename == Config::LEVEL_TEXT_FILENAME) {
+                    m_levelSaver.request(Config::LEVEL_FILENAME, reload.rows, reload.cols, reload.cells);
+                    m_savedLevelChecksum = reload.checksum;
+                }
+                m_pendingReload = std::move(reload);
+                m_hasPendingReload = true;
+            }
+        }
+        if (!m_hasPendingReload) return;
+        if (m_packLevel >= 0 || m_currentState == GameState::MENU || m_currentState == GameState::EXITING) { m_hasPendingReload = false; return; }
+        if (m_currentState == GameState::GAME && (m_ball.isMoving() || m_playtesting)) return; // En test : appliqué au retour dans l'éditeur
+
+        PROFILE_ZONE("Game::applyLevelReload");
+        m_hasPendingReload = false;
+        const std::vector<int8_t>& current = m_level.getCells();
+        if (m_pendingReload.rows == m_level.getRows() && m_pendingReload.cols == m_level.getCols() &&
+            std::equal(current.begin(), current.end(), m_pendingReload.cells.begin())) return; // Contenu déjà affiché
+        m_level.replaceCells(m_pendingReload.rows, m_pendingReload.cols, std::move(m_pendingReload.cells));
+        std::string problems = m_pendingReload.problemCount ? " (" + std::to_string(m_pendingReload.problemCount) + " problems)" : "";
+        if (m_currentState == GameState::GAME) {
+            m_level.setupBricks(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+            if (m_lives > 0) m_statusMessage = "Level reloaded" + problems + ". Click to launch ball";
+        } else {
+            m_level.calculateEditorGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+            m_statusMessage = "Reloaded " + m_pendingReload.filename + problems;
+        }
+    }
+
    /**
      * @brief Met à jour la logique du jeu en fonction de l'état actuel.
      * @param dt Delta-temps.
      */
     void update(float dt) {
-        if (m_inputManager.wasKeyPressed(Config::KEY_QUIT)) { glfwSetWindowShouldClose(m_window, GLFW_TRUE); return; }
+        if (m_inputManager.wasKeyPressed(Config::KEY_QUIT)) { m_quitRequested.store(true, std::memory_order_release); return; }
+        if (!m_uiLayout || m_uiLayout->width != m_windowWidth || m_uiLayout->height != m_windowHeight) {
+            m_uiLayout = std::make_shared<const UiLayout>(UiLayout::build(m_textRenderer, m_windowWidth, m_windowHeight));
+        }
+        pollLevelSave();
+        pollLevelReload();
         switch (m_currentState) {
             case GameState::MENU:   updateMenu(dt);   break;
             case GameState::GAME:   updateGame(dt);   break;
             case GameState::EDITOR: updateEditor(dt); break;
             case GameState::EXITING: break;
         }
+        updateHeatmap();
     }
 
     /**
-     * @brief Effectue le rendu du jeu en fonction de l'état actuel.
-     * @note Configure la projection orthographique pour le rendu 2D.
+     * @brief Confie la grille de l'éditeur à `m_heatmapSampler` tant que la carte de chaleur est affichée, et reprend ses
+     *        résultats partiels (thread de simulation).
+     * @note Chaque modification de la grille relance les parties simulées. Hors de l'éditeur, la simulation est suspendue :
+     *       au retour sur une grille identique (après un test de niveau), les résultats déjà accumulés sont conservés.
      */
-    void render() {
-        glClear(GL_COLOR_BUFFER_BIT);
-        glMatrixMode(GL_PROJECTION); 
-        glLoadIdentity();
-        glOrtho(0.0, static_cast<double>(m_windowWidth), 0.0, static_cast<double>(m_windowHeight), -1.0, 1.0);
-        glMatrixMode(GL_MODELVIEW); 
-        glLoadIdentity();
+    void updateHeatmap() {
+        bool tooLarge = m_level.getCells().size() > Config::HEATMAP_MAX_CELLS; // Grille agrandie par un rechargement
+        if (m_heatmapMode == HeatmapMode::OFF || m_currentState != GameState::EDITOR || tooLarge) {
+            if (m_heatmapActive) { m_heatmapSampler.pause(); m_heatmapActive = false; }
+            if (m_heatmapMode == HeatmapMode::OFF || tooLarge) m_heatmap.reset();
+            return;
+        }
+        if (!m_heatmapActive || m_heatmapLevelVersion != m_level.getVersion()) {
+            m_heatmapSampler.start(m_level.getRows(), m_level.getCols(), m_level.getCells(), m_level.getVersion());
+            m_heatmapLevelVersion = m_level.getVersion();
+            m_heatmapActive = true;
+        }
+        m_heatmapSampler.takeResult(m_heatmapResultVersion, m_heatmap);
+    }
 
-        switch (m_currentState) {
-            case GameState::MENU:   renderMenu();   break;
-            case GameState::GAME:   renderGame();   break;
-            case GameState::EDITOR: renderEditor(); break;
+    /**
+     * @brief Effectue le rendu d'un état publié par la simulation.
+     * @param snap État à afficher.
+     * @note Dessine la couche statique (bordures et briques), puis enregistre les commandes dynamiques de la trame
+     *       (et l'overlay de performances s'il est affiché) dans `m_renderQueue`, les trie et les soumet au backend.
+     */
+    void render(const FrameSnapshot& snap) {
+        PROFILE_ZONE("Game::render");
+        m_renderQueue.clear();
+        m_renderBackend->beginFrame(snap.windowWidth, snap.windowHeight);
+        if (snap.state == GameState::GAME || snap.state == GameState::EDITOR) renderStaticLayer(snap);
+        switch (snap.state) {
+            case GameState::MENU:   renderMenu(snap);   break;
+            case GameState::GAME:   renderGame(snap);   break;
+            case GameState::EDITOR: renderEditor(snap); break;
             case GameState::EXITING: break;
         }
+        if (m_showPerfOverlay) {
+            PerfOverlay::Counters counters = { snap.simStepMs, m_inputLatency.percentileMs(0.50), m_inputLatency.percentileMs(0.99), m_lastSceneDrawCalls, snap.collisionTests, m_allocationsPerFrame,
+                                               g_allocationCount.load(std::memory_order_relaxed) };
+            m_perfOverlay.record(m_renderQueue, m_textRenderer, counters, m_framePacer.getTargetHz(), snap.windowHeight);
+        }
+        m_renderQueue.sort();
+        m_renderBackend->submit(m_renderQueue);
+        m_lastSceneDrawCalls = std::max(0, m_renderBackend->getLastDrawCalls() - (m_showPerfOverlay ? 1 : 0));
+    }
+
+    /**
+     * @brief Affiche la couche statique, en la mettant à jour dans le backend si nécessaire.
+     * @param snap État publié par la simulation.
+     * @note Si le backend ne conserve pas de couche statique, son contenu est enregistré directement dans `m_renderQueue`.
+     */
+    void renderStaticLayer(const FrameSnapshot& snap) {
+        PROFILE_ZONE("Game::renderStaticLayer");
+        if (!m_renderBackend->supportsStaticLayer() || !snap.bricks) {
+            recordStaticLayer(snap, m_renderQueue);
+            return;
+        }
+        StaticLayerCache::Update update = m_staticLayer.compare(snap);
+        if (update != StaticLayerCache::Update::NONE) {
+            m_staticQueue.clear();
+            if (update == StaticLayerCache::Update::FULL) {
+                recordStaticLayer(snap, m_staticQueue);
+            } else {
+                if (snap.state == GameState::EDITOR) Level::renderEditorCells(m_staticQueue, *snap.bricks, snap.grid, snap.bricks->changedCells);
+                else for (int cell : snap.bricks->changedCells) Level::renderCell(m_staticQueue, *snap.bricks, snap.grid, cell, false);
+            }
+            m_staticQueue.sort();
+            m_renderBackend->updateStaticLayer(m_staticQueue, snap.windowWidth, snap.windowHeight, update == StaticLayerCache::Update::FULL);
+            if (!m_renderBackend->supportsStaticLayer()) { // Échec de création du FBO : rendu direct
+                m_staticLayer.invalidate();
+                recordStaticLayer(snap, m_renderQueue);
+                return;
+            }
+            m_staticLayer.accept(snap);
+        }
+        m_renderBackend->drawStaticLayer(snap.windowWidth, snap.windowHeight);
+    }
+
+    /**
+     * @brief Enregistre le contenu complet de la couche statique : bordures latérales et briques (ou grille de l'éditeur).
+     * @param snap État publié par la simulation.
+     * @param queue Tampon de destination.
+     * @note Les bordures ne sont dessinées que si la grille de briques n'occupe pas toute la largeur de la fenêtre.
+     */
+    void recordStaticLayer(const FrameSnapshot& snap, RenderQueue& queue) {
+        float gridEndX = snap.grid.startX + snap.grid.totalWidth;
+        if (snap.grid.startX > 0.1f) {
+            queue.rect(0.0f, 0.0f, snap.grid.startX, static_cast<float>(snap.windowHeight), Config::COLOR_BORDER, RenderLayer::BACKGROUND);
+        }
+        if (gridEndX < snap.windowWidth - 0.1f) {
+             float rightBorderWidth = static_cast<float>(snap.windowWidth) - gridEndX;
+             queue.rect(gridEndX, 0.0f, rightBorderWidth, static_cast<float>(snap.windowHeight), Config::COLOR_BORDER, RenderLayer::BACKGROUND);
+        }
+        if (!snap.bricks) return;
+        if (snap.state == GameState::EDITOR) Level::renderEditorGrid(queue, *snap.bricks, snap.grid);
+        else Level::renderBricks(queue, *snap.bricks, snap.grid);
     }
 
     /**
@@ -1778,6 +7158,7 @@ private:
     void cleanup() {
         std::cout << "Cleaning up Game..." << std::endl;
         if (m_logoTextureID != 0) { glDeleteTextures(1, &m_logoTextureID); m_logoTextureID = 0; std::cout << "Logo texture deleted." << std::endl; }
+        m_renderBackend.reset();
         m_textRenderer.cleanup();
         if (m_window) { glfwDestroyWindow(m_window); m_window = nullptr; }
         glfwTerminate();
@@ -1789,19 +7170,37 @@ private:
      * @note Réinitialise les vies, le score, charge le niveau, et positionne la raquette et la balle.
      */
     void initGameObjects() {
+        if (!loadCurrentLevel()) {
+            std::cerr << "Warning: Level file issues during game init. Check '" << currentLevelName() << "'." << std::endl;
+        }
+        m_playtesting = false;
+        startGame();
+    }
+
+    /**
+     * @brief Lance un test de la grille de l'éditeur, sans passer par le disque.
+     * @note La partie utilise directement la grille en mémoire de `m_level` : les briques sont créées à partir de
+     *       `m_gridState`, qui n'est pas modifié en jeu. La sélection, le zoom et l'historique d'annulation de l'éditeur
+     *       sont donc intacts au retour (touche M).
+     */
+    void startPlaytest() {
+        std::cout << "Editor: playtesting the level in memory (" << m_level.getRows() << "x" << m_level.getCols() << ")." << std::endl;
+        m_playtesting = true;
+        m_currentState = GameState::GAME;
+        startGame();
+        m_statusMessage = "Playtest: click to launch ball (M: back to editor)";
+    }
+
+    /** @brief Réinitialise les vies, le score, la raquette, les briques (depuis la grille courante) et la balle. */
+    void startGame() {
         m_lives = Config::PLAYER_STARTING_LIVES;
         m_score = 0;
-        m_firstOrangeBrickHit = false;
-        m_firstRedBrickHit = false;
-        m_bricksHitInCurrentGame = 0;
-        m_speedBoost4thBrickDone = false;
-        m_speedBoost12thBrickDone = false;
+        m_speedBoosts = SpeedBoosts();
+        m_effects.clear();
 
         m_paddle.init(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
-        if (!m_level.load(Config::LEVEL_FILENAME)) {
-            std::cerr << "Warning: Level file issues during game init. Check '" << Config::LEVEL_FILENAME << "'." << std::endl;
-        }
         m_level.setupBricks(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+        std::cout << "Level setup complete. Active destructible bricks: " << m_level.getActiveBrickCount() << std::endl;
         resetBallAndPaddle();
         m_statusMessage = "Click to launch ball";
     }
@@ -1854,81 +7253,147 @@ private:
         m_statusMessage = (m_lives > 0) ? "Click to launch ball" : "";
     }
 
+    /**
+     * @brief Charge le niveau choisi dans le menu : niveau de l'archive, ou `Config::LEVEL_FILENAME`.
+     * @note Une sauvegarde de l'éditeur encore en cours est d'abord terminée, pour relire le niveau sauvegardé.
+     */
+    bool loadCurrentLevel() {
+        if (m_packLevel >= 0) return m_levelPack.load(m_packLevel, m_level);
+        m_levelSaver.waitUntilIdle();
+        return m_level.load(Config::LEVEL_FILENAME);
+    }
+
+    /** @brief Obtient le nom du niveau choisi dans le menu. */
+    std::string currentLevelName() const {
+        if (m_packLevel >= 0) return m_levelPack.getFilename() + ":" + m_levelPack.entry(m_packLevel).getName();
+        return Config::LEVEL_FILENAME;
+    }
+
     /**
      * @brief Initialise l'état de l'éditeur de niveaux.
      * @note Charge le niveau actuel et calcule les dimensions de la grille.
      */
     void initEditorState() {
-        if (!m_level.load(Config::LEVEL_FILENAME)) {
-             std::cerr << "Warning: Level file issues during editor init. Check '" << Config::LEVEL_FILENAME << "'." << std::endl;
+        if (!loadCurrentLevel()) {
+             std::cerr << "Warning: Level file issues during editor init. Check '" << currentLevelName() << "'." << std::endl;
+        }
+        m_level.calculateEditorGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+        m_statusMessage = "L-Click: Select | R-Click: Apply (Shift+R-C: Indestructible) \n" + editorToolDescription() +
+                          " | Del: Clear | Ctrl+Z/Y: Undo/Redo";
+    }
+
+    /** @brief Termine un test de niveau et revient à l'éditeur, sans recharger la grille. */
+    void returnToEditor() {
+        m_playtesting = false;
+        m_ball.stop();
+        m_currentState = GameState::EDITOR;
+        m_level.calculateEditorGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+        m_statusMessage = "Playtest ended (score " + std::to_string(m_score) + ")\n" + editorToolDescription() + " | P: Playtest again";
+    }
+
+    /**
+     * @brief Zoome et déplace la vue de l'éditeur : molette (sous le curseur), bouton du milieu maintenu, flèches, Origine.
+     * @param mx Position X du curseur.
+     * @param my Position Y du curseur.
+     */
+    void updateEditorView(float mx, float my) {
+        float scroll = m_inputManager.getScrollY();
+        if (scroll != 0.0f) m_level.zoomEditorView(std::pow(Config::EDITOR_ZOOM_STEP, scroll), mx, my);
+        if (m_inputManager.isMouseMiddleDown()) {
+            if (m_editorDragging) m_level.panEditorView(mx - m_editorDragX, my - m_editorDragY);
+            m_editorDragging = true;
+            m_editorDragX = mx;
+            m_editorDragY = my;
+        } else {
+            m_editorDragging = false;
+        }
+        // Les flèches déplacent la vue d'un quart de la fenêtre (la grille part dans le sens opposé)
+        float stepX = m_windowWidth * 0.25f, stepY = m_windowHeight * 0.25f;
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_PAN_LEFT)) m_level.panEditorView(stepX, 0.0f);
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_PAN_RIGHT)) m_level.panEditorView(-stepX, 0.0f);
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_PAN_UP)) m_level.panEditorView(0.0f, -stepY);
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_PAN_DOWN)) m_level.panEditorView(0.0f, stepY);
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_VIEW_RESET)) m_level.resetEditorView();
+    }
+
+    /**
+     * @brief Change l'outil ou le pinceau de l'éditeur selon les touches pressées (1 à 4, Tab).
+     * @return `true` si l'outil ou le pinceau a changé.
+     */
+    bool selectEditorTool() {
+        static constexpr std::array<std::pair<int, EditorTool>, 4> toolKeys = {{
+            { Config::KEY_EDITOR_TOOL_PLACE, EditorTool::PLACE }, { Config::KEY_EDITOR_TOOL_RECTANGLE, EditorTool::RECTANGLE },
+            { Config::KEY_EDITOR_TOOL_LINE, EditorTool::LINE }, { Config::KEY_EDITOR_TOOL_FILL, EditorTool::FILL } }};
+        for (const auto& [key, tool] : toolKeys) {
+            if (m_inputManager.wasKeyPressed(key)) { m_editorTool = tool; return true; }
+        }
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_BRUSH_NEXT)) {
+            static constexpr std::array<int, 7> brushes = { Level::BRUSH_BY_ROW, Config::SCORE_YELLOW, Config::SCORE_GREEN,
+                Config::SCORE_ORANGE, Config::SCORE_RED, Config::SCORE_INDESTRUCTIBLE, 0 };
+            auto current = std::find(brushes.begin(), brushes.end(), m_editorBrush);
+            m_editorBrush = (current == brushes.end() || current + 1 == brushes.end()) ? brushes.front() : *(current + 1);
+            return true;
         }
-        m_level.calculateGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
-        m_statusMessage = "L-Click: Select | R-Click: Place (Shift+R-C: Indestructible) | Del: Clear";
+        return false;
+    }
+
+    /** @brief Décrit l'outil et le pinceau de l'éditeur pour le message d'état. */
+    std::string editorToolDescription() const {
+        static constexpr std::array<const char*, 4> toolNames = { "Place", "Rectangle", "Line", "Fill" };
+        std::string brush;
+        if (m_editorBrush == Level::BRUSH_BY_ROW) brush = "Row colors";
+        else if (m_editorBrush == Config::SCORE_INDESTRUCTIBLE) brush = "Indestructible";
+        else if (m_editorBrush > 0) brush = std::to_string(m_editorBrush) + "pts";
+        else brush = "Empty";
+        return std::string("Tool (1-4): ") + toolNames[static_cast<size_t>(m_editorTool)] + " | Brush (Tab): " + brush;
     }
 
     /**
      * @brief Met à jour la logique du menu principal.
      * @param dt Delta-temps.
-     * @note Gère les clics sur les boutons du menu pour changer d'état ou quitter.
+     * @note Gère les clics sur les boutons du menu (`m_uiLayout`) pour changer d'état ou quitter.
      */
     void updateMenu(float dt) {
-        float buttonW = m_windowWidth * 0.3f; float buttonH = m_windowHeight * 0.08f;
-        float spacingY = m_windowHeight * 0.04f; float centerX = m_windowWidth / 2.0f;
-        float topButtonY = m_windowHeight * 0.6f;
-        Rect playButtonRect = { centerX - buttonW / 2.0f, topButtonY, buttonW, buttonH };
-        Rect editorButtonRect = { centerX - buttonW / 2.0f, topButtonY - buttonH - spacingY, buttonW, buttonH };
-        Rect quitButtonRect = { centerX - buttonW / 2.0f, editorButtonRect.y - buttonH - spacingY, buttonW, buttonH };
+        PROFILE_ZONE("Game::updateMenu");
+        if (m_levelPack.size() > 0) {
+            // Niveaux -1 (fichier de niveau) à size() - 1 (archive), en boucle
+            int choices = m_levelPack.size() + 1;
+            if (m_inputManager.wasKeyPressed(Config::KEY_LEVEL_NEXT)) m_packLevel = (m_packLevel + 2) % choices - 1;
+            if (m_inputManager.wasKeyPressed(Config::KEY_LEVEL_PREV)) m_packLevel = (m_packLevel + choices) % choices - 1;
+        }
 
         if (m_inputManager.wasMouseLeftClicked()) {
             float mx = m_inputManager.getMouseX(); float my = m_inputManager.getMouseY();
-            if (mx >= playButtonRect.x && mx <= playButtonRect.x + playButtonRect.width && my >= playButtonRect.y && my <= playButtonRect.y + playButtonRect.height) {
+            if (m_uiLayout->button(UiButton::PLAY).contains(mx, my)) {
                 std::cout << "Menu: Play button clicked. Switching to GAME state." << std::endl;
                 initGameObjects(); m_currentState = GameState::GAME;
-            } else if (mx >= editorButtonRect.x && mx <= editorButtonRect.x + editorButtonRect.width && my >= editorButtonRect.y && my <= editorButtonRect.y + editorButtonRect.height) {
+            } else if (m_uiLayout->button(UiButton::EDITOR).contains(mx, my)) {
                 std::cout << "Menu: Editor button clicked. Switching to EDITOR state." << std::endl;
                 initEditorState(); m_currentState = GameState::EDITOR;
-            } else if (mx >= quitButtonRect.x && mx <= quitButtonRect.x + quitButtonRect.width && my >= quitButtonRect.y && my <= quitButtonRect.y + quitButtonRect.height) {
+            } else if (m_uiLayout->button(UiButton::QUIT).contains(mx, my)) {
                 std::cout << "Menu: Quit button clicked. Closing window." << std::endl;
-                glfwSetWindowShouldClose(m_window, GLFW_TRUE);
+                m_quitRequested.store(true, std::memory_order_release);
             }
         }
     }
 
     /**
      * @brief Effectue le rendu du menu principal.
-     * @note Affiche le titre, les boutons et le logo/copyright.
+     * @param snap État publié par la simulation.
+     * @note Affiche le titre, les boutons (géométrie publiée dans `snap.ui`) et le logo/copyright.
      */
-    void renderMenu() {
+    void renderMenu(const FrameSnapshot& snap) {
+        PROFILE_ZONE("Game::renderMenu");
         const std::string title = "GLFW BREAKOUT";
-        float titleScale = 1.5f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
-        float titleCenterX = m_windowWidth / 2.0f;
-        float titleY = m_windowHeight * 0.85f;
-        m_textRenderer.render(title, titleCenterX, titleY, titleScale, Config::COLOR_TEXT_ACCENT);
-
-        float buttonW = m_windowWidth * 0.3f; float buttonH = m_windowHeight * 0.08f;
-        float spacingY = m_windowHeight * 0.04f; float centerX = m_windowWidth / 2.0f;
-        float topButtonY = m_windowHeight * 0.6f;
-        float textScale = 0.9f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
-        float textHeight = m_textRenderer.getTextHeight(textScale);
-        float textYOffset = (buttonH - textHeight) / 2.0f;
-
-        Rect playButtonRect = { centerX - buttonW / 2.0f, topButtonY, buttonW, buttonH };
-        Utils::drawRect(playButtonRect, Config::COLOR_BUTTON_PLAY);
-        const std::string playText = "Play Game";
-        float playTextCenterX = playButtonRect.x + playButtonRect.width / 2.0f;
-        m_textRenderer.render(playText, playTextCenterX, playButtonRect.y - textYOffset, textScale, Config::COLOR_TEXT_DEFAULT);
-
-        Rect editorButtonRect = { centerX - buttonW / 2.0f, topButtonY - buttonH - spacingY, buttonW, buttonH };
-        Utils::drawRect(editorButtonRect, Config::COLOR_BUTTON_EDITOR);
-        const std::string editorText = "Level Editor";
-        float editorTextCenterX = editorButtonRect.x + editorButtonRect.width / 2.0f;
-        m_textRenderer.render(editorText, editorTextCenterX, editorButtonRect.y - textYOffset, textScale, {0.1f, 0.1f, 0.1f});
-
-        Rect quitButtonRect = { centerX - buttonW / 2.0f, editorButtonRect.y - buttonH - spacingY, buttonW, buttonH };
-        Utils::drawRect(quitButtonRect, Config::COLOR_BUTTON_QUIT);
-        const std::string quitText = "Quit";
-        float quitTextCenterX = quitButtonRect.x + quitButtonRect.width / 2.0f;
-        m_textRenderer.render(quitText, quitTextCenterX, quitButtonRect.y - textYOffset, textScale, Config::COLOR_TEXT_DEFAULT);
+        float titleScale = 1.5f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        float titleCenterX = snap.windowWidth / 2.0f;
+        float titleY = snap.windowHeight * 0.85f;
+        m_renderQueue.text(title, titleCenterX, titleY, titleScale, Config::COLOR_TEXT_ACCENT);
+
+        if (snap.ui) {
+            snap.ui->renderButtons(m_renderQueue, UiLayout::MENU_BUTTONS);
+            if (m_levelPack.size() > 0) renderLevelBrowser(snap, snap.ui->levelBrowser);
+        }
 
         if (m_logoTextureID != 0 && m_logoHeight > 0) {
             float logoDrawHeight = Config::LOGO_TARGET_HEIGHT;
@@ -1937,9 +7402,7 @@ private:
             float logoX = 15.0f;
             float logoY = 15.0f;
 
-            glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            Utils::drawTexturedRect(logoX, logoY, logoDrawWidth, logoDrawHeight, m_logoTextureID);
-            glDisable(GL_BLEND);
+            m_renderQueue.texturedQuad(logoX, logoY, logoDrawWidth, logoDrawHeight, m_logoTextureID);
 
             std::string nameText = Config::COPYRIGHT_NAME;
             float nameTextTargetHeight = logoDrawHeight * 0.6f;
@@ -1948,7 +7411,7 @@ private:
             float nameX_start = logoX + logoDrawWidth + Config::LOGO_NAME_SPACING;
             float nameTextWidth = m_textRenderer.getTextWidth(nameText, nameTextScale);
             float nameTextCenterX_for_left_align = nameX_start + nameTextWidth / 2.0f;
-            m_textRenderer.render(nameText, nameTextCenterX_for_left_align, nameY, nameTextScale, Config::COLOR_TEXT_DEFAULT);
+            m_renderQueue.text(nameText, nameTextCenterX_for_left_align, nameY, nameTextScale, Config::COLOR_TEXT_DEFAULT);
         } else if (m_logoTextureID == 0) {
             std::string nameText = Config::COPYRIGHT_NAME;
             float nameTextScale = 0.5f; 
@@ -1956,7 +7419,34 @@ private:
             float nameY = 15.0f;
             float nameTextWidth = m_textRenderer.getTextWidth(nameText, nameTextScale);
             float nameTextCenterX_for_left_align = nameX_start + nameTextWidth / 2.0f;
-            m_textRenderer.render(nameText, nameTextCenterX_for_left_align, nameY, nameTextScale, Config::COLOR_TEXT_DEFAULT);
+            m_renderQueue.text(nameText, nameTextCenterX_for_left_align, nameY, nameTextScale, Config::COLOR_TEXT_DEFAULT);
+        }
+    }
+
+    /**
+     * @brief Enregistre le navigateur de niveaux du menu : nom du niveau choisi et vignette lue dans l'index de l'archive.
+     * @param snap État publié par la simulation.
+     * @param area Zone du nom ; la vignette est dessinée à sa droite.
+     * @note Seul l'index est lu : les grilles ne sont chargées qu'en lançant le jeu ou l'éditeur.
+     */
+    void renderLevelBrowser(const FrameSnapshot& snap, const Rect& area) {
+        float textScale = 0.6f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        float textYOffset = (area.height - m_textRenderer.getTextHeight(textScale)) / 2.0f;
+        std::string label = "< " + std::string(snap.packLevel >= 0 ? m_levelPack.entry(snap.packLevel).getName() : Config::LEVEL_FILENAME) +
+                            "  (" + std::to_string(snap.packLevel + 2) + "/" + std::to_string(m_levelPack.size() + 1) + ") >";
+        m_renderQueue.text(label, area.x + area.width / 2.0f, area.y - textYOffset, textScale, Config::COLOR_TEXT_DEFAULT);
+        if (snap.packLevel < 0) return;
+
+        const LevelPack::Entry& entry = m_levelPack.entry(snap.packLevel);
+        float cellHeight = area.height / LevelPack::THUMBNAIL_ROWS;
+        float cellWidth = cellHeight * 2.0f;
+        float thumbnailX = area.x + area.width + cellWidth;
+        for (int r = 0; r < LevelPack::THUMBNAIL_ROWS; ++r) {
+            for (int c = 0; c < LevelPack::THUMBNAIL_COLS; ++c) {
+                int score = entry.thumbnail[r * LevelPack::THUMBNAIL_COLS + c];
+                Rect cell = { thumbnailX + c * cellWidth, area.y + (LevelPack::THUMBNAIL_ROWS - 1 - r) * cellHeight, cellWidth, cellHeight };
+                m_renderQueue.rect(cell, Config::getBrickColorByScore(score), RenderLayer::UI);
+            }
         }
     }
 
@@ -1966,7 +7456,9 @@ private:
      * @note Gère le lancement de la balle, les mouvements de la raquette, les collisions, la perte de vies et les conditions de victoire/défaite.
      */
     void updateGame(float dt) {
+        PROFILE_ZONE("Game::updateGame");
         if (m_inputManager.wasKeyPressed(Config::KEY_MENU_TOGGLE)) {
+            if (m_playtesting) { returnToEditor(); return; }
             m_statusMessage = ""; m_currentState = GameState::MENU; return;
         }
 
@@ -1982,38 +7474,26 @@ private:
              m_statusMessage = "";
         }
 
-        if (m_ball.isMoving() || (m_lives > 0 && !m_level.areAllBricksCleared())) {
-            m_paddle.update(dt, m_inputManager, static_cast<float>(m_windowWidth));
+        if (paddleFollowsCursor()) {
+            buildPaddlePath();
+            if (m_stepCursorEventTime > 0.0 && m_pendingInputTime == 0.0) m_pendingInputTime = m_stepCursorEventTime;
         }
 
+        EntitySystems::move(m_effects, dt);
+        EntitySystems::expire(m_effects, dt);
+
         if(m_ball.isMoving()){
             m_level.checkCollisions(m_ball);            
-            m_ball.checkCollisionPaddle(m_paddle, dt);  
-            int hitBrickIndex = m_ball.update(dt, static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight), m_level.m_gridStartX, m_level.m_gridStartX + m_level.m_gridTotalWidth);
+            m_ball.checkCollisionPaddle(m_paddle, dt, static_cast<float>(m_windowWidth));
+            int hitBrickIndex = m_ball.update(dt, static_cast<float>(m_windowHeight), m_level.m_gridStartX, m_level.m_gridStartX + m_level.m_gridTotalWidth);
             
             if (hitBrickIndex != -1) { 
                 int brickOriginalScoreValue = m_level.processBrickHit(hitBrickIndex); 
                 if (brickOriginalScoreValue > 0) { 
                     m_score += brickOriginalScoreValue;
-                    m_bricksHitInCurrentGame++;
-                              
-                    float speedMultiplier = 1.0f;
-                    if (brickOriginalScoreValue == Config::SCORE_ORANGE && !m_firstOrangeBrickHit) {
-                        speedMultiplier *= 1.19f; m_firstOrangeBrickHit = true;
-                    }
-                    if (brickOriginalScoreValue == Config::SCORE_RED && !m_firstRedBrickHit) {
-                        speedMultiplier *= 1.19f; m_firstRedBrickHit = true;
-                    }
-                    if (m_bricksHitInCurrentGame == 4 && !m_speedBoost4thBrickDone) {
-                        speedMultiplier *= 1.19f; m_speedBoost4thBrickDone = true;
-                    }
-                    if (m_bricksHitInCurrentGame == 12 && !m_speedBoost12thBrickDone) {
-                        speedMultiplier *= 1.19f; m_speedBoost12thBrickDone = true;
-                    }
-                    if (speedMultiplier > 1.001f) { 
-                        Vec2 currentVel = m_ball.getVelocity();
-                        m_ball.setVelocity(currentVel.x * speedMultiplier, currentVel.y * speedMultiplier);
-                    }
+                    m_speedBoosts.onBrickHit(m_ball, brickOriginalScoreValue);
+                    EntitySystems::spawnDebris(m_effects, m_level.getBricks()[hitBrickIndex].getRect(),
+                                               Config::getBrickColorByScore(brickOriginalScoreValue), m_effectsRng);
                 }
             }
 
@@ -2039,63 +7519,56 @@ private:
 
     /**
      * @brief Effectue le rendu du jeu principal (mode GAME).
-     * @note Affiche la raquette, la balle, les briques et l'HUD (score, vies, messages).
-     *       Dessine également des bordures si la grille de briques n'occupe pas toute la largeur de la fenetre.
+     * @param snap État publié par la simulation.
+     * @note Affiche la raquette, la balle, les éclats des briques détruites et l'HUD (score, vies, messages).
+     *       Les briques et les bordures sont dessinées par `renderStaticLayer()`.
      */
-    void renderGame() {
-        float gridEndX = m_level.m_gridStartX + m_level.m_gridTotalWidth;
-
-        if (m_level.m_gridStartX > 0.1f) {
-            Utils::drawRect(0.0f, 0.0f, m_level.m_gridStartX, static_cast<float>(m_windowHeight), Config::COLOR_BORDER);
-        }
-        if (gridEndX < m_windowWidth - 0.1f) {
-             float rightBorderWidth = static_cast<float>(m_windowWidth) - gridEndX;
-             Utils::drawRect(gridEndX, 0.0f, rightBorderWidth, static_cast<float>(m_windowHeight), Config::COLOR_BORDER);
-        }
-        
-        // Rendu des éléments du jeu
-        m_paddle.render();
-        m_level.render();
-        m_ball.render();
-
-        float hudScale = 0.6f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
-        float hudYPos = m_windowHeight - 35.0f; 
+    void renderGame(const FrameSnapshot& snap) {
+        PROFILE_ZONE("Game::renderGame");
+        // Rendu des éléments mobiles du jeu (les bordures et les briques sont dans la couche statique)
+        if (m_lateLatch && snap.paddleFollowsCursor) latchPaddle(snap).render(m_renderQueue);
+        else snap.paddle.render(m_renderQueue);
+        snap.ball.render(m_renderQueue);
+        EntitySystems::render(snap.effects, m_renderQueue);
+
+        float hudScale = 0.6f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        float hudYPos = snap.windowHeight - 35.0f; 
         float hudBottomYPos = 35.0f;
         float hudXMargin = 15.0f;
 
-        std::string scoreText = "Score: " + std::to_string(m_score);
+        std::string scoreText = "Score: " + std::to_string(snap.score);
         float scoreTextWidth = m_textRenderer.getTextWidth(scoreText, hudScale);
         float scoreTextCenterX_for_left_align = hudXMargin + scoreTextWidth / 2.0f;
-        m_textRenderer.render(scoreText, scoreTextCenterX_for_left_align, hudYPos, hudScale, Config::COLOR_TEXT_DEFAULT);
+        m_renderQueue.text(scoreText, scoreTextCenterX_for_left_align, hudYPos, hudScale, Config::COLOR_TEXT_DEFAULT);
 
-        std::string livesText = "Lives: " + std::to_string(m_lives);
+        std::string livesText = "Lives: " + std::to_string(snap.lives);
         float livesTextWidth = m_textRenderer.getTextWidth(livesText, hudScale);
         float livesTextCenterX_for_left_align = hudXMargin + livesTextWidth / 2.0f;
-        m_textRenderer.render(livesText, livesTextCenterX_for_left_align, hudBottomYPos, hudScale, Config::COLOR_TEXT_ERROR);
+        m_renderQueue.text(livesText, livesTextCenterX_for_left_align, hudBottomYPos, hudScale, Config::COLOR_TEXT_ERROR);
 
 
-        std::string menuText = "M: Menu";
+        std::string menuText = snap.playtest ? "M: Editor" : "M: Menu";
         float menuTextWidth = m_textRenderer.getTextWidth(menuText, hudScale);
-        float menuTextCenterX_for_right_align = (m_windowWidth - hudXMargin) - menuTextWidth / 2.0f;
-        m_textRenderer.render(menuText, menuTextCenterX_for_right_align, hudYPos, hudScale, Config::COLOR_TEXT_DEFAULT);
+        float menuTextCenterX_for_right_align = (snap.windowWidth - hudXMargin) - menuTextWidth / 2.0f;
+        m_renderQueue.text(menuText, menuTextCenterX_for_right_align, hudYPos, hudScale, Config::COLOR_TEXT_DEFAULT);
 
         // Affichage des messages d'état
-        if (!m_statusMessage.empty()) {
-            if (m_lives <= 0 || m_level.areAllBricksCleared() || !m_ball.isMoving()) {
-                float msgScale = 1.2f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        if (!snap.statusMessage.empty()) {
+            if (snap.lives <= 0 || snap.allBricksCleared || !snap.ball.isMoving()) {
+                float msgScale = 1.2f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
                 int numLines = 1;
-                for(char ch_c : m_statusMessage) if(ch_c == '\n') numLines++;
+                for(char ch_c : snap.statusMessage) if(ch_c == '\n') numLines++;
                 float singleLineHeight = m_textRenderer.getTextHeight(msgScale);
                 float totalMsgBlockHeight = singleLineHeight * numLines;
 
-                float msgCenterX = m_windowWidth / 2.0f;
-                float msgY_baseline_first_line = m_windowHeight * 0.5f + totalMsgBlockHeight / 2.0f - singleLineHeight * 0.5f;
+                float msgCenterX = snap.windowWidth / 2.0f;
+                float msgY_baseline_first_line = snap.windowHeight * 0.5f + totalMsgBlockHeight / 2.0f - singleLineHeight * 0.5f;
 
                 Config::Color msgColor = Config::COLOR_TEXT_DEFAULT;
-                 if (m_statusMessage.find("Win") != std::string::npos) msgColor = Config::COLOR_TEXT_ACCENT;
-                 else if (m_statusMessage.find("Over") != std::string::npos) msgColor = Config::COLOR_TEXT_ERROR;
-                 else if (m_statusMessage.find("Click") != std::string::npos) msgColor = Config::COLOR_TEXT_DEFAULT;
-                m_textRenderer.render(m_statusMessage, msgCenterX, msgY_baseline_first_line, msgScale, msgColor);
+                 if (snap.statusMessage.find("Win") != std::string::npos) msgColor = Config::COLOR_TEXT_ACCENT;
+                 else if (snap.statusMessage.find("Over") != std::string::npos) msgColor = Config::COLOR_TEXT_ERROR;
+                 else if (snap.statusMessage.find("Click") != std::string::npos) msgColor = Config::COLOR_TEXT_DEFAULT;
+                m_renderQueue.text(snap.statusMessage, msgCenterX, msgY_baseline_first_line, msgScale, msgColor);
             }
         }
     }
@@ -2104,37 +7577,42 @@ private:
      * @brief Met à jour la logique de l'éditeur de niveaux.
      * @param dt Delta-temps.
      * @note Gère la sélection/placement/suppression de briques, la sauvegarde du niveau et le retour au menu.
+     * @note La sauvegarde est confiée à `m_levelSaver` : son résultat est affiché par `pollLevelSave` une fois l'écriture terminée.
      */
     void updateEditor(float dt) {
-        m_level.calculateGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+        PROFILE_ZONE("Game::updateEditor");
+        m_level.calculateEditorGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
 
         if (m_inputManager.wasKeyPressed(Config::KEY_MENU_TOGGLE)) {
             m_statusMessage = ""; m_currentState = GameState::MENU; return;
         }
-
-        float buttonPaddingX = 30.0f; float buttonH = m_windowHeight * 0.07f;
-        float buttonY = m_windowHeight * 0.05f; float buttonSpacingX = m_windowWidth * 0.05f;
-        float textScale = 0.7f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
-        const std::string backText = "Back to Menu (M)"; const std::string saveText = "Save Level";
-        float backTextWidth = m_textRenderer.getTextWidth(backText, textScale); float saveTextWidth = m_textRenderer.getTextWidth(saveText, textScale);
-        float backButtonW = backTextWidth + buttonPaddingX; float saveButtonW = saveTextWidth + buttonPaddingX;
-        float totalButtonWidth = backButtonW + saveButtonW + buttonSpacingX;
-        float backButtonX = (m_windowWidth - totalButtonWidth) / 2.0f; float saveButtonX = backButtonX + backButtonW + buttonSpacingX;
-        Rect saveButtonRect = { saveButtonX, buttonY, saveButtonW, buttonH };
-        Rect backButtonRect = { backButtonX, buttonY, backButtonW, buttonH };
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_PLAYTEST) && !m_inputManager.isControlDown()) {
+            startPlaytest(); return;
+        }
+        if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_HEATMAP)) {
+            m_heatmapMode = static_cast<HeatmapMode>((static_cast<int>(m_heatmapMode) + 1) % 3);
+            if (m_heatmapMode != HeatmapMode::OFF && m_level.getCells().size() > Config::HEATMAP_MAX_CELLS) {
+                m_heatmapMode = HeatmapMode::OFF;
+                m_statusMessage = "Heatmap unavailable: grids above " + std::to_string(Config::HEATMAP_MAX_CELLS) + " cells are not simulated";
+            }
+        }
 
         bool statusNeedsUpdate = false;
         bool saveAttemptedThisFrame = false;
         float mx = m_inputManager.getMouseX(); float my = m_inputManager.getMouseY();
+        updateEditorView(mx, my);
 
         if (m_inputManager.wasMouseLeftClicked()) {
-            if (mx >= saveButtonRect.x && mx <= saveButtonRect.x + saveButtonRect.width && my >= saveButtonRect.y && my <= saveButtonRect.y + saveButtonRect.height) {
-                if (m_level.save(Config::LEVEL_FILENAME)) m_statusMessage = "Level saved successfully!";
-                else m_statusMessage = "ERROR: Could not save level!";
+            if (m_uiLayout->button(UiButton::SAVE).contains(mx, my)) {
+                m_levelSaver.request(Config::LEVEL_FILENAME, m_level.getRows(), m_level.getCols(), m_level.getCells());
+                m_statusMessage = "Saving level...";
+                m_packLevel = -1; // Les niveaux de l'archive ne sont pas modifiés : le menu propose désormais le niveau sauvegardé
                 statusNeedsUpdate = true;
                 saveAttemptedThisFrame = true;
-            } else if (mx >= backButtonRect.x && mx <= backButtonRect.x + backButtonRect.width && my >= backButtonRect.y && my <= backButtonRect.y + backButtonRect.height) {
+            } else if (m_uiLayout->button(UiButton::BACK).contains(mx, my)) {
                 m_statusMessage = ""; m_currentState = GameState::MENU; return;
+            } else if (m_uiLayout->button(UiButton::PLAYTEST).contains(mx, my)) {
+                startPlaytest(); return;
             } else {
                 int selectionResult = m_level.handleEditorLeftClickSelection(mx, my);
                 if (selectionResult == 1) {
@@ -2143,17 +7621,41 @@ private:
             }
         }
         else if (m_inputManager.wasMouseRightClicked()) {
-            bool placed = m_level.handleEditorRightClickPlace(m_inputManager.isShiftDown());
-            if (placed) {
+            if (m_level.hasEditorSelection()) {
+                m_level.applyEditorTool(m_editorTool, m_inputManager.isShiftDown() ? Config::SCORE_INDESTRUCTIBLE : m_editorBrush);
                 statusNeedsUpdate = true;
             }
         }
         else if (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_SET_EMPTY)) {
             if (m_level.hasEditorSelection()) {
-                m_level.clearSelectedBrick();
+                m_level.applyEditorTool(m_editorTool, 0);
                 statusNeedsUpdate = true;
             }
         }
+        else if (m_inputManager.isControlDown() && m_inputManager.wasKeyPressed(Config::KEY_EDITOR_COPY)) {
+            size_t copied = m_level.copySelection();
+            m_statusMessage = copied > 0 ? "Copied " + std::to_string(copied) + " cells\nSelect the top-left cell, then Ctrl+V to paste"
+                                         : "Select a cell (or two for a rectangle) to copy";
+        }
+        else if (m_inputManager.isControlDown() && m_inputManager.wasKeyPressed(Config::KEY_EDITOR_PASTE)) {
+            if (!m_level.hasClipboard()) m_statusMessage = "Nothing to paste (Ctrl+C copies the selection)";
+            else if (!m_level.hasEditorSelection()) m_statusMessage = "Select the top-left cell to paste at";
+            else m_statusMessage = "Pasted " + std::to_string(m_level.pasteClipboard()) + " changed cells\n" + editorToolDescription();
+        }
+        else if (selectEditorTool()) {
+            statusNeedsUpdate = true;
+        }
+        else if (m_inputManager.isControlDown() && (m_inputManager.wasKeyPressed(Config::KEY_EDITOR_UNDO) || m_inputManager.wasKeyPressed(Config::KEY_EDITOR_REDO))) {
+            bool redo = m_inputManager.wasKeyPressed(Config::KEY_EDITOR_REDO) || m_inputManager.isShiftDown();
+            size_t changedCount = redo ? m_level.redo() : m_level.undo();
+            if (changedCount > 0) {
+                m_statusMessage = std::string(redo ? "Redone" : "Undone") + " edit (" + std::to_string(changedCount) + " cells)\n" +
+                                  (m_level.canUndo() ? "Ctrl+Z: Undo" : "Nothing left to undo") + " | " +
+                                  (m_level.canRedo() ? "Ctrl+Y: Redo" : "Nothing to redo");
+            } else {
+                m_statusMessage = redo ? "Nothing to redo" : "Nothing to undo";
+            }
+        }
 
         // Met à jour le message d'état si nécessaire
         if (statusNeedsUpdate) {
@@ -2167,115 +7669,162 @@ private:
                    else scoreStr = "Empty";
 
                    m_statusMessage = "Selected [" + std::to_string(r) + "," + std::to_string(c) +
-                                     "] Type: " + scoreStr + "\n R-Click: Place (Shift+R-C: Indestructible) | Del: Clear";
+                                     "] Type: " + scoreStr + " | " + editorToolDescription() +
+                                     "\n R-Click: Apply (Shift+R-C: Indestructible) | Del: Clear | Ctrl+Z/Y: Undo/Redo";
                } else {
-                   m_statusMessage = "L-Click: Select | R-Click: Place (Shift+R-C: Indestructible) \n Del: Clear";
+                   m_statusMessage = "L-Click: Select | R-Click: Apply (Shift+R-C: Indestructible) \n" + editorToolDescription() +
+                                     " | Del: Clear | Ctrl+Z/Y: Undo/Redo";
                }
            }
        }
 }
     /**
      * @brief Effectue le rendu de l'éditeur de niveaux.
-     * @note Affiche la grille d'édition, la surbrillance de la cellule sélectionnée, le titre, les messages et les boutons.
+     * @param snap État publié par la simulation.
+     * @note Affiche la surbrillance de la cellule sélectionnée, le titre, les messages et les boutons.
+     *       La grille d'édition et les bordures sont dessinées par `renderStaticLayer()`.
      */
-    void renderEditor() {
-        // Dessine les bordures latérales si la grille n'occupe pas toute la largeur
-        float gridEndX = m_level.m_gridStartX + m_level.m_gridTotalWidth;
-        if (m_level.m_gridStartX > 0.1f) {
-            Utils::drawRect(0.0f, 0.0f, m_level.m_gridStartX, static_cast<float>(m_windowHeight), Config::COLOR_BORDER);
-        }
-        if (gridEndX < m_windowWidth - 0.1f) {
-             float rightBorderWidth = static_cast<float>(m_windowWidth) - gridEndX;
-             Utils::drawRect(gridEndX, 0.0f, rightBorderWidth, static_cast<float>(m_windowHeight), Config::COLOR_BORDER);
-        }
-
+    void renderEditor(const FrameSnapshot& snap) {
+        PROFILE_ZONE("Game::renderEditor");
         const std::string title = "Level Editor"; 
-        float titleScale = 1.1f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
-        float titleCenterX = m_windowWidth / 2.0f; 
-        float titleY = m_windowHeight * 0.95f - 0.35f * m_textRenderer.getTextHeight(titleScale);
-        m_textRenderer.render(title, titleCenterX, titleY, titleScale, Config::COLOR_TEXT_DEFAULT);
-
-        // Rendu de la grille et de la surbrillance
-        m_level.renderEditorGrid(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
-        m_level.highlightEditorCell(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+        float titleScale = 1.1f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        float titleCenterX = snap.windowWidth / 2.0f; 
+        float titleY = snap.windowHeight * 0.95f - 0.35f * m_textRenderer.getTextHeight(titleScale);
+        m_renderQueue.text(title, titleCenterX, titleY, titleScale, Config::COLOR_TEXT_DEFAULT);
+
+        // Rendu de la surbrillance (la grille est dans la couche statique)
+        if (snap.bricks) {
+            Level::highlightEditorRegion(m_renderQueue, snap.grid, snap.bricks->rows, snap.editorAnchorRow, snap.editorAnchorCol,
+                                         snap.editorSelectedRow, snap.editorSelectedCol);
+            Level::highlightEditorCell(m_renderQueue, snap.grid, snap.bricks->rows, snap.editorSelectedRow, snap.editorSelectedCol);
+        }
+        if (snap.heatmap && snap.bricks) renderHeatmapOverlay(snap, titleY - 1.3f * m_textRenderer.getTextHeight(titleScale));
 
-        if (!m_statusMessage.empty()) {
-            float msgScale = 0.6f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        if (!snap.statusMessage.empty()) {
+            float msgScale = 0.6f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
             
             int numLines = 1;
-            for(char ch_c : m_statusMessage) if(ch_c == '\n') numLines++;
+            for(char ch_c : snap.statusMessage) if(ch_c == '\n') numLines++;
             float singleLineHeight = m_textRenderer.getTextHeight(msgScale);
             float totalMsgBlockHeightEst = singleLineHeight * numLines;
 
-            float msgCenterX = m_windowWidth / 2.0f;
+            float msgCenterX = snap.windowWidth / 2.0f;
             // Positionne le message au-dessus des boutons (environ 18% de la hauteur de l'écran)
-            float desiredBlockCenterY = m_windowHeight * 0.18f;
+            float desiredBlockCenterY = snap.windowHeight * 0.18f;
             float msgY_baseline_first_line = desiredBlockCenterY + totalMsgBlockHeightEst / 2.0f - singleLineHeight * 0.5f;
 
 
             Config::Color msgColor = Config::COLOR_TEXT_DEFAULT;
-            if (m_statusMessage.find("ERROR") != std::string::npos) msgColor = Config::COLOR_TEXT_ERROR;
-            else if (m_statusMessage.find("saved") != std::string::npos) msgColor = Config::COLOR_TEXT_ACCENT;
-            m_textRenderer.render(m_statusMessage, msgCenterX, msgY_baseline_first_line, msgScale, msgColor);
+            if (snap.statusMessage.find("ERROR") != std::string::npos) msgColor = Config::COLOR_TEXT_ERROR;
+            else if (snap.statusMessage.find("saved") != std::string::npos) msgColor = Config::COLOR_TEXT_ACCENT;
+            m_renderQueue.text(snap.statusMessage, msgCenterX, msgY_baseline_first_line, msgScale, msgColor);
         }
 
         // Rendu des boutons de sauvegarde et de retour
-        float buttonPaddingX = 30.0f; float buttonH = m_windowHeight * 0.07f;
-        float buttonY = m_windowHeight * 0.05f; float buttonSpacingX = m_windowWidth * 0.05f;
-        float textScale = 0.7f * (static_cast<float>(m_windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
-        float textHeight = m_textRenderer.getTextHeight(textScale);
-        float textYOffset = (buttonH - textHeight) / 2.0f;
-
-        const std::string backText = "Back to Menu (M)"; const std::string saveText = "Save Level";
-        float backTextWidth = m_textRenderer.getTextWidth(backText, textScale); float saveTextWidth = m_textRenderer.getTextWidth(saveText, textScale);
-        float backButtonW = backTextWidth + buttonPaddingX; float saveButtonW = saveTextWidth + buttonPaddingX;
-        float totalButtonWidth = backButtonW + saveButtonW + buttonSpacingX;
-        float backButtonX_start = (m_windowWidth - totalButtonWidth) / 2.0f; 
-        float saveButtonX_start = backButtonX_start + backButtonW + buttonSpacingX;
-
-        // Bouton Sauvegarder
-        Rect saveButtonRect = { saveButtonX_start, buttonY, saveButtonW, buttonH };
-        Utils::drawRect(saveButtonRect, Config::COLOR_BUTTON_SAVE);
-        float saveTextCenterX = saveButtonRect.x + saveButtonRect.width / 2.0f;
-        m_textRenderer.render(saveText, saveTextCenterX, saveButtonRect.y - textYOffset, textScale, Config::COLOR_TEXT_DEFAULT);
-
-        // Bouton Retour
-        Rect backButtonRect = { backButtonX_start, buttonY, backButtonW, buttonH };
-        Utils::drawRect(backButtonRect, Config::COLOR_BUTTON_BACK);
-        float backTextCenterX = backButtonRect.x + backButtonRect.width / 2.0f;
-        m_textRenderer.render(backText, backTextCenterX, backButtonRect.y - textYOffset, textScale, Config::COLOR_TEXT_DEFAULT);
+        if (snap.ui) snap.ui->renderButtons(m_renderQueue, UiLayout::EDITOR_BUTTONS);
+    }
+
+    /**
+     * @brief Enregistre la carte de chaleur de l'éditeur et sa légende : progression des parties simulées, briques jamais
+     *        touchées et statistiques de la cellule sélectionnée.
+     * @param snap État publié par la simulation (`snap.heatmap` non nul).
+     * @param legendY Ligne de base de la légende.
+     */
+    void renderHeatmapOverlay(const FrameSnapshot& snap, float legendY) {
+        const HitHeatmap& heatmap = *snap.heatmap;
+        Level::renderHeatmap(m_renderQueue, heatmap, *snap.bricks, snap.grid, snap.heatmapMode,
+                             m_textRenderer.getAtlasTexture(), m_textRenderer.getAtlasSolidUV());
+
+        // Deux lignes sur un fond opaque : la légende peut recouvrir le haut de la grille
+        char lines[2][160];
+        std::snprintf(lines[0], sizeof(lines[0]), "Heatmap (H): %s | %d/%d games | %d bricks never hit",
+                      snap.heatmapMode == HeatmapMode::FIRST_HIT ? "time to first hit" : "hits", heatmap.games,
+                      Config::HEATMAP_GAMES, heatmap.neverHit);
+        lines[1][0] = '\0';
+        int row = snap.editorSelectedRow, col = snap.editorSelectedCol;
+        if (heatmap.games > 0 && row >= 0 && col >= 0 && row < heatmap.rows && col < heatmap.cols && snap.bricks->at(row, col) != 0) {
+            size_t i = static_cast<size_t>(row) * heatmap.cols + col;
+            if (heatmap.hitGames[i] == 0) {
+                std::snprintf(lines[1], sizeof(lines[1]), "[%d,%d] never hit", row, col);
+            } else {
+                std::snprintf(lines[1], sizeof(lines[1]), "[%d,%d] hit in %u/%d games, %.1f hits/game, first hit after %.1f s",
+                              row, col, heatmap.hitGames[i], heatmap.games, static_cast<float>(heatmap.hits[i]) / heatmap.games,
+                              heatmap.averageFirstHit(i));
+            }
+        }
+        int lineCount = lines[1][0] ? 2 : 1;
+        float scale = 0.5f * (static_cast<float>(snap.windowWidth) / Config::DEFAULT_WINDOW_WIDTH);
+        float lineHeight = m_textRenderer.getTextHeight(scale);
+        float width = 0.0f;
+        for (int i = 0; i < lineCount; ++i) width = std::max(width, m_textRenderer.getTextWidth(lines[i], scale));
+        float padding = 6.0f, centerX = snap.windowWidth / 2.0f;
+        m_renderQueue.rect({ centerX - width / 2.0f - padding, legendY - (lineCount - 0.7f) * lineHeight - padding,
+                             width + 2.0f * padding, lineCount * lineHeight + padding }, Config::COLOR_BG, RenderLayer::UI);
+        for (int i = 0; i < lineCount; ++i) m_renderQueue.text(lines[i], centerX, legendY - i * lineHeight, scale, Config::COLOR_TEXT_ACCENT);
     }
 
     /** @brief Callback d'erreur GLFW (statique). */
     static void errorCallback_GLFW(int error, const char* description) { std::cerr << "GLFW Error [" << error << "]: " << description << std::endl; }
     
-    /** @brief Callback des touches clavier GLFW (statique). Transmet à l'InputManager de l'instance Game. */
-    static void keyCallback_GLFW(GLFWwindow* window, int key, int scancode, int action, int mods) { if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window))) game->m_inputManager.keyCallback(key, action); }
+    /** @brief Callback des touches clavier GLFW (statique). Transmet l'événement au thread de simulation. */
+    static void keyCallback_GLFW(GLFWwindow* window, int key, int scancode, int action, int mods) {
+        auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window));
+        if (!game) return;
+        if (key == Config::KEY_PROFILER_EXPORT && action == GLFW_PRESS) game->m_traceExportRequested = true;
+        if (key == Config::KEY_PERF_OVERLAY && action == GLFW_PRESS) { game->m_showPerfOverlay = !game->m_showPerfOverlay; game->m_redrawRequested = true; }
+        game->m_inputManager.keyCallback(key, action);
+    }
     
-    /** @brief Callback des boutons de la souris GLFW (statique). Transmet à l'InputManager. */
+    /** @brief Callback des boutons de la souris GLFW (statique). Transmet l'événement au thread de simulation. */
     static void mouseButtonCallback_GLFW(GLFWwindow* window, int button, int action, int mods) { if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window))) game->m_inputManager.mouseButtonCallback(button, action); }
     
-    /** @brief Callback de la position du curseur GLFW (statique). Transmet à l'InputManager. */
-    static void cursorPosCallback_GLFW(GLFWwindow* window, double xpos, double ypos) { if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window))) game->m_inputManager.cursorPosCallback(xpos, ypos); }
+    /** @brief Callback de la position du curseur GLFW (statique). Transmet l'événement au thread de simulation. */
+    static void cursorPosCallback_GLFW(GLFWwindow* window, double xpos, double ypos) {
+        auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window));
+        if (!game) return;
+        game->m_inputManager.cursorPosCallback(xpos, ypos);
+        if (game->m_oldestUndisplayedCursorTime == 0.0) game->m_oldestUndisplayedCursorTime = glfwGetTime();
+    }
+
+    /** @brief Callback de la molette GLFW (statique). Transmet l'événement au thread de simulation. */
+    static void scrollCallback_GLFW(GLFWwindow* window, double xoffset, double yoffset) { if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window))) game->m_inputManager.scrollCallback(xoffset, yoffset); }
 
     /** @brief Callback de redimensionnement du framebuffer GLFW (statique). Appelle la méthode membre correspondante. */
     static void framebufferSizeCallback_GLFW(GLFWwindow* window, int width, int height) { if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window))) game->framebufferSizeCallback(width, height); }
 
+    /** @brief Callback de rafraîchissement de la fenêtre GLFW (statique). Demande un redessin, même en mode inactif. */
+    static void windowRefreshCallback_GLFW(GLFWwindow* window) { if(auto* game = static_cast<Game*>(glfwGetWindowUserPointer(window))) game->m_redrawRequested = true; }
+
     /**
-     * @brief Méthode membre appelée lors du redimensionnement du framebuffer.
+     * @brief Méthode membre appelée lors du redimensionnement du framebuffer (thread principal).
      * @param width Nouvelle largeur du framebuffer.
      * @param height Nouvelle hauteur du framebuffer.
-     * @note Met à jour les dimensions de la fenêtre, le viewport OpenGL, et recalcule les positions des éléments si nécessaire.
+     * @note Met à jour le viewport OpenGL. Si la simulation tourne, le changement de taille lui est transmis
+     *       par la file d'événements, sinon il est appliqué immédiatement.
      */
     void framebufferSizeCallback(int width, int height) {
+         if (width <= 0 || height <= 0) return;
+         glViewport(0, 0, width, height);
+         m_redrawRequested = true;
+         if (m_simRunning.load(std::memory_order_acquire)) m_inputManager.resizeCallback(width, height);
+         else applyResize(width, height);
+    }
+
+    /**
+     * @brief Applique un changement de taille du framebuffer à l'état du jeu (thread de simulation).
+     * @param width Nouvelle largeur du framebuffer.
+     * @param height Nouvelle hauteur du framebuffer.
+     * @note Met à jour les dimensions de la fenêtre et recalcule les positions des éléments si nécessaire.
+     */
+    void applyResize(int width, int height) {
          if (width <= 0 || height <= 0) return;
          m_windowWidth = width; m_windowHeight = height;
          Config::WINDOW_WIDTH = width;
          Config::WINDOW_HEIGHT = height;
          m_inputManager.setWindowHeight(height);
-         glViewport(0, 0, width, height);
          std::cout << "Framebuffer resized to " << width << " x " << height << std::endl;
-         m_level.calculateGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+         if (m_currentState == GameState::EDITOR) m_level.calculateEditorGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
+         else m_level.calculateGridDimensions(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
          if (m_currentState == GameState::GAME) {
              m_paddle.init(static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight));
              if (!m_ball.isMoving()) {
@@ -2285,14 +7834,326 @@ private:
     }
 };
 
+/**
+ * @brief Convertit un fichier de niveau entre les formats texte et binaire (format choisi selon l'extension `.txt`).
+ * @param input Fichier source.
+ * @param output Fichier de destination.
+ * @return `true` si la lecture et l'écriture ont réussi.
+ * @note Affiche la durée du chargement, pour mesurer le coût d'ouverture des grandes grilles.
+ */
+static bool convertLevelFile(const std::string& input, const std::string& output) {
+    std::ifstream probe(input);
+    if (!probe.is_open()) {
+        std::cerr << "Error: Level file " << input << " does not exist." << std::endl;
+        return false;
+    }
+    probe.close();
+    Level level;
+    auto loadStart = std::chrono::steady_clock::now();
+    bool loaded = level.load(input);
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    std::cout << "Loaded " << level.getRows() << "x" << level.getCols() << " level in " << loadMs << " ms" << std::endl;
+    if (!loaded) {
+        std::cerr << "Error: Could not convert " << input << "." << std::endl;
+        return false;
+    }
+    return level.save(output);
+}
+
+/**
+ * @brief Analyse des niveaux au format texte et affiche leurs anomalies (`fichier:ligne:colonne: message`) et le débit de l'analyse.
+ * @param files Fichiers à analyser.
+ * @return `true` si tous les fichiers ont été lus sans anomalie.
+ */
+static bool parseLevelFiles(const std::vector<std::string>& files) {
+    bool success = true;
+    for (const std::string& path : files) {
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << path << ": cannot open file" << std::endl;
+            success = false;
+            continue;
+        }
+        auto parseStart = std::chrono::steady_clock::now();
+        LevelTextParser::Result parsed = LevelTextParser::parse(reinterpret_cast<const char*>(file.data()), file.size());
+        double parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - parseStart).count();
+        for (const LevelTextParser::Diagnostic& diagnostic : parsed.diagnostics) {
+            std::cout << path << ":" << diagnostic.line << ":" << diagnostic.column << ": " << diagnostic.message << std::endl;
+        }
+        double megabytes = file.size() / (1024.0 * 1024.0);
+        std::cout << path << ": " << parsed.rows << "x" << parsed.cols << ", " << parsed.errorCount << " problems, "
+                  << megabytes << " MB in " << parseSeconds * 1000.0 << " ms ("
+                  << (parseSeconds > 0.0 ? megabytes / parseSeconds : 0.0) << " MB/s)" << std::endl;
+        success = success && parsed.errorCount == 0 && parsed.rows > 0;
+    }
+    return success;
+}
+
+/**
+ * @brief Ajoute des fichiers de niveau (texte ou binaires) à une archive, nommés d'après leur nom de fichier sans extension.
+ * @param pack Chemin de l'archive (créée si elle n'existe pas).
+ * @param files Fichiers à ajouter.
+ * @return `true` si tous les fichiers ont été ajoutés.
+ */
+static bool addLevelsToPack(const std::string& pack, const std::vector<std::string>& files) {
+    bool success = true;
+    for (const std::string& path : files) {
+        std::ifstream probe(path);
+        Level level;
+        if (!probe.is_open() || !level.load(path)) {
+            std::cerr << "Error: Could not read level " << path << ", skipped." << std::endl;
+            success = false;
+            continue;
+        }
+        size_t nameStart = path.find_last_of('/');
+        nameStart = (nameStart == std::string::npos) ? 0 : nameStart + 1;
+        std::string name = path.substr(nameStart, path.find_last_of('.') > nameStart ? path.find_last_of('.') - nameStart : std::string::npos);
+        if (!LevelPack::append(pack, name, level)) return false;
+        std::cout << "Added " << name << " (" << level.getRows() << "x" << level.getCols() << ") to " << pack << std::endl;
+    }
+    return success;
+}
+
+/**
+ * @brief Affiche l'index d'une archive (nom, dimensions, briques destructibles), sans lire les grilles.
+ * @param pack Chemin de l'archive.
+ * @return `true` si l'archive a pu être ouverte.
+ */
+static bool listLevelPack(const std::string& pack) {
+    auto openStart = std::chrono::steady_clock::now();
+    LevelPack levelPack;
+    if (!levelPack.open(pack)) return false;
+    double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - openStart).count();
+    for (int i = 0; i < levelPack.size(); ++i) {
+        const LevelPack::Entry& entry = levelPack.entry(i);
+        std::cout << i << "\t" << entry.getName() << "\t" << entry.rows << "x" << entry.cols << "\t" << entry.destructibleCount << " bricks" << std::endl;
+    }
+    std::cout << levelPack.size() << " levels indexed in " << openMs << " ms" << std::endl;
+    return true;
+}
+
+/**
+ * @brief Vérifie en parallèle des niveaux (`LevelLinter`) et écrit un objet JSON par niveau sur la sortie standard.
+ * @param args Fichiers de niveau, archives ou répertoires (parcourus récursivement : `.txt`, `.bkl` et `.bkp`),
+ *        et éventuellement `--jobs=N` pour fixer le nombre de threads (par défaut, un par cœur).
+ * @return `true` si aucun niveau ne contient d'erreur (les avertissements ne font pas échouer la vérification).
+ * @note Les niveaux sont distribués un par un aux threads par un compteur atomique : un gros niveau n'immobilise
+ *       qu'un thread pendant que les autres continuent. Les résultats sont écrits dans l'ordre des entrées.
+ * @note Le bilan (nombre de niveaux, erreurs, débit) est écrit sur la sortie d'erreur.
+ */
+static bool lintLevels(const std::vector<std::string>& args) {
+    struct Job { std::string path; const LevelPack* pack = nullptr; int index = 0; };
+    std::vector<Job> jobs;
+    std::vector<std::unique_ptr<LevelPack>> packs;
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    bool success = true;
+
+    auto addFile = [&](const std::string& path) {
+        MappedFile probe;
+        if (probe.open(path) && probe.size() >= sizeof(LevelPack::MAGIC) && std::memcmp(probe.data(), LevelPack::MAGIC, sizeof(LevelPack::MAGIC)) == 0) {
+            auto pack = std::make_unique<LevelPack>();
+            if (!pack->open(path)) { success = false; return; }
+            for (int i = 0; i < pack->size(); ++i) jobs.push_back({ path, pack.get(), i });
+            packs.push_back(std::move(pack));
+            return;
+        }
+        jobs.push_back({ path, nullptr, 0 });
+    };
+    for (const std::string& arg : args) {
+        if (arg.rfind("--jobs=", 0) == 0) {
+            int requested = std::atoi(arg.c_str() + 7);
+            if (requested > 0) threadCount = static_cast<unsigned int>(requested);
+            else std::cerr << "Warning: Invalid thread count '" << arg.substr(7) << "' ignored." << std::endl;
+            continue;
+        }
+        std::error_code error;
+        if (!std::filesystem::is_directory(arg, error)) { addFile(arg); continue; }
+        std::vector<std::string> files;
+        for (std::filesystem::recursive_directory_iterator it(arg, error), end; !error && it != end; it.increment(error)) {
+            std::string extension = it->path().extension().string();
+            if (it->is_regular_file(error) && (extension == ".txt" || extension == ".bkl" || extension == ".bkp")) files.push_back(it->path().string());
+        }
+        if (error) { std::cerr << "Error: Could not scan directory " << arg << ": " << error.message() << std::endl; success = false; }
+        std::sort(files.begin(), files.end());
+        for (const std::string& file : files) addFile(file);
+    }
+
+    std::vector<std::string> outputs(jobs.size());
+    std::atomic<size_t> nextJob{0};
+    std::atomic<size_t> errorCount{0}, warningCount{0};
+    auto worker = [&] {
+        PROFILE_THREAD("Linter");
+        LevelLinter::Report report;
+        for (size_t i = nextJob.fetch_add(1, std::memory_order_relaxed); i < jobs.size(); i = nextJob.fetch_add(1, std::memory_order_relaxed)) {
+            report = LevelLinter::Report();
+            if (jobs[i].pack) LevelLinter::lintPackEntry(*jobs[i].pack, jobs[i].index, report);
+            else LevelLinter::lintFile(jobs[i].path, report);
+            LevelLinter::appendJson(outputs[i], report);
+            errorCount.fetch_add(report.errorCount, std::memory_order_relaxed);
+            warningCount.fetch_add(report.warningCount, std::memory_order_relaxed);
+        }
+    };
+
+    threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, std::max<size_t>(1, jobs.size())));
+    auto lintStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+    double lintSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - lintStart).count();
+
+    for (const std::string& output : outputs) std::cout << output;
+    std::cout.flush();
+    std::cerr << "Linted " << jobs.size() << " levels on " << threadCount << " threads in " << lintSeconds * 1000.0 << " ms ("
+              << (lintSeconds > 0.0 ? jobs.size() / lintSeconds : 0.0) << " levels/s): " << errorCount.load() << " errors, "
+              << warningCount.load() << " warnings." << std::endl;
+    return success && errorCount.load() == 0;
+}
+
+/**
+ * @brief Génère des niveaux (`LevelGenerator`) en explorant des candidats sur plusieurs threads, puis les écrit.
+ * @param count Nombre de niveaux à produire.
+ * @param output Répertoire (créé si besoin, un fichier `gen-GRAINE.bkl` par niveau) ou archive `.bkp` (niveaux ajoutés à la fin).
+ * @param args Options : `--rows=N`, `--cols=N`, `--symmetry=none|mirror|quad`, `--bricks=N`, `--indestructible=RATIO`,
+ *        `--difficulty=MIN:MAX`, `--playthroughs=N`, `--seed=N`, `--jobs=N`.
+ * @return `true` si tous les niveaux demandés ont été produits et écrits.
+ * @note Les graines sont distribuées aux threads par un compteur atomique. Les niveaux produits sont les `count` candidats
+ *       acceptés de plus petites graines, quel que soit le nombre de threads : dès que `count` candidats sont acceptés, les
+ *       graines au-delà de la plus grande d'entre eux ne sont plus distribuées, et celles en deçà sont toutes évaluées.
+ *       La recherche s'arrête aussi après `count * 1000` candidats si les contraintes sont trop strictes.
+ * @note Affiche le débit en niveaux par seconde, au total et par cœur, et le nombre de candidats rejetés par contrainte.
+ */
+static bool generateLevels(int count, const std::string& output, const std::vector<std::string>& args) {
+    LevelGenerator::Constraints constraints;
+    uint64_t baseSeed = static_cast<uint64_t>(time(nullptr));
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (const std::string& arg : args) {
+        auto value = [&](const char* prefix) { return arg.rfind(prefix, 0) == 0 ? arg.c_str() + std::strlen(prefix) : nullptr; };
+        if (const char* v = value("--rows=")) constraints.rows = std::clamp(std::atoi(v), 1, Config::LEVEL_MAX_DIMENSION);
+        else if (const char* v = value("--cols=")) constraints.cols = std::clamp(std::atoi(v), 1, Config::LEVEL_MAX_DIMENSION);
+        else if (const char* v = value("--bricks=")) constraints.targetBricks = std::max(0, std::atoi(v));
+        else if (const char* v = value("--indestructible=")) constraints.indestructibleRatio = std::clamp(static_cast<float>(std::atof(v)), 0.0f, 1.0f);
+        else if (const char* v = value("--playthroughs=")) constraints.playthroughs = std::max(0, std::atoi(v));
+        else if (const char* v = value("--seed=")) baseSeed = std::strtoull(v, nullptr, 10);
+        else if (const char* v = value("--jobs=")) threadCount = static_cast<unsigned int>(std::max(1, std::atoi(v)));
+        else if (const char* v = value("--symmetry=")) {
+            if (!LevelGenerator::parseSymmetry(v, constraints.symmetry)) std::cerr << "Warning: Unknown symmetry '" << v << "', expected none, mirror or quad." << std::endl;
+        }
+        else if (const char* v = value("--difficulty=")) {
+            const char* colon = std::strchr(v, ':');
+            if (!colon) { std::cerr << "Warning: Invalid difficulty band '" << v << "', expected MIN:MAX." << std::endl; continue; }
+            constraints.minDifficulty = static_cast<float>(std::atof(v));
+            constraints.maxDifficulty = static_cast<float>(std::atof(colon + 1));
+        }
+        else std::cerr << "Warning: Unknown option '" << arg << "' ignored." << std::endl;
+    }
+    if (count <= 0) { std::cerr << "Error: Invalid level count." << std::endl; return false; }
+    bool toPack = output.size() >= 4 && output.compare(output.size() - 4, 4, ".bkp") == 0;
+    if (!toPack) {
+        std::error_code error;
+        std::filesystem::create_directories(output, error);
+        if (error) { std::cerr << "Error: Could not create directory " << output << ": " << error.message() << std::endl; return false; }
+    }
+
+    const uint64_t maxCandidates = static_cast<uint64_t>(count) * 1000;
+    std::atomic<uint64_t> nextCandidate{0};
+    // Index au-delà duquel aucune graine n'est distribuée : celui de la `count`-ième graine acceptée (décroît seulement)
+    std::atomic<uint64_t> candidateLimit{maxCandidates};
+    std::array<std::atomic<uint64_t>, 4> rejections{};
+    std::mutex acceptedMutex;
+    std::vector<LevelGenerator::Candidate> accepted; // Triés par graine, au plus `count`
+    auto worker = [&] {
+        PROFILE_THREAD("Generator");
+        LevelGenerator::Candidate candidate;
+        for (;;) {
+            uint64_t index = nextCandidate.fetch_add(1, std::memory_order_relaxed);
+            if (index >= candidateLimit.load(std::memory_order_relaxed)) break;
+            LevelGenerator::Rejection rejection = LevelGenerator::generate(constraints, baseSeed + index, candidate);
+            rejections[static_cast<size_t>(rejection)].fetch_add(1, std::memory_order_relaxed);
+            if (rejection != LevelGenerator::Rejection::NONE) continue;
+            std::lock_guard<std::mutex> lock(acceptedMutex);
+            auto position = std::upper_bound(accepted.begin(), accepted.end(), candidate.seed,
+                                             [](uint64_t seed, const LevelGenerator::Candidate& other) { return seed < other.seed; });
+            if (position == accepted.end() && static_cast<int>(accepted.size()) >= count) continue;
+            accepted.insert(position, candidate);
+            if (static_cast<int>(accepted.size()) > count) accepted.pop_back();
+            if (static_cast<int>(accepted.size()) == count) candidateLimit.store(accepted.back().seed - baseSeed, std::memory_order_relaxed);
+        }
+    };
+
+    auto searchStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+    double searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - searchStart).count();
+
+    bool success = static_cast<int>(accepted.size()) == count;
+    Level level;
+    for (LevelGenerator::Candidate& candidate : accepted) {
+        std::string name = "gen-" + std::to_string(candidate.seed);
+        bool written;
+        if (toPack) {
+            level.replaceCells(constraints.rows, constraints.cols, std::move(candidate.cells));
+            written = LevelPack::append(output, name, level);
+        } else {
+            written = LevelFile::write(output + "/" + name + ".bkl", constraints.rows, constraints.cols, candidate.cells.data());
+        }
+        if (!written) { std::cerr << "Error: Could not write level " << name << " to " << output << "." << std::endl; success = false; break; }
+        std::cout << name << "\t" << constraints.rows << "x" << constraints.cols << "\t" << candidate.bricks << " bricks\tdifficulty "
+                  << candidate.difficulty << std::endl;
+    }
+
+    uint64_t candidates = 0; // Candidats évalués (les graines distribuées au-delà de la limite ne le sont pas)
+    for (const std::atomic<uint64_t>& rejected : rejections) candidates += rejected.load();
+    double levelsPerSecond = searchSeconds > 0.0 ? accepted.size() / searchSeconds : 0.0;
+    std::cout << "Generated " << accepted.size() << "/" << count << " levels from " << candidates << " candidates in "
+              << searchSeconds * 1000.0 << " ms on " << threadCount << " threads: " << levelsPerSecond << " levels/s, "
+              << levelsPerSecond / threadCount << " levels/s per core (" << (searchSeconds > 0.0 ? candidates / searchSeconds / threadCount : 0.0)
+              << " candidates/s per core)." << std::endl;
+    std::cout << "Rejected: " << rejections[static_cast<size_t>(LevelGenerator::Rejection::BRICK_COUNT)].load() << " brick count, "
+              << rejections[static_cast<size_t>(LevelGenerator::Rejection::UNSOLVABLE)].load() << " unsolvable or trapping, "
+              << rejections[static_cast<size_t>(LevelGenerator::Rejection::DIFFICULTY)].load() << " outside the difficulty band." << std::endl;
+    if (!success && static_cast<int>(accepted.size()) < count) std::cerr << "Error: Constraints too strict, stopped after " << candidates << " candidates." << std::endl;
+    return success;
+}
+
 /**
 * @brief Fonction principale du programme.
+* @param argc Nombre d'arguments de la ligne de commande.
+* @param argv Arguments de la ligne de commande (voir la section Exécution).
 * @return 0 si succès, -1 en cas d'échec d'initialisation.
 * @note Initialise le générateur de nombres aléatoires, crée et lance le jeu.
 */
-int main() {
+int main(int argc, char** argv) {
     srand(static_cast<unsigned int>(time(nullptr)));
     Game breakoutGame;
+    PacingMode pacingMode = PacingMode::SLEEP_SPIN;
+    double targetHz = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--null-render") breakoutGame.useNullRenderBackend();
+        else if (arg == "--trace") breakoutGame.enableTraceAtExit();
+        else if (arg == "--late-latch") breakoutGame.enableLateLatch();
+        else if (arg == "--convert-level" && i + 2 < argc) return convertLevelFile(argv[i + 1], argv[i + 2]) ? 0 : 1;
+        else if (arg == "--pack-add" && i + 2 < argc) return addLevelsToPack(argv[i + 1], std::vector<std::string>(argv + i + 2, argv + argc)) ? 0 : 1;
+        else if (arg == "--parse-level" && i + 1 < argc) return parseLevelFiles(std::vector<std::string>(argv + i + 1, argv + argc)) ? 0 : 1;
+        else if (arg == "--pack-list" && i + 1 < argc) return listLevelPack(argv[i + 1]) ? 0 : 1;
+        else if (arg == "--generate" && i + 2 < argc) return generateLevels(std::atoi(argv[i + 1]), argv[i + 2], std::vector<std::string>(argv + i + 3, argv + argc)) ? 0 : 1;
+        else if (arg == "--lint" && i + 1 < argc) return lintLevels(std::vector<std::string>(argv + i + 1, argv + argc)) ? 0 : 1;
+        else if (arg.rfind("--pack=", 0) == 0) {
+            if (!breakoutGame.openLevelPack(arg.substr(7))) std::cerr << "Warning: Level pack '" << arg.substr(7) << "' not loaded." << std::endl;
+        }
+        else if (arg.rfind("--pacing=", 0) == 0) {
+            if (!FramePacer::parseMode(std::string_view(arg).substr(9), pacingMode)) std::cerr << "Warning: Unknown pacing mode '" << arg.substr(9) << "', expected vsync, sleep-spin or uncapped." << std::endl;
+        }
+        else if (arg.rfind("--target-hz=", 0) == 0) {
+            targetHz = std::atof(arg.c_str() + 12);
+            if (targetHz <= 0.0) std::cerr << "Warning: Invalid target rate '" << arg.substr(12) << "', using the monitor refresh rate." << std::endl;
+        }
+        else std::cerr << "Warning: Unknown option '" << arg << "' ignored." << std::endl;
+    }
+    breakoutGame.setFramePacing(pacingMode, targetHz);
     if (!breakoutGame.init()) {
         std::cerr << "FATAL: Game initialization failed. Exiting." << std::endl;
         return -1;